@@ -0,0 +1,1016 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "hash_table.h"
+#include "hash_table_builder.h"
+#include "hash_map_flat.h"
+#include "hash_map_ordered.h"
+#include "hash_map_robin.h"
+#include "hash_map_cuckoo.h"
+#include "hash_set.h"
+#include "hash_map_gen.h"
+
+/*
+ * 基准测试
+ *
+ * 默认运行基准测试套件，输出各操作的吞吐量和延迟分位数（CSV 或 JSON），用于跟踪版本间的性能回归；
+ * --engines 在不同负载因子下比较链式哈希表、开放寻址哈希表（Swiss table、Robin Hood 与布谷鸟）、只存放键的集合和生成器特化的哈希表，
+ * 所有行使用同一个表头 section,engine,load,op,ops,ns_per_op；
+ * --hash-dist 输出各哈希策略的链长分布，列不同，单独一个表。
+ */
+
+static int benchValue = 1;  // 所有键共用的非NULL值
+static const char *reportSection = "";  // 引擎对比中当前小节的名称，写入 section 列
+
+/* 生成器展开的 int -> int 哈希表，哈希和比较都内联到探测循环中 */
+HASHMAP_DECLARE(BenchIntMap, int, int, hashMurmur, HASHMAP_GEN_EQ)
+
+// 获取单调时间（纳秒）
+static uint64_t nowNs(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// 将序号映射为互不相同的伪随机键（32位乘法是双射）
+static int keyAt(size_t i) {
+    return (int)(uint32_t)((uint32_t)i * 2654435761u + 0x9E3779B9u);
+}
+
+// 以与插入不同的顺序访问第 i 个已插入的键，避免顺序访问掩盖缓存未命中
+static int shuffledKeyAt(size_t i, size_t n) {
+    return keyAt((size_t)(((uint64_t)i * 2654435761ULL) % n));
+}
+
+static void report(const char *engine, double load, const char *op, size_t ops, uint64_t ns) {
+    printf("%s,%s,%.3f,%s,%zu,%.2f\n", reportSection, engine, load, op, ops, (double)ns / (double)ops);
+}
+
+static void benchChaining(const char *engine, size_t slots, double load, bool pow2Capacity) {
+    size_t n = (size_t)((double)slots * load);
+    HashMapChainingConfig config = defaultHashMapConfig(slots, NULL);
+    config.pow2Capacity = pow2Capacity;
+    HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+    if (hashMap == NULL) {
+        return;
+    }
+
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        put(hashMap, keyAt(i), &benchValue);
+    }
+    report(engine, load, "put", n, nowNs() - start);
+
+    size_t found = 0;
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        found += get(hashMap, shuffledKeyAt(i, n)) != NULL;
+    }
+    report(engine, load, "get_hit", n, nowNs() - start);
+
+    start = nowNs();
+    for (size_t i = n; i < 2 * n; i++) {
+        found += get(hashMap, keyAt(i)) != NULL;
+    }
+    report(engine, load, "get_miss", n, nowNs() - start);
+
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        removeItem(hashMap, shuffledKeyAt(i, n));
+    }
+    report(engine, load, "remove", n, nowNs() - start);
+
+    if (found != n) {
+        fprintf(stderr, "%s: 查找结果错误 %zu/%zu\n", engine, found, n);
+    }
+    delHashMapChaining(hashMap);
+}
+
+static void benchFlat(size_t slots, double load) {
+    size_t n = (size_t)((double)slots * load);
+    HashMapFlat *hashMap = newHashMapFlat(slots, NULL);
+    if (hashMap == NULL) {
+        return;
+    }
+
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        flatPut(hashMap, keyAt(i), &benchValue);
+    }
+    report("flat", load, "put", n, nowNs() - start);
+
+    size_t found = 0;
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        found += flatGet(hashMap, shuffledKeyAt(i, n)) != NULL;
+    }
+    report("flat", load, "get_hit", n, nowNs() - start);
+
+    start = nowNs();
+    for (size_t i = n; i < 2 * n; i++) {
+        found += flatGet(hashMap, keyAt(i)) != NULL;
+    }
+    report("flat", load, "get_miss", n, nowNs() - start);
+
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        flatRemoveItem(hashMap, shuffledKeyAt(i, n));
+    }
+    report("flat", load, "remove", n, nowNs() - start);
+
+    if (found != n) {
+        fprintf(stderr, "flat: 查找结果错误 %zu/%zu\n", found, n);
+    }
+    delHashMapFlat(hashMap);
+}
+
+static void benchRobin(size_t slots, double load) {
+    size_t n = (size_t)((double)slots * load);
+    HashMapRobin *hashMap = newHashMapRobin(slots, NULL);
+    if (hashMap == NULL) {
+        return;
+    }
+
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        robinPut(hashMap, keyAt(i), &benchValue);
+    }
+    report("robin", load, "put", n, nowNs() - start);
+
+    size_t found = 0;
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        found += robinGet(hashMap, shuffledKeyAt(i, n)) != NULL;
+    }
+    report("robin", load, "get_hit", n, nowNs() - start);
+
+    start = nowNs();
+    for (size_t i = n; i < 2 * n; i++) {
+        found += robinGet(hashMap, keyAt(i)) != NULL;
+    }
+    report("robin", load, "get_miss", n, nowNs() - start);
+
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        robinRemoveItem(hashMap, shuffledKeyAt(i, n));
+    }
+    report("robin", load, "remove", n, nowNs() - start);
+
+    if (found != n) {
+        fprintf(stderr, "robin: 查找结果错误 %zu/%zu\n", found, n);
+    }
+    delHashMapRobin(hashMap);
+}
+
+static void benchCuckoo(size_t slots, double load) {
+    size_t n = (size_t)((double)slots * load);
+    HashMapCuckoo *hashMap = newHashMapCuckoo(slots, NULL);
+    if (hashMap == NULL) {
+        return;
+    }
+
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        cuckooPut(hashMap, keyAt(i), &benchValue);
+    }
+    report("cuckoo", load, "put", n, nowNs() - start);
+
+    size_t found = 0;
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        found += cuckooGet(hashMap, shuffledKeyAt(i, n)) != NULL;
+    }
+    report("cuckoo", load, "get_hit", n, nowNs() - start);
+
+    start = nowNs();
+    for (size_t i = n; i < 2 * n; i++) {
+        found += cuckooGet(hashMap, keyAt(i)) != NULL;
+    }
+    report("cuckoo", load, "get_miss", n, nowNs() - start);
+
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        cuckooRemoveItem(hashMap, shuffledKeyAt(i, n));
+    }
+    report("cuckoo", load, "remove", n, nowNs() - start);
+
+    if (found != n) {
+        fprintf(stderr, "cuckoo: 查找结果错误 %zu/%zu\n", found, n);
+    }
+    delHashMapCuckoo(hashMap);
+}
+
+// 只存放键的集合，与 flat 使用相同的探测方式
+static void benchSet(size_t slots, double load) {
+    size_t n = (size_t)((double)slots * load);
+    HashSet *set = newHashSet(slots);
+    if (set == NULL) {
+        return;
+    }
+
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        setInsert(set, keyAt(i));
+    }
+    report("set", load, "put", n, nowNs() - start);
+
+    size_t found = 0;
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        found += setContains(set, shuffledKeyAt(i, n));
+    }
+    report("set", load, "get_hit", n, nowNs() - start);
+
+    start = nowNs();
+    for (size_t i = n; i < 2 * n; i++) {
+        found += setContains(set, keyAt(i));
+    }
+    report("set", load, "get_miss", n, nowNs() - start);
+
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        setErase(set, shuffledKeyAt(i, n));
+    }
+    report("set", load, "remove", n, nowNs() - start);
+
+    if (found != n) {
+        fprintf(stderr, "set: 查找结果错误 %zu/%zu\n", found, n);
+    }
+    delHashSet(set);
+}
+
+// 生成器特化的哈希表：值按 int 存放，按预计数量初始化
+static void benchGenerated(size_t slots, double load) {
+    size_t n = (size_t)((double)slots * load);
+    BenchIntMap map;
+    if (!BenchIntMap_init(&map, n)) {
+        return;
+    }
+
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        BenchIntMap_put(&map, keyAt(i), benchValue);
+    }
+    report("generated", load, "put", n, nowNs() - start);
+
+    size_t found = 0;
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        found += BenchIntMap_get(&map, shuffledKeyAt(i, n)) != NULL;
+    }
+    report("generated", load, "get_hit", n, nowNs() - start);
+
+    start = nowNs();
+    for (size_t i = n; i < 2 * n; i++) {
+        found += BenchIntMap_get(&map, keyAt(i)) != NULL;
+    }
+    report("generated", load, "get_miss", n, nowNs() - start);
+
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        BenchIntMap_remove(&map, shuffledKeyAt(i, n));
+    }
+    report("generated", load, "remove", n, nowNs() - start);
+
+    if (found != n) {
+        fprintf(stderr, "generated: 查找结果错误 %zu/%zu\n", found, n);
+    }
+    BenchIntMap_destroy(&map);
+}
+
+// 批量接口：键预先放在数组中，与逐个调用的 put/get_hit/remove 对比
+static void benchBatch(const char *engine, size_t slots, double load) {
+    size_t n = (size_t)((double)slots * load);
+    HashMapChainingConfig config = defaultHashMapConfig(slots, NULL);
+    config.pow2Capacity = true;
+    HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+    int *keys = (int *)malloc(n * sizeof(int));
+    void **vals = (void **)malloc(n * sizeof(void *));
+    if (hashMap == NULL || keys == NULL || vals == NULL) {
+        delHashMapChaining(hashMap);
+        free(keys);
+        free(vals);
+        return;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = keyAt(i);
+        vals[i] = &benchValue;
+    }
+    uint64_t start = nowNs();
+    putBatch(hashMap, keys, vals, n);
+    report(engine, load, "put_batch", n, nowNs() - start);
+
+    for (size_t i = 0; i < n; i++) {
+        keys[i] = shuffledKeyAt(i, n);
+    }
+    start = nowNs();
+    size_t found = getBatch(hashMap, keys, n, vals);
+    report(engine, load, "get_hit_batch", n, nowNs() - start);
+
+    start = nowNs();
+    removeBatch(hashMap, keys, n);
+    report(engine, load, "remove_batch", n, nowNs() - start);
+
+    if (found != n) {
+        fprintf(stderr, "%s: 批量查找结果错误 %zu/%zu\n", engine, found, n);
+    }
+    delHashMapChaining(hashMap);
+    free(keys);
+    free(vals);
+}
+
+// 从很小的容量开始插入，记录扩容期间单次 put 的最大耗时
+static void benchGrowth(const char *engine, size_t n, bool incrementalRehash) {
+    HashMapChainingConfig config = defaultHashMapConfig(16, NULL);
+    config.pow2Capacity = true;
+    config.incrementalRehash = incrementalRehash;
+    HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+    if (hashMap == NULL) {
+        return;
+    }
+
+    uint64_t worst = 0;
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        uint64_t opStart = nowNs();
+        put(hashMap, keyAt(i), &benchValue);
+        uint64_t elapsed = nowNs() - opStart;
+        if (elapsed > worst) {
+            worst = elapsed;
+        }
+    }
+    uint64_t total = nowNs() - start;
+    double load = (double)loadFactor(hashMap);
+    report(engine, load, "put_grow", n, total);
+    report(engine, load, "put_grow_max", 1, worst);
+    delHashMapChaining(hashMap);
+}
+
+// 一次性扩容：填满到负载因子 0.75 后把桶数量翻倍，比较不同线程数下每个节点的迁移耗时
+static void benchParallelRehash(size_t slots) {
+    size_t n = slots / 4 * 3;
+    const size_t threads[] = {1, 2, 4, 8};
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        HashMapChainingConfig config = defaultHashMapConfig(slots, NULL);
+        config.pow2Capacity = true;
+        config.rehashThreads = threads[t];
+        HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+        if (hashMap == NULL) {
+            return;
+        }
+        for (size_t i = 0; i < n; i++) {
+            put(hashMap, keyAt(i), &benchValue);
+        }
+
+        char engine[32];
+        snprintf(engine, sizeof(engine), "chaining_rehash_t%zu", threads[t]);
+        uint64_t start = nowNs();
+        reserve(hashMap, n * 2);
+        report(engine, 0.75, "rehash", n, nowNs() - start);
+        delHashMapChaining(hashMap);
+    }
+}
+
+static void sumKey(void *acc, int key, void *val, void *ctx) {
+    (void)val;
+    (void)ctx;
+    *(uint64_t *)acc += (uint32_t)key;
+}
+
+static void combineSum(void *acc, const void *other, void *ctx) {
+    (void)ctx;
+    *(uint64_t *)acc += *(const uint64_t *)other;
+}
+
+// 全表扫描：迭代器顺序遍历与 1/2/4/8 线程归约对比（每个键值对的纳秒数）
+static void benchParallelScan(size_t slots) {
+    size_t n = slots / 4 * 3;
+    HashMapChainingConfig config = defaultHashMapConfig(slots, NULL);
+    config.pow2Capacity = true;
+    HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+    if (hashMap == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        put(hashMap, keyAt(i), &benchValue);
+    }
+
+    uint64_t expected = 0;
+    uint64_t start = nowNs();
+    for (HashMapIterator it = initIterator(hashMap); hasNext(&it); next(&it)) {
+        expected += (uint32_t)getKey(&it);
+    }
+    report("chaining_iterator", 0.75, "scan", n, nowNs() - start);
+
+    const size_t threads[] = {1, 2, 4, 8};
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        char engine[32];
+        snprintf(engine, sizeof(engine), "chaining_reduce_t%zu", threads[t]);
+        // 线程池在计时之外创建，只测量扫描本身
+        ThreadPool *pool = threads[t] > 1 ? newThreadPool(threads[t]) : NULL;
+        uint64_t sum = 0;
+        start = nowNs();
+        hashMapReduceParallelPool(hashMap, &sum, sizeof(sum), sumKey, combineSum, NULL, pool);
+        report(engine, 0.75, "scan", n, nowNs() - start);
+        delThreadPool(pool);
+        if (sum != expected) {
+            fprintf(stderr, "%s: 归约结果错误\n", engine);
+        }
+    }
+    delHashMapChaining(hashMap);
+}
+
+// 多线程构建：8 个私有哈希表各写入 1/8 的键，比较写入单个哈希表与 1/2/4/8 线程合并的耗时
+static void benchBuilderMerge(size_t slots) {
+    enum { LOCALS = 8 };
+    size_t n = slots / 4 * 3;
+    HashMapChainingConfig config = defaultHashMapConfig(slots / LOCALS, NULL);
+    config.pow2Capacity = true;
+
+    HashMapChaining *single = newHashMapChainingWithConfig(&config);
+    if (single == NULL) {
+        return;
+    }
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        put(single, keyAt(i), &benchValue);
+    }
+    report("chaining_single_build", 0.75, "put", n, nowNs() - start);
+    delHashMapChaining(single);
+
+    const size_t threads[] = {1, 2, 4, 8};
+    for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        HashMapBuilder *builder = newHashMapBuilder(&config, LOCALS);
+        if (builder == NULL) {
+            return;
+        }
+        start = nowNs();
+        for (size_t i = 0; i < n; i++) {
+            put(builderLocal(builder, i % LOCALS), keyAt(i), &benchValue);
+        }
+        report("builder_local", 0.75, "put", n, nowNs() - start);
+
+        char engine[32];
+        snprintf(engine, sizeof(engine), "builder_merge_t%zu", threads[t]);
+        start = nowNs();
+        HashMapChaining *merged = builderMerge(builder, NULL, NULL, threads[t]);
+        report(engine, 0.75, "merge", n, nowNs() - start);
+        if (merged == NULL || size(merged) != n) {
+            fprintf(stderr, "%s: 合并结果错误\n", engine);
+        }
+        delHashMapChaining(merged);
+        delHashMapBuilder(builder);
+    }
+}
+
+// 键分布：连续键、步长为 1024 的键（低位全为0）、伪随机键
+static int patternKey(int pattern, size_t i) {
+    switch (pattern) {
+    case 0:
+        return (int)i;
+    case 1:
+        return (int)(uint32_t)((uint32_t)i * 1024u);
+    default:
+        return keyAt(i);
+    }
+}
+
+// 各哈希策略在不同键分布下的链长分布与命中查找耗时
+static void benchHashDistribution(size_t slots) {
+    static const char *patternNames[] = {"sequential", "stride1024", "random"};
+    enum { BINS = 17 };
+    size_t n = slots / 2;
+
+    printf("hash,pattern,buckets,max_chain,empty_ratio,chain_ge4_ratio,get_hit_ns\n");
+    for (int kind = 0; kind < HASH_KIND_COUNT; kind++) {
+        for (int pattern = 0; pattern < 3; pattern++) {
+            HashMapChainingConfig config = defaultHashMapConfig(slots, NULL);
+            config.pow2Capacity = true;
+            config.hashKind = (HashKind)kind;
+            config.hashSeed = 0x5EED;
+            HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+            if (hashMap == NULL) {
+                return;
+            }
+            for (size_t i = 0; i < n; i++) {
+                put(hashMap, patternKey(pattern, i), &benchValue);
+            }
+
+            size_t found = 0;
+            uint64_t start = nowNs();
+            for (size_t i = 0; i < n; i++) {
+                found += get(hashMap, patternKey(pattern, (size_t)(((uint64_t)i * 2654435761ULL) % n))) != NULL;
+            }
+            uint64_t elapsed = nowNs() - start;
+
+            size_t histogram[BINS];
+            chainLengthHistogram(hashMap, histogram, BINS);
+            size_t buckets = 0, maxChain = 0, longChains = 0;
+            for (size_t i = 0; i < BINS; i++) {
+                buckets += histogram[i];
+                if (histogram[i] > 0) {
+                    maxChain = i;
+                }
+                if (i >= 4) {
+                    longChains += histogram[i];
+                }
+            }
+            printf("%s,%s,%zu,%zu%s,%.4f,%.4f,%.2f\n", hashKindName((HashKind)kind), patternNames[pattern],
+                   buckets, maxChain, maxChain == BINS - 1 ? "+" : "",
+                   (double)histogram[0] / (double)buckets, (double)longChains / (double)buckets,
+                   (double)elapsed / (double)n);
+            if (found != n) {
+                fprintf(stderr, "%s: 查找结果错误 %zu/%zu\n", hashKindName((HashKind)kind), found, n);
+            }
+            delHashMapChaining(hashMap);
+        }
+    }
+}
+
+/*
+ * 基准测试套件
+ *
+ * 对每种键分布和表大小，分别测量 put、命中 get、未命中 get、removeItem、迭代和扩容的吞吐量
+ * 与单次操作延迟分位数。每次操作单独计时，延迟中包含一次计时调用的开销（通常为 20ns 左右）。
+ * 表大小从能放进 L1 的几百个键到远超末级缓存的数百万个键。
+ */
+
+enum { DIST_UNIFORM, DIST_SEQUENTIAL, DIST_ZIPF, DIST_ADVERSARIAL, DIST_COUNT };
+
+static const char *distNames[DIST_COUNT] = {"uniform", "sequential", "zipf", "adversarial"};
+
+#define SUITE_ZIPF_THETA 0.99  // Zipf 分布参数，越大越集中在少数热点键
+
+typedef struct {
+    bool json;        // 输出 JSON 而不是 CSV
+    bool first;       // JSON 数组中是否还没有输出过元素
+    HashKind hashKind;
+} SuiteOutput;
+
+// xorshift64* 随机数，固定种子保证每次运行的键序列相同
+static uint64_t suiteRandom(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+// 对抗性键：只有高位不同、低位全为0，针对直接用低位取桶的哈希策略
+static int adversarialKey(size_t i, size_t n) {
+    uint32_t stride = 1;
+    while ((uint64_t)stride * 2 * (uint64_t)n * 4 <= ((uint64_t)1 << 32)) {
+        stride *= 2;
+    }
+    return (int)(uint32_t)((uint32_t)i * stride);
+}
+
+// 第 i 个插入的键；i >= n 时为保证不在表中的键
+static int suiteKey(int dist, size_t i, size_t n) {
+    switch (dist) {
+    case DIST_SEQUENTIAL:
+        return (int)i;
+    case DIST_ADVERSARIAL:
+        return adversarialKey(i, n);
+    default:
+        return keyAt(i);
+    }
+}
+
+// 生成 n 个已插入键的访问序列：顺序分布按插入顺序，Zipf 分布有重复的热点键，其余为随机排列
+static void suiteLookupOrder(int dist, size_t n, int *out) {
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    if (dist == DIST_SEQUENTIAL) {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = suiteKey(dist, i, n);
+        }
+        return;
+    }
+    if (dist == DIST_ZIPF) {
+        // 累积分布表加二分查找，排名为 r 的键映射到 shuffledKeyAt(r)，避免热点键集中在相邻桶
+        double *cdf = (double *)malloc(n * sizeof(double));
+        if (cdf != NULL) {
+            double sum = 0;
+            for (size_t r = 0; r < n; r++) {
+                sum += 1.0 / pow((double)(r + 1), SUITE_ZIPF_THETA);
+                cdf[r] = sum;
+            }
+            for (size_t i = 0; i < n; i++) {
+                double u = (double)(suiteRandom(&state) >> 11) * (1.0 / 9007199254740992.0) * sum;
+                size_t lo = 0, hi = n - 1;
+                while (lo < hi) {
+                    size_t mid = lo + (hi - lo) / 2;
+                    if (cdf[mid] < u) {
+                        lo = mid + 1;
+                    } else {
+                        hi = mid;
+                    }
+                }
+                out[i] = shuffledKeyAt(lo, n);
+            }
+            free(cdf);
+            return;
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        out[i] = suiteKey(dist, i, n);
+    }
+    for (size_t i = n; i > 1; i--) {
+        size_t j = (size_t)(suiteRandom(&state) % i);
+        int tmp = out[i - 1];
+        out[i - 1] = out[j];
+        out[j] = tmp;
+    }
+}
+
+static int compareU64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// 已排序样本的分位数
+static uint64_t percentile(const uint64_t *sorted, size_t n, double p) {
+    size_t rank = (size_t)ceil(p * (double)n);
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+// 输出一条结果，samples 会被排序
+static void suiteReport(SuiteOutput *out, int dist, size_t keys, const char *op,
+                        uint64_t *samples, size_t ops, uint64_t totalNs) {
+    qsort(samples, ops, sizeof(uint64_t), compareU64);
+    double mops = (double)ops * 1000.0 / (double)(totalNs > 0 ? totalNs : 1);
+    uint64_t p50 = percentile(samples, ops, 0.5);
+    uint64_t p99 = percentile(samples, ops, 0.99);
+    uint64_t p999 = percentile(samples, ops, 0.999);
+    uint64_t max = samples[ops - 1];
+    const char *hash = hashKindName(out->hashKind);
+
+    if (out->json) {
+        printf("%s\n  {\"hash\":\"%s\",\"dist\":\"%s\",\"keys\":%zu,\"op\":\"%s\",\"ops\":%zu,\"mops\":%.3f,"
+               "\"p50_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,\"max_ns\":%llu}",
+               out->first ? "" : ",", hash, distNames[dist], keys, op, ops, mops,
+               (unsigned long long)p50, (unsigned long long)p99,
+               (unsigned long long)p999, (unsigned long long)max);
+        out->first = false;
+    } else {
+        printf("%s,%s,%zu,%s,%zu,%.3f,%llu,%llu,%llu,%llu\n", hash, distNames[dist], keys, op, ops, mops,
+               (unsigned long long)p50, (unsigned long long)p99,
+               (unsigned long long)p999, (unsigned long long)max);
+    }
+}
+
+// 迭代访问的键值对计数，防止迭代被优化掉
+static size_t iterateSink;
+
+// 对一种键分布和一个表大小运行全部操作
+static void suiteRun(SuiteOutput *out, int dist, size_t n) {
+    uint64_t *samples = (uint64_t *)malloc(n * sizeof(uint64_t));
+    int *order = (int *)malloc(n * sizeof(int));
+    HashMapChainingConfig config = defaultHashMapConfig(16, NULL);
+    config.pow2Capacity = true;
+    config.hashKind = out->hashKind;
+    config.hashSeed = 0x5EED;
+    HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+    if (samples == NULL || order == NULL || hashMap == NULL) {
+        free(samples);
+        free(order);
+        delHashMapChaining(hashMap);
+        return;
+    }
+
+    // 扩容：从16个桶开始插入，每次 put 单独计时，尾部延迟主要来自 extend
+    uint64_t start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        int key = suiteKey(dist, i, n);
+        uint64_t t0 = nowNs();
+        put(hashMap, key, &benchValue);
+        samples[i] = nowNs() - t0;
+    }
+    suiteReport(out, dist, n, "extend", samples, n, nowNs() - start);
+
+    // put：在已经足够大的表中插入，不触发扩容
+    delHashMapChaining(hashMap);
+    config.capacity = n * 2;
+    hashMap = newHashMapChainingWithConfig(&config);
+    if (hashMap == NULL) {
+        free(samples);
+        free(order);
+        return;
+    }
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        int key = suiteKey(dist, i, n);
+        uint64_t t0 = nowNs();
+        put(hashMap, key, &benchValue);
+        samples[i] = nowNs() - t0;
+    }
+    suiteReport(out, dist, n, "put", samples, n, nowNs() - start);
+
+    suiteLookupOrder(dist, n, order);
+    size_t found = 0;
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        uint64_t t0 = nowNs();
+        found += get(hashMap, order[i]) != NULL;
+        samples[i] = nowNs() - t0;
+    }
+    suiteReport(out, dist, n, "get_hit", samples, n, nowNs() - start);
+
+    for (size_t i = 0; i < n; i++) {
+        order[i] = suiteKey(dist, n + i, n);
+    }
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        uint64_t t0 = nowNs();
+        found += get(hashMap, order[i]) != NULL;
+        samples[i] = nowNs() - t0;
+    }
+    suiteReport(out, dist, n, "get_miss", samples, n, nowNs() - start);
+
+    // 迭代：每访问一个键值对记录一次样本
+    size_t visited = 0;
+    start = nowNs();
+    uint64_t t0 = start;
+    HashMapIterator it = initIterator(hashMap);
+    while (hasNext(&it) && visited < n) {
+        iterateSink += getValue(&it) != NULL;
+        next(&it);
+        uint64_t t1 = nowNs();
+        samples[visited++] = t1 - t0;
+        t0 = t1;
+    }
+    if (visited > 0) {
+        suiteReport(out, dist, n, "iterate", samples, visited, nowNs() - start);
+    }
+
+    // removeItem：Zipf 分布的访问序列有重复，删除统一使用随机排列
+    suiteLookupOrder(dist == DIST_ZIPF ? DIST_UNIFORM : dist, n, order);
+    start = nowNs();
+    for (size_t i = 0; i < n; i++) {
+        uint64_t t1 = nowNs();
+        removeItem(hashMap, order[i]);
+        samples[i] = nowNs() - t1;
+    }
+    suiteReport(out, dist, n, "remove", samples, n, nowNs() - start);
+
+    if (found != n || visited != n || size(hashMap) != 0) {
+        fprintf(stderr, "%s/%zu: 结果错误 found=%zu visited=%zu\n", distNames[dist], n, found, visited);
+    }
+    delHashMapChaining(hashMap);
+    free(samples);
+    free(order);
+}
+
+static void runSuite(bool json, HashKind hashKind, size_t maxKeys) {
+    // 约 40 字节/键：512 个键在 L1 内，16K 在 L2 内，256K 接近末级缓存，4M 远超末级缓存
+    const size_t sizes[] = {512, 16384, 262144, 4194304};
+    SuiteOutput out = {json, true, hashKind};
+
+    if (json) {
+        printf("[");
+    } else {
+        printf("hash,dist,keys,op,ops,mops,p50_ns,p99_ns,p999_ns,max_ns\n");
+    }
+    for (int dist = 0; dist < DIST_COUNT; dist++) {
+        for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]) && sizes[i] <= maxKeys; i++) {
+            suiteRun(&out, dist, sizes[i]);
+        }
+    }
+    if (json) {
+        printf("\n]\n");
+    }
+}
+
+/* 24 字节的值，比较指针存放与内联存放 */
+typedef struct {
+    uint64_t a;
+    uint64_t b;
+    uint64_t c;
+} BenchValue;
+
+static void freeBenchValue(void *ptr) {
+    free(ptr);
+}
+
+// 内联值：值单独分配并保存指针，与按值拷贝到节点中对比 put 和读取值字段的 get_hit
+static void benchInlineValues(size_t slots) {
+    size_t n = slots / 4 * 3;
+    for (int inlineValues = 0; inlineValues <= 1; inlineValues++) {
+        const char *engine = inlineValues ? "chaining_inline" : "chaining_ptr";
+        HashMapChainingConfig config = defaultHashMapConfig(slots, freeBenchValue);
+        config.pow2Capacity = true;
+        config.valSize = inlineValues ? sizeof(BenchValue) : 0;
+        HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+        if (hashMap == NULL) {
+            return;
+        }
+
+        uint64_t start = nowNs();
+        for (size_t i = 0; i < n; i++) {
+            BenchValue value = {i, i, i};
+            if (inlineValues) {
+                putCopy(hashMap, keyAt(i), &value);
+            } else {
+                BenchValue *boxed = (BenchValue *)malloc(sizeof(BenchValue));
+                if (boxed == NULL) {
+                    break;
+                }
+                *boxed = value;
+                put(hashMap, keyAt(i), boxed);
+            }
+        }
+        report(engine, 0.75, "put", n, nowNs() - start);
+
+        uint64_t sum = 0;
+        start = nowNs();
+        for (size_t i = 0; i < n; i++) {
+            const BenchValue *value = (const BenchValue *)getPtr(hashMap, shuffledKeyAt(i, n));
+            sum += value != NULL ? value->b : 0;
+        }
+        report(engine, 0.75, "get_hit", n, nowNs() - start);
+
+        if (sum != (uint64_t)n * (n - 1) / 2) {
+            fprintf(stderr, "%s: 查找结果错误\n", engine);
+        }
+        delHashMapChaining(hashMap);
+    }
+}
+
+// 缓存：容量为槽位数量的 1/8，80% 的访问落在 1/16 的热点键上，未命中时写入。
+// 对比缓存模式的 CLOCK 淘汰与用迭代器 removeCurrent 手动淘汰（每次从桶数组头部找第一个键），load 列输出命中率
+static void benchCache(size_t slots) {
+    size_t entries = slots / 8 > 0 ? slots / 8 : 1;
+    size_t hot = slots / 16 > 0 ? slots / 16 : 1;
+    size_t ops = slots;
+    for (int manual = 0; manual <= 1; manual++) {
+        HashMapChainingConfig config = defaultHashMapConfig(16, NULL);
+        config.pow2Capacity = true;
+        config.cacheMaxEntries = manual ? 0 : entries;
+        HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+        if (hashMap == NULL) {
+            return;
+        }
+
+        uint64_t state = 0x9E3779B97F4A7C15ULL;
+        size_t hits = 0;
+        uint64_t start = nowNs();
+        for (size_t i = 0; i < ops; i++) {
+            uint64_t r = suiteRandom(&state);
+            int key = keyAt(r % 10 < 8 ? (size_t)(r >> 32) % hot : (size_t)(r >> 32) % slots);
+            if (get(hashMap, key) != NULL) {
+                hits++;
+                continue;
+            }
+            if (manual && size(hashMap) >= entries) {
+                HashMapIterator it = initIterator(hashMap);
+                removeCurrent(&it);
+            }
+            put(hashMap, key, &benchValue);
+        }
+        const char *engine = manual ? "chaining_manual_evict" : "chaining_cache";
+        report(engine, (double)hits / (double)ops, "get_or_put", ops, nowNs() - start);
+        delHashMapChaining(hashMap);
+    }
+}
+
+// 稀疏遍历：插入后删除 99% 的键，比较三种哈希表遍历剩余键的耗时（每个剩余键的纳秒数）
+static void benchSparseIteration(size_t slots) {
+    size_t n = slots / 4 * 3;
+    size_t keep = n / 100 > 0 ? n / 100 : 1;
+    HashMapChaining *chaining = newHashMapChaining(slots, NULL);
+    HashMapFlat *flat = newHashMapFlat(slots, NULL);
+    HashMapOrdered *ordered = newHashMapOrdered(n, NULL);
+    if (chaining == NULL || flat == NULL || ordered == NULL) {
+        delHashMapChaining(chaining);
+        delHashMapFlat(flat);
+        delHashMapOrdered(ordered);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        put(chaining, keyAt(i), &benchValue);
+        flatPut(flat, keyAt(i), &benchValue);
+        orderedPut(ordered, keyAt(i), &benchValue);
+    }
+    for (size_t i = keep; i < n; i++) {
+        removeItem(chaining, keyAt(i));
+        flatRemoveItem(flat, keyAt(i));
+        orderedRemoveItem(ordered, keyAt(i));
+    }
+
+    size_t visited = 0;
+    uint64_t start = nowNs();
+    for (HashMapIterator it = initIterator(chaining); hasNext(&it); next(&it)) {
+        visited += getValue(&it) != NULL;
+    }
+    report("chaining", 0.0075, "iterate_sparse", keep, nowNs() - start);
+    start = nowNs();
+    for (HashMapFlatIterator it = flatInitIterator(flat); flatHasNext(&it); flatNext(&it)) {
+        visited += flatGetValue(&it) != NULL;
+    }
+    report("flat", 0.0075, "iterate_sparse", keep, nowNs() - start);
+    start = nowNs();
+    for (HashMapOrderedIterator it = orderedInitIterator(ordered); orderedHasNext(&it); orderedNext(&it)) {
+        visited += orderedGetValue(&it) != NULL;
+    }
+    report("ordered", 0.0075, "iterate_sparse", keep, nowNs() - start);
+
+    if (visited != keep * 3) {
+        fprintf(stderr, "稀疏遍历结果错误 %zu/%zu\n", visited, keep * 3);
+    }
+    delHashMapChaining(chaining);
+    delHashMapFlat(flat);
+    delHashMapOrdered(ordered);
+}
+
+// 引擎对比：不同负载因子下的链式/开放寻址/Robin Hood/布谷鸟/生成器特化哈希表、批量接口、扩容停顿、多线程扩容、扫描与构建合并、稀疏遍历、内联值和缓存淘汰
+static void runEngineComparison(size_t slots) {
+    const double loads[] = {0.5, 0.75, 0.875};
+    printf("section,engine,load,op,ops,ns_per_op\n");
+    reportSection = "load";
+    for (size_t i = 0; i < sizeof(loads) / sizeof(loads[0]); i++) {
+        benchChaining("chaining", slots, loads[i], false);
+        benchChaining("chaining_pow2", slots, loads[i], true);
+        benchBatch("chaining_pow2", slots, loads[i]);
+        benchFlat(slots, loads[i]);
+        benchSet(slots, loads[i]);
+        benchRobin(slots, loads[i]);
+        benchCuckoo(slots, loads[i]);
+        benchGenerated(slots, loads[i]);
+    }
+    benchRobin(slots, 0.9);
+    benchCuckoo(slots, 0.9);
+    benchCuckoo(slots, 0.95);
+    reportSection = "growth";
+    benchGrowth("chaining_pow2", slots, false);
+    benchGrowth("chaining_incremental", slots, true);
+    reportSection = "parallel_rehash";
+    benchParallelRehash(slots);
+    reportSection = "scan";
+    benchParallelScan(slots);
+    reportSection = "builder";
+    benchBuilderMerge(slots);
+    reportSection = "sparse_iteration";
+    benchSparseIteration(slots);
+    reportSection = "inline_values";
+    benchInlineValues(slots);
+    reportSection = "cache";
+    benchCache(slots);
+}
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "用法: %s [--json] [--hash identity|fibonacci|murmur|wyhash] [--max-keys N]\n"
+            "       %s --engines [槽位数量]\n"
+            "       %s --hash-dist [槽位数量]\n", prog, prog, prog);
+}
+
+// 解析 --engines / --hash-dist 后面可选的槽位数量（桶数量）
+static size_t slotsArg(int argc, char *argv[], int i) {
+    size_t slots = (size_t)1 << 20;
+    if (i + 1 < argc) {
+        slots = (size_t)strtoull(argv[i + 1], NULL, 10);
+    }
+    return slots < 16 ? 16 : slots;
+}
+
+int main(int argc, char *argv[]) {
+    bool json = false;
+    HashKind hashKind = HASH_KIND_MURMUR;
+    size_t maxKeys = (size_t)1 << 22;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else if (strcmp(argv[i], "--max-keys") == 0 && i + 1 < argc) {
+            maxKeys = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--hash") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            int kind = 0;
+            while (kind < HASH_KIND_COUNT && strcmp(hashKindName((HashKind)kind), name) != 0) {
+                kind++;
+            }
+            if (kind == HASH_KIND_COUNT) {
+                usage(argv[0]);
+                return 1;
+            }
+            hashKind = (HashKind)kind;
+        } else if (strcmp(argv[i], "--engines") == 0) {
+            runEngineComparison(slotsArg(argc, argv, i));
+            return 0;
+        } else if (strcmp(argv[i], "--hash-dist") == 0) {
+            benchHashDistribution(slotsArg(argc, argv, i));
+            return 0;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    runSuite(json, hashKind, maxKeys);
+    return 0;
+}
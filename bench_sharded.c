@@ -0,0 +1,182 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <pthread.h>
+#include "hash_table.h"
+#include "hash_map_sharded.h"
+#include "hash_map_epoch.h"
+
+/*
+ * 多线程基准测试：比较全局互斥锁保护的 HashMapChaining、分片哈希表和读无锁哈希表
+ * 在 1~64 个线程下的吞吐量
+ *
+ * 每个线程执行相同数量的随机操作，其中 90% 为查找，5% 为添加，5% 为删除。
+ */
+
+#define BENCH_READ_PERCENT 90
+#define BENCH_PUT_PERCENT 5
+
+static int benchValue = 1;  // 所有键共用的非NULL值
+
+typedef struct {
+    HashMapChaining *map;
+    pthread_mutex_t lock;
+} LockedMap;
+
+typedef struct {
+    LockedMap *locked;        // 非NULL时测试全局锁哈希表
+    HashMapSharded *sharded;  // 非NULL时测试分片哈希表
+    HashMapEpoch *epochMap;   // 非NULL时测试读无锁哈希表
+    HashMapEpochReader *reader; // 读无锁哈希表的读者句柄
+    size_t keyRange;          // 键的取值范围
+    size_t ops;               // 本线程执行的操作数
+    uint64_t seed;            // 随机数种子
+    size_t hits;              // 查找命中次数，防止查找被优化掉
+} Worker;
+
+// 获取单调时间（纳秒）
+static uint64_t nowNs(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// xorshift64* 随机数
+static uint64_t nextRandom(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+static void *runWorker(void *arg) {
+    Worker *worker = (Worker *)arg;
+    uint64_t state = worker->seed;
+    size_t hits = 0;
+
+    for (size_t i = 0; i < worker->ops; i++) {
+        uint64_t r = nextRandom(&state);
+        int key = (int)(uint32_t)((r >> 32) % worker->keyRange);
+        unsigned percent = (unsigned)(r % 100);
+
+        if (worker->epochMap != NULL) {
+            if (percent < BENCH_READ_PERCENT) {
+                hits += epochMapGet(worker->epochMap, worker->reader, key) != NULL;
+            } else if (percent < BENCH_READ_PERCENT + BENCH_PUT_PERCENT) {
+                epochMapPut(worker->epochMap, key, &benchValue);
+            } else {
+                epochMapRemoveItem(worker->epochMap, key);
+            }
+        } else if (worker->sharded != NULL) {
+            if (percent < BENCH_READ_PERCENT) {
+                hits += shardedGet(worker->sharded, key) != NULL;
+            } else if (percent < BENCH_READ_PERCENT + BENCH_PUT_PERCENT) {
+                shardedPut(worker->sharded, key, &benchValue);
+            } else {
+                shardedRemoveItem(worker->sharded, key);
+            }
+        } else {
+            pthread_mutex_lock(&worker->locked->lock);
+            if (percent < BENCH_READ_PERCENT) {
+                hits += get(worker->locked->map, key) != NULL;
+            } else if (percent < BENCH_READ_PERCENT + BENCH_PUT_PERCENT) {
+                put(worker->locked->map, key, &benchValue);
+            } else {
+                removeItem(worker->locked->map, key);
+            }
+            pthread_mutex_unlock(&worker->locked->lock);
+        }
+    }
+    worker->hits = hits;
+    return NULL;
+}
+
+// 用 threads 个线程运行一轮测试，proto 指定被测哈希表，返回总耗时（纳秒）
+static uint64_t runRound(const Worker *proto, size_t threads) {
+    pthread_t tids[64];
+    Worker workers[64];
+
+    for (size_t t = 0; t < threads; t++) {
+        workers[t] = *proto;
+        workers[t].seed = 0x9E3779B97F4A7C15ULL * (t + 1);
+        workers[t].hits = 0;
+        workers[t].reader = proto->epochMap != NULL ? epochMapRegisterReader(proto->epochMap) : NULL;
+    }
+    uint64_t start = nowNs();
+    for (size_t t = 0; t < threads; t++) {
+        pthread_create(&tids[t], NULL, runWorker, &workers[t]);
+    }
+    for (size_t t = 0; t < threads; t++) {
+        pthread_join(tids[t], NULL);
+    }
+    uint64_t ns = nowNs() - start;
+    for (size_t t = 0; t < threads; t++) {
+        epochMapUnregisterReader(workers[t].reader);
+    }
+    return ns;
+}
+
+static void report(const char *engine, size_t threads, size_t ops, uint64_t ns) {
+    printf("%s,%zu,%zu,%.2f,%.2f\n", engine, threads, ops,
+           (double)ns / (double)ops, (double)ops * 1000.0 / (double)ns);
+}
+
+int main(int argc, char *argv[]) {
+    // 预先插入的键数量，可通过第一个参数指定；键的取值范围为其两倍
+    size_t keys = (size_t)1 << 20;
+    if (argc > 1) {
+        keys = (size_t)strtoull(argv[1], NULL, 10);
+    }
+    if (keys < 16) {
+        keys = 16;
+    }
+    size_t opsPerThread = (size_t)1 << 19;
+    const size_t threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+
+    HashMapChainingConfig config = defaultHashMapConfig(keys, NULL);
+    config.pow2Capacity = true;
+
+    printf("engine,threads,ops,ns_per_op,mops\n");
+    for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++) {
+        size_t threads = threadCounts[i];
+
+        LockedMap locked;
+        locked.map = newHashMapChainingWithConfig(&config);
+        HashMapSharded *sharded = newHashMapSharded(HASH_MAP_SHARDED_DEFAULT_SHARDS, &config);
+        HashMapEpoch *epochMap = newHashMapEpoch(keys, NULL);
+        if (locked.map == NULL || sharded == NULL || epochMap == NULL) {
+            delHashMapChaining(locked.map);
+            delHashMapSharded(sharded);
+            delHashMapEpoch(epochMap);
+            return 1;
+        }
+        pthread_mutex_init(&locked.lock, NULL);
+        for (size_t k = 0; k < keys; k++) {
+            put(locked.map, (int)k, &benchValue);
+            shardedPut(sharded, (int)k, &benchValue);
+            epochMapPut(epochMap, (int)k, &benchValue);
+        }
+
+        Worker proto = {NULL, NULL, NULL, NULL, keys * 2, opsPerThread, 0, 0};
+        proto.locked = &locked;
+        report("global_mutex", threads, threads * opsPerThread, runRound(&proto, threads));
+        proto.locked = NULL;
+        proto.sharded = sharded;
+        report("sharded", threads, threads * opsPerThread, runRound(&proto, threads));
+        proto.sharded = NULL;
+        proto.epochMap = epochMap;
+        report("epoch", threads, threads * opsPerThread, runRound(&proto, threads));
+
+        if (size(locked.map) == 0 || shardedSize(sharded) == 0) {
+            fprintf(stderr, "哈希表意外为空\n");
+        }
+        pthread_mutex_destroy(&locked.lock);
+        delHashMapChaining(locked.map);
+        delHashMapSharded(sharded);
+        delHashMapEpoch(epochMap);
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <pthread.h>
+#include "hash_table_builder.h"
+#include "utility.h"
+
+#define TEST_LOCALS 4
+#define KEYS_PER_LOCAL 100000
+#define LOCAL_STRIDE 50000   // 相邻私有哈希表的键区间重叠一半
+
+// 释放整数指针的回调函数
+static void freeIntPtr(void *ptr) {
+    free(ptr);
+}
+
+/* 写入线程：向自己的私有哈希表写入 [first, first + KEYS_PER_LOCAL)，值为计数 1 */
+typedef struct {
+    HashMapChaining *local;
+    int first;
+} Ingest;
+
+static void *runIngest(void *arg) {
+    Ingest *ingest = (Ingest *)arg;
+    for (int i = 0; i < KEYS_PER_LOCAL; i++) {
+        int *count = (int *)malloc(sizeof(int));
+        if (count != NULL) {
+            *count = 1;
+            put(ingest->local, ingest->first + i, count);
+        }
+    }
+    return NULL;
+}
+
+// 重复键的计数相加，释放没有保存的值
+static void *sumCounts(int key, void *existing, void *incoming, void *ctx) {
+    (void)key;
+    (void)ctx;
+    *(int *)existing += *(int *)incoming;
+    free(incoming);
+    return existing;
+}
+
+// 内联值：计数直接加到已合并节点中的值上
+static void *sumInline(int key, void *existing, void *incoming, void *ctx) {
+    (void)key;
+    (void)ctx;
+    *(long *)existing += *(long *)incoming;
+    return existing;
+}
+
+// 键 key 出现在几个私有哈希表中
+static int expectedCount(int key) {
+    int count = 0;
+    for (int i = 0; i < TEST_LOCALS; i++) {
+        count += (unsigned)(key - i * LOCAL_STRIDE) < KEYS_PER_LOCAL;
+    }
+    return count;
+}
+
+#define TOTAL_KEYS ((TEST_LOCALS - 1) * LOCAL_STRIDE + KEYS_PER_LOCAL)
+
+// 按迭代顺序比较两个哈希表，顺序相同说明每个桶中的链表完全一致
+static bool sameLayout(HashMapChaining *a, HashMapChaining *b) {
+    HashMapIterator ia = initIterator(a);
+    HashMapIterator ib = initIterator(b);
+    while (hasNext(&ia) && hasNext(&ib)) {
+        if (getKey(&ia) != getKey(&ib)) {
+            return false;
+        }
+        next(&ia);
+        next(&ib);
+    }
+    return !hasNext(&ia) && !hasNext(&ib);
+}
+
+// 多个线程并行写入各自的私有哈希表，再用不同线程数合并
+static HashMapChaining *ingestAndMerge(HashMapBuilder *builder, size_t threads) {
+    pthread_t tids[TEST_LOCALS];
+    Ingest ingests[TEST_LOCALS];
+    for (int i = 0; i < TEST_LOCALS; i++) {
+        ingests[i].local = builderLocal(builder, (size_t)i);
+        ingests[i].first = i * LOCAL_STRIDE;
+        pthread_create(&tids[i], NULL, runIngest, &ingests[i]);
+    }
+    for (int i = 0; i < TEST_LOCALS; i++) {
+        pthread_join(tids[i], NULL);
+    }
+    return builderMerge(builder, sumCounts, NULL, threads);
+}
+
+static bool testMerge(void) {
+    printf("\n=== 测试1: 并行写入与合并 ===\n");
+    HashMapChainingConfig config = defaultHashMapConfig(1024, freeIntPtr);
+    config.hashSeed = 2024;
+    HashMapBuilder *builder = newHashMapBuilder(&config, TEST_LOCALS);
+    if (builder == NULL) {
+        return false;
+    }
+
+    bool ok = true;
+    HashMapChaining *first = NULL;
+    // 同一个构建器合并后私有哈希表为空，可以继续下一轮写入
+    for (size_t threads = 1; threads <= 8 && ok; threads *= 2) {
+        HashMapChaining *merged = ingestAndMerge(builder, threads);
+        ok = merged != NULL && size(merged) == TOTAL_KEYS;
+        for (int key = 0; key < TOTAL_KEYS && ok; key++) {
+            int *count = (int *)get(merged, key);
+            if (count == NULL || *count != expectedCount(key)) {
+                printf("键 %d 的计数错误\n", key);
+                ok = false;
+            }
+        }
+        for (size_t i = 0; i < TEST_LOCALS && ok; i++) {
+            ok = size(builderLocal(builder, i)) == 0;
+        }
+        bool same = ok && (first == NULL || sameLayout(first, merged));
+        printf("线程数 %zu: 合并后键值对数量 %zu，计数%s，布局与单线程%s\n", threads,
+               merged != NULL ? size(merged) : 0, ok ? "正确" : "错误", same ? "一致" : "不一致");
+        ok = ok && same;
+        if (first == NULL) {
+            first = merged;
+        } else {
+            delHashMapChaining(merged);
+        }
+    }
+
+    // 合并结果接管了节点内存，删除构建器后仍然可以正常使用
+    delHashMapBuilder(builder);
+    if (first != NULL) {
+        for (int key = 0; key < 1000; key++) {
+            removeItem(first, key);
+        }
+        int *count = (int *)malloc(sizeof(int));
+        *count = 7;
+        put(first, -1, count);
+        ok = ok && size(first) == TOTAL_KEYS - 1000 + 1 && get(first, -1) == count && get(first, 999) == NULL;
+        delHashMapChaining(first);
+    }
+    return ok;
+}
+
+static bool testInlineValues(void) {
+    printf("\n=== 测试2: 内联值合并 ===\n");
+    HashMapChainingConfig config = defaultHashMapConfig(64, NULL);
+    config.valSize = sizeof(long);
+    HashMapBuilder *builder = newHashMapBuilder(&config, 3);
+    if (builder == NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < 3; i++) {
+        for (int key = 0; key < 10000; key++) {
+            long value = (long)i + 1;
+            if (key % 3 != (int)i) {
+                put(builderLocal(builder, i), key, &value);
+            }
+        }
+    }
+    HashMapChaining *merged = builderMerge(builder, sumInline, NULL, 4);
+    bool ok = merged != NULL && size(merged) == 10000;
+    for (int key = 0; key < 10000 && ok; key++) {
+        // 每个键出现在除 key % 3 以外的两个私有哈希表中
+        long expected = 6 - (key % 3 + 1);
+        long *value = (long *)get(merged, key);
+        ok = value != NULL && *value == expected;
+    }
+    printf("合并后键值对数量 %zu，内联值%s\n", merged != NULL ? size(merged) : 0, ok ? "正确" : "错误");
+
+    // 不提供 combine 时保留下标最小的私有哈希表中的值
+    long later = 200;
+    long earlier = 100;
+    put(builderLocal(builder, 2), 5, &later);
+    put(builderLocal(builder, 0), 5, &earlier);
+    delHashMapChaining(merged);
+    merged = builderMerge(builder, NULL, NULL, 1);
+    long *kept = merged != NULL ? (long *)get(merged, 5) : NULL;
+    ok = ok && kept != NULL && *kept == 100 && size(merged) == 1;
+    printf("不提供 combine 时保留的值: %ld\n", kept != NULL ? *kept : 0);
+
+    delHashMapChaining(merged);
+    delHashMapBuilder(builder);
+    return ok;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    bool ok = testMerge();
+    ok = testInlineValues() && ok;
+    printf("\n%s\n", ok ? "所有测试通过" : "测试失败");
+
+    // 报告内存使用情况
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return ok ? 0 : 1;
+}
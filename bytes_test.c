@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash_map_bytes.h"
+#include "utility.h"
+
+// 释放整数指针的回调函数
+void freeIntPtr(void *ptr) {
+    free(ptr);
+}
+
+// 创建整数指针
+int *createIntPtr(int value) {
+    int *ptr = (int *)malloc(sizeof(int));
+    if (ptr != NULL) {
+        *ptr = value;
+    }
+    return ptr;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    // 创建字节串键哈希表
+    HashMapBytes *hashMap = newHashMapBytes(4, freeIntPtr);
+    if (hashMap == NULL) {
+        printf("创建哈希表失败\n");
+        return 1;
+    }
+
+    // 插入字符串键：短键内联保存，长键单独分配
+    printf("添加键值对到哈希表...\n");
+    char key[64];
+    for (int i = 0; i < 200; i++) {
+        if (i % 2 == 0) {
+            snprintf(key, sizeof(key), "user:%d", i);
+        } else {
+            snprintf(key, sizeof(key), "session/very-long-identifier/%08d", i);
+        }
+        bytesPut(hashMap, key, strlen(key), createIntPtr(i));
+    }
+
+    // 二进制键（包含0字节）与空键
+    unsigned char binaryKey[] = {0x00, 0x01, 0x00, 0xFF};
+    bytesPut(hashMap, binaryKey, sizeof(binaryKey), createIntPtr(1000));
+    bytesPut(hashMap, "", 0, createIntPtr(2000));
+    printf("键值对数量: %zu\n", bytesSize(hashMap));
+
+    // 验证查找结果
+    for (int i = 0; i < 200; i++) {
+        if (i % 2 == 0) {
+            snprintf(key, sizeof(key), "user:%d", i);
+        } else {
+            snprintf(key, sizeof(key), "session/very-long-identifier/%08d", i);
+        }
+        int *value = (int *)bytesGet(hashMap, key, strlen(key));
+        if (value == NULL || *value != i) {
+            printf("查找键 %s 失败\n", key);
+            delHashMapBytes(hashMap);
+            return 1;
+        }
+    }
+    int *binaryValue = (int *)bytesGet(hashMap, binaryKey, sizeof(binaryKey));
+    int *emptyValue = (int *)bytesGet(hashMap, "", 0);
+    printf("二进制键: %d, 空键: %d\n", binaryValue ? *binaryValue : -1, emptyValue ? *emptyValue : -1);
+    printf("查找前缀相同的键 user:1: %s\n", bytesGet(hashMap, "user:1", 6) ? "找到" : "未找到");
+
+    // 删除一个内联键和一个长键
+    bytesRemoveItem(hashMap, "user:0", 6);
+    snprintf(key, sizeof(key), "session/very-long-identifier/%08d", 1);
+    bytesRemoveItem(hashMap, key, strlen(key));
+    printf("删除后数量: %zu\n", bytesSize(hashMap));
+
+    // 使用迭代器遍历并在遍历中删除长键
+    size_t visited = 0;
+    HashMapBytesIterator iterator = bytesInitIterator(hashMap);
+    while (bytesHasNext(&iterator)) {
+        size_t keyLen;
+        bytesGetKey(&iterator, &keyLen);
+        visited++;
+        if (keyLen > HASH_MAP_BYTES_INLINE_KEY) {
+            bytesRemoveCurrent(&iterator);
+        } else {
+            bytesNext(&iterator);
+        }
+    }
+    printf("迭代访问 %zu 个元素, 删除长键后数量: %zu\n", visited, bytesSize(hashMap));
+
+    // 释放哈希表
+    delHashMapBytes(hashMap);
+
+    // 内存检测报告
+    MEM_REPORT();
+    MEM_CLEANUP();
+
+    return 0;
+}
@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <string.h>
+#include "hash_table.h"
+#include "hash_map_sharded.h"
+#include "utility.h"
+
+#define CACHE_ENTRIES 1000
+#define HOT_KEYS 100
+
+// 释放值的回调函数
+static void freeVal(void *ptr) {
+    free(ptr);
+}
+
+// 字符串值占用的字节数
+static size_t stringBytes(const void *val) {
+    return strlen((const char *)val) + 1;
+}
+
+static int *newInt(int value) {
+    int *ptr = (int *)malloc(sizeof(int));
+    if (ptr != NULL) {
+        *ptr = value;
+    }
+    return ptr;
+}
+
+static char *newString(size_t length) {
+    char *str = (char *)malloc(length + 1);
+    if (str != NULL) {
+        memset(str, 'x', length);
+        str[length] = '\0';
+    }
+    return str;
+}
+
+// 按数量上限淘汰，反复访问的热点键不会被淘汰
+static bool testEntryLimit(void) {
+    printf("\n=== 测试1: 数量上限与热点键 ===\n");
+    HashMapChainingConfig config = defaultHashMapConfig(16, freeVal);
+    config.cacheMaxEntries = CACHE_ENTRIES;
+    HashMapChaining *cache = newHashMapChainingWithConfig(&config);
+    if (cache == NULL) {
+        return false;
+    }
+
+    // 键 0..HOT_KEYS-1 是热点，每写入一个冷键就访问一个热点键
+    bool ok = true;
+    for (int key = 0; key < 20000; key++) {
+        put(cache, key, newInt(key));
+        ok = ok && size(cache) <= CACHE_ENTRIES;
+        get(cache, key % HOT_KEYS);
+    }
+    size_t hotLeft = 0;
+    for (int key = 0; key < HOT_KEYS; key++) {
+        int *val = (int *)get(cache, key);
+        hotLeft += val != NULL && *val == key;
+    }
+
+    HashCacheStats stats;
+    hashMapCacheStats(cache, &stats);
+    ok = ok && stats.enabled && stats.entries == CACHE_ENTRIES && stats.evictions == 20000 - CACHE_ENTRIES &&
+         hotLeft == HOT_KEYS;
+    printf("键值对数量: %zu, 淘汰: %zu, 保留的热点键: %zu/%d\n", stats.entries, stats.evictions, hotLeft, HOT_KEYS);
+
+    delHashMapChaining(cache);
+    return ok;
+}
+
+// 按字节数上限淘汰，更新和删除同步调整占用字节数
+static bool testByteLimit(void) {
+    printf("\n=== 测试2: 字节数上限 ===\n");
+    HashMapChainingConfig config = defaultHashMapConfig(64, freeVal);
+    config.cacheMaxBytes = 64 * 1024;
+    config.cacheValBytes = stringBytes;
+    HashMapChaining *cache = newHashMapChainingWithConfig(&config);
+    if (cache == NULL) {
+        return false;
+    }
+
+    bool ok = true;
+    HashCacheStats stats;
+    for (int key = 0; key < 5000; key++) {
+        put(cache, key, newString((size_t)(key % 200)));
+        hashMapCacheStats(cache, &stats);
+        ok = ok && stats.bytes <= config.cacheMaxBytes;
+    }
+
+    // 占用字节数等于剩余键值对逐个计算之和
+    size_t nodeBytes = stats.bytes;
+    for (HashMapIterator it = initIterator(cache); hasNext(&it); next(&it)) {
+        nodeBytes -= stringBytes(getValue(&it));
+    }
+    ok = ok && nodeBytes % size(cache) == 0;
+    size_t perNode = nodeBytes / size(cache);
+    printf("键值对数量: %zu, 占用: %zu 字节, 每个节点: %zu 字节, 淘汰: %zu\n",
+           size(cache), stats.bytes, perNode, stats.evictions);
+
+    // 更新为更长的值后仍不超过上限；删除后占用减少。put 不释放旧值，由调用者释放
+    char *oldVal = (char *)get(cache, 4999);
+    char *longVal = newString(4000);
+    put(cache, 4999, longVal);
+    free(oldVal);
+    hashMapCacheStats(cache, &stats);
+    ok = ok && get(cache, 4999) == longVal && stats.bytes <= config.cacheMaxBytes;
+    removeItem(cache, 4999);
+    size_t afterRemove = stats.bytes - 4001 - perNode;
+    hashMapCacheStats(cache, &stats);
+    ok = ok && stats.bytes == afterRemove;
+
+    // 单个值超过上限时只保留它自己，桶数组随之缩小，之后的淘汰不会扫描大量空桶
+    char *huge = newString(100000);
+    put(cache, -1, huge);
+    hashMapCacheStats(cache, &stats);
+    HashMapStats mapStats;
+    hashMapStats(cache, &mapStats);
+    ok = ok && size(cache) == 1 && get(cache, -1) == huge && mapStats.capacity <= HASH_TABLE_CACHE_MIN_CAPACITY;
+    printf("写入超过上限的值后键值对数量: %zu, 占用: %zu 字节, 桶数量: %zu\n",
+           size(cache), stats.bytes, mapStats.capacity);
+
+    delHashMapChaining(cache);
+    return ok;
+}
+
+// 命中、未命中计数与内联值
+static bool testCounters(void) {
+    printf("\n=== 测试3: 命中计数与内联值 ===\n");
+    HashMapChainingConfig config = defaultHashMapConfig(16, NULL);
+    config.valSize = sizeof(long);
+    config.cacheMaxEntries = 100;
+    HashMapChaining *cache = newHashMapChainingWithConfig(&config);
+    if (cache == NULL) {
+        return false;
+    }
+
+    for (int key = 0; key < 200; key++) {
+        long value = key;
+        put(cache, key, &value);
+    }
+    hashMapCacheStatsReset(cache);
+
+    int keys[200];
+    void *vals[200];
+    for (int i = 0; i < 200; i++) {
+        keys[i] = i;
+    }
+    size_t found = getBatch(cache, keys, 200, vals);
+    for (int key = 0; key < 200; key++) {
+        get(cache, key);
+    }
+
+    HashCacheStats stats;
+    hashMapCacheStats(cache, &stats);
+    bool ok = found == 100 && stats.hits == 200 && stats.misses == 200 && stats.evictions == 0 && size(cache) == 100;
+    printf("批量找到 %zu 个, 命中 %zu 次, 未命中 %zu 次\n", found, stats.hits, stats.misses);
+    hashMapStatsPrint(cache);
+
+    delHashMapChaining(cache);
+    return ok;
+}
+
+// 初始桶数量远大于数量上限时按上限限制桶数量，删除大部分键后自动缩容
+static bool testBucketBound(void) {
+    printf("\n=== 测试4: 桶数量与负载因子下界 ===\n");
+    HashMapChainingConfig config = defaultHashMapConfig((size_t)1 << 20, freeVal);
+    config.pow2Capacity = true;
+    config.cacheMaxEntries = CACHE_ENTRIES;
+    HashMapChaining *cache = newHashMapChainingWithConfig(&config);
+    if (cache == NULL) {
+        return false;
+    }
+
+    HashMapStats stats;
+    hashMapStats(cache, &stats);
+    size_t initial = stats.capacity;
+    for (int key = 0; key < 5000; key++) {
+        put(cache, key, newInt(key));
+    }
+    hashMapStats(cache, &stats);
+    bool ok = initial <= 2048 && stats.capacity <= 2048 && size(cache) == CACHE_ENTRIES;
+    size_t full = stats.capacity;
+
+    for (int key = 0; key < 5000 && size(cache) > 10; key++) {
+        removeItem(cache, key);
+    }
+    put(cache, -1, newInt(-1));
+    hashMapStats(cache, &stats);
+    ok = ok && size(cache) == 11 && stats.loadFactor >= (float)(HASH_TABLE_LOAD_FACTOR / HASH_TABLE_SHRINK_DIVISOR) / 2;
+    printf("初始桶数量: %zu, 写满后: %zu, 删除后: %zu (键值对 %zu)\n", initial, full, stats.capacity, size(cache));
+
+    delHashMapChaining(cache);
+    return ok;
+}
+
+// 分片哈希表的缓存上限平均分配到各分片
+static bool testSharded(void) {
+    printf("\n=== 测试5: 分片缓存 ===\n");
+    HashMapChainingConfig config = defaultHashMapConfig(64, freeVal);
+    config.cacheMaxEntries = 4096;
+    HashMapSharded *cache = newHashMapSharded(16, &config);
+    if (cache == NULL) {
+        return false;
+    }
+    for (int key = 0; key < 50000; key++) {
+        shardedPut(cache, key, newInt(key));
+    }
+    int *last = (int *)shardedGet(cache, 49999);
+    bool ok = shardedSize(cache) <= 4096 && last != NULL && *last == 49999;
+    printf("键值对数量: %zu\n", shardedSize(cache));
+    delHashMapSharded(cache);
+    return ok;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    bool ok = testEntryLimit();
+    ok = testByteLimit() && ok;
+    ok = testCounters() && ok;
+    ok = testBucketBound() && ok;
+    ok = testSharded() && ok;
+    printf("\n%s\n", ok ? "所有测试通过" : "测试失败");
+
+    // 报告内存使用情况
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "hash_map_cuckoo.h"
+#include "utility.h"
+
+#define LOAD_TEST_SLOTS 65536
+
+// 释放整数指针的回调函数
+void freeIntPtr(void *ptr) {
+    free(ptr);
+}
+
+// 创建整数指针
+int *createIntPtr(int value) {
+    int *ptr = (int *)malloc(sizeof(int));
+    if (ptr != NULL) {
+        *ptr = value;
+    }
+    return ptr;
+}
+
+// 基本操作、扩容、遍历中删除
+static int testBasic(void) {
+    HashMapCuckoo *hashMap = newHashMapCuckoo(8, freeIntPtr);
+    if (hashMap == NULL) {
+        printf("创建哈希表失败\n");
+        return 1;
+    }
+
+    // 插入足够多的键以触发多次扩容，包含负数键
+    printf("添加键值对到哈希表...\n");
+    for (int i = -500; i < 1500; i++) {
+        cuckooPut(hashMap, i, createIntPtr(i * 10));
+    }
+    printf("键值对数量: %zu, 槽位数量: %zu, 暂存区: %zu\n",
+           cuckooSize(hashMap), cuckooCapacity(hashMap), cuckooStashSize(hashMap));
+
+    for (int i = -500; i < 1500; i++) {
+        int *value = (int *)cuckooGet(hashMap, i);
+        if (value == NULL || *value != i * 10) {
+            printf("查找键 %d 失败\n", i);
+            delHashMapCuckoo(hashMap);
+            return 1;
+        }
+    }
+    printf("查找键 %d: %s\n", 2000, cuckooGet(hashMap, 2000) ? "找到" : "未找到");
+
+    // 更新已存在的键
+    int *old = (int *)cuckooGet(hashMap, 7);
+    cuckooPut(hashMap, 7, createIntPtr(-7));
+    free(old);
+
+    // 删除所有偶数键
+    for (int i = -500; i < 1500; i += 2) {
+        cuckooRemoveItem(hashMap, i);
+    }
+    for (int i = -499; i < 1500; i += 2) {
+        if (cuckooGet(hashMap, i) == NULL || cuckooGet(hashMap, i - 1) != NULL) {
+            printf("删除后查找键 %d 错误\n", i);
+            delHashMapCuckoo(hashMap);
+            return 1;
+        }
+    }
+    printf("删除偶数键后数量: %zu\n", cuckooSize(hashMap));
+
+    // 遍历并在遍历中删除小于0的键，每个键恰好访问一次
+    size_t visited = 0;
+    long long keySum = 0;
+    HashMapCuckooIterator iterator = cuckooInitIterator(hashMap);
+    while (cuckooHasNext(&iterator)) {
+        int key = cuckooGetKey(&iterator);
+        int *value = (int *)cuckooGetValue(&iterator);
+        if (key % 2 == 0 || *value != (key == 7 ? -7 : key * 10)) {
+            printf("迭代结果错误: 键 %d\n", key);
+            delHashMapCuckoo(hashMap);
+            return 1;
+        }
+        visited++;
+        keySum += key;
+        if (key < 0) {
+            cuckooRemoveCurrent(&iterator);
+        } else {
+            cuckooNext(&iterator);
+        }
+    }
+    // 奇数键 -499 ~ 1499 之和
+    bool ok = visited == 1000 && keySum == 500000 && cuckooSize(hashMap) == 750;
+    printf("迭代访问 %zu 个元素, 删除负数键后数量: %zu\n", visited, cuckooSize(hashMap));
+
+    delHashMapCuckoo(hashMap);
+    return ok ? 0 : 1;
+}
+
+// 扩容前能达到的负载因子，以及接近满载时反复删除插入后所有键仍然可以找到
+static int testHighLoad(void) {
+    static int value = 1;
+    HashMapCuckoo *hashMap = newHashMapCuckoo(LOAD_TEST_SLOTS, NULL);
+    if (hashMap == NULL) {
+        return 1;
+    }
+    int n = 0;
+    while (cuckooCapacity(hashMap) == LOAD_TEST_SLOTS) {
+        cuckooPut(hashMap, n * 7919, &value);
+        n++;
+    }
+    // 最后一个键触发了扩容
+    double load = (double)(n - 1) / LOAD_TEST_SLOTS;
+    printf("扩容前负载因子: %.3f, 扩容后槽位数量: %zu\n", load, cuckooCapacity(hashMap));
+    bool ok = load > 0.9;
+
+    // 新表中填到 0.95，反复删除和插入不同的键
+    HashMapCuckoo *full = newHashMapCuckoo(LOAD_TEST_SLOTS, NULL);
+    if (full == NULL) {
+        delHashMapCuckoo(hashMap);
+        return 1;
+    }
+    int keys = LOAD_TEST_SLOTS / 100 * 95;
+    for (int i = 0; i < keys; i++) {
+        cuckooPut(full, i * 7919, &value);
+    }
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < keys; i += 2) {
+            cuckooRemoveItem(full, i * 7919 + round);
+            cuckooPut(full, i * 7919 + round + 1, &value);
+        }
+    }
+    for (int i = 0; i < keys && ok; i++) {
+        int key = i % 2 == 0 ? i * 7919 + 4 : i * 7919;
+        if (cuckooGet(full, key) != &value) {
+            printf("查找键 %d 失败\n", key);
+            ok = false;
+        }
+    }
+    printf("负载 %.3f 下删除插入 4 轮后: 数量 %zu, 槽位数量 %zu, 暂存区 %zu\n",
+           (double)cuckooSize(full) / (double)cuckooCapacity(full), cuckooSize(full),
+           cuckooCapacity(full), cuckooStashSize(full));
+    ok = ok && cuckooSize(full) == (size_t)keys;
+
+    delHashMapCuckoo(hashMap);
+    delHashMapCuckoo(full);
+    return ok ? 0 : 1;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    int failed = testBasic() || testHighLoad();
+    printf("%s\n", failed ? "测试失败" : "测试通过");
+
+    // 内存检测报告
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return failed;
+}
@@ -0,0 +1,215 @@
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "epoch.h"
+#include "utility.h"
+
+#define EPOCH_LIMBO_LISTS 3  // 按退休纪元对 3 取模分组，纪元前进两次后释放
+
+/* 读者记录：状态字独占缓存行，读者更新状态时不会干扰其他读者 */
+struct EpochRecord {
+    _Alignas(EPOCH_CACHE_LINE) _Atomic uint64_t state; // 0 表示不在临界区，否则为 (纪元 << 1) | 1
+    size_t depth;                   // 临界区嵌套深度，只由所属线程访问
+    atomic_bool inUse;              // 是否已被某个线程注册
+    struct EpochRecord *next;       // 读者记录链表，发布后不再修改
+    EpochDomain *domain;            // 所属回收域
+    void *raw;                      // 原始分配地址
+};
+
+/* 待回收对象 */
+typedef struct EpochGarbage {
+    struct EpochGarbage *next;
+    void *ptr;
+    void (*freeFn)(void*);
+} EpochGarbage;
+
+/* 回收域 */
+struct EpochDomain {
+    _Atomic uint64_t epoch;                      // 全局纪元
+    _Atomic(EpochRecord *) records;              // 读者记录链表头
+    pthread_mutex_t lock;                        // 保护待回收链表
+    EpochGarbage *limbo[EPOCH_LIMBO_LISTS];      // 按退休纪元分组的待回收对象
+    size_t limboCount[EPOCH_LIMBO_LISTS];        // 每组的对象数量
+    _Atomic size_t pending;                      // 待回收对象总数
+};
+
+/* 释放一条待回收链表，返回释放的对象数量 */
+static size_t freeGarbage(EpochGarbage *garbage) {
+    size_t count = 0;
+    while (garbage != NULL) {
+        EpochGarbage *next = garbage->next;
+        garbage->freeFn(garbage->ptr);
+        free(garbage);
+        garbage = next;
+        count++;
+    }
+    return count;
+}
+
+/* 创建回收域 */
+EpochDomain *newEpochDomain(void) {
+    EpochDomain *domain = (EpochDomain *)malloc(sizeof(EpochDomain));
+    if (domain == NULL) {
+        return NULL;
+    }
+    if (pthread_mutex_init(&domain->lock, NULL) != 0) {
+        free(domain);
+        return NULL;
+    }
+    atomic_init(&domain->epoch, 0);
+    atomic_init(&domain->records, NULL);
+    atomic_init(&domain->pending, 0);
+    for (size_t i = 0; i < EPOCH_LIMBO_LISTS; i++) {
+        domain->limbo[i] = NULL;
+        domain->limboCount[i] = 0;
+    }
+    return domain;
+}
+
+/* 删除回收域 */
+void delEpochDomain(EpochDomain *domain) {
+    if (domain == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < EPOCH_LIMBO_LISTS; i++) {
+        freeGarbage(domain->limbo[i]);
+    }
+    EpochRecord *record = atomic_load(&domain->records);
+    while (record != NULL) {
+        EpochRecord *next = record->next;
+        free(record->raw);
+        record = next;
+    }
+    pthread_mutex_destroy(&domain->lock);
+    free(domain);
+}
+
+/* 注册读者 */
+EpochRecord *epochRegister(EpochDomain *domain) {
+    if (domain == NULL) {
+        return NULL;
+    }
+
+    // 优先复用已经注销的记录
+    for (EpochRecord *record = atomic_load(&domain->records); record != NULL; record = record->next) {
+        bool expected = false;
+        if (!atomic_load_explicit(&record->inUse, memory_order_relaxed) &&
+            atomic_compare_exchange_strong(&record->inUse, &expected, true)) {
+            record->depth = 0;
+            return record;
+        }
+    }
+
+    char *raw = (char *)malloc(sizeof(EpochRecord) + EPOCH_CACHE_LINE - 1);
+    if (raw == NULL) {
+        return NULL;
+    }
+    uintptr_t aligned = ((uintptr_t)raw + EPOCH_CACHE_LINE - 1) & ~(uintptr_t)(EPOCH_CACHE_LINE - 1);
+    EpochRecord *record = (EpochRecord *)(void *)(raw + (aligned - (uintptr_t)raw));
+    atomic_init(&record->state, 0);
+    atomic_init(&record->inUse, true);
+    record->depth = 0;
+    record->domain = domain;
+    record->raw = raw;
+
+    // 无锁地插入到链表头部
+    EpochRecord *head = atomic_load(&domain->records);
+    do {
+        record->next = head;
+    } while (!atomic_compare_exchange_weak(&domain->records, &head, record));
+    return record;
+}
+
+/* 注销读者 */
+void epochUnregister(EpochRecord *record) {
+    if (record == NULL) {
+        return;
+    }
+    record->depth = 0;
+    atomic_store_explicit(&record->state, 0, memory_order_release);
+    atomic_store_explicit(&record->inUse, false, memory_order_release);
+}
+
+/* 进入读临界区 */
+void epochEnter(EpochRecord *record) {
+    if (record->depth++ > 0) {
+        return;
+    }
+    uint64_t epoch = atomic_load_explicit(&record->domain->epoch, memory_order_relaxed);
+    atomic_store_explicit(&record->state, (epoch << 1) | 1, memory_order_relaxed);
+    // 保证状态对回收者可见之后，才读取任何共享指针
+    atomic_thread_fence(memory_order_seq_cst);
+}
+
+/* 退出读临界区 */
+void epochExit(EpochRecord *record) {
+    if (record->depth == 0 || --record->depth > 0) {
+        return;
+    }
+    atomic_store_explicit(&record->state, 0, memory_order_release);
+}
+
+/* 延迟释放对象 */
+void epochRetire(EpochDomain *domain, void *ptr, void (*freeFn)(void*)) {
+    if (epochRetireDeferred(domain, ptr, freeFn)) {
+        epochReclaim(domain);
+    }
+}
+
+/* 延迟释放对象，回收留给调用者 */
+bool epochRetireDeferred(EpochDomain *domain, void *ptr, void (*freeFn)(void*)) {
+    if (domain == NULL || ptr == NULL || freeFn == NULL) {
+        return false;
+    }
+    EpochGarbage *garbage = (EpochGarbage *)malloc(sizeof(EpochGarbage));
+    if (garbage == NULL) {
+        return false; // 内存不足时宁可泄漏，也不能释放读者可能仍在访问的对象
+    }
+    garbage->ptr = ptr;
+    garbage->freeFn = freeFn;
+
+    pthread_mutex_lock(&domain->lock);
+    size_t slot = (size_t)(atomic_load(&domain->epoch) % EPOCH_LIMBO_LISTS);
+    garbage->next = domain->limbo[slot];
+    domain->limbo[slot] = garbage;
+    domain->limboCount[slot]++;
+    size_t pending = atomic_fetch_add(&domain->pending, 1) + 1;
+    pthread_mutex_unlock(&domain->lock);
+    return pending >= EPOCH_RECLAIM_THRESHOLD;
+}
+
+/* 尝试推进全局纪元并释放已经安全的对象 */
+size_t epochReclaim(EpochDomain *domain) {
+    if (domain == NULL) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&domain->lock);
+    uint64_t epoch = atomic_load(&domain->epoch);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // 只有所有活跃读者都已观察到当前纪元时才能前进
+    for (EpochRecord *record = atomic_load(&domain->records); record != NULL; record = record->next) {
+        uint64_t state = atomic_load(&record->state);
+        if ((state & 1) && (state >> 1) != epoch) {
+            pthread_mutex_unlock(&domain->lock);
+            return 0;
+        }
+    }
+    atomic_store(&domain->epoch, epoch + 1);
+
+    // 纪元 epoch - 1 退休的对象已经不可能被任何读者持有
+    size_t slot = (size_t)((epoch + 2) % EPOCH_LIMBO_LISTS);
+    EpochGarbage *garbage = domain->limbo[slot];
+    atomic_fetch_sub(&domain->pending, domain->limboCount[slot]);
+    domain->limbo[slot] = NULL;
+    domain->limboCount[slot] = 0;
+    pthread_mutex_unlock(&domain->lock);
+
+    return freeGarbage(garbage);
+}
+
+/* 获取待回收对象数量 */
+size_t epochPending(EpochDomain *domain) {
+    return domain == NULL ? 0 : atomic_load(&domain->pending);
+}
@@ -0,0 +1,121 @@
+#ifndef EPOCH_H
+#define EPOCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define EPOCH_CACHE_LINE 64        // 每个读者记录独占的缓存行大小
+#define EPOCH_RECLAIM_THRESHOLD 64 // 待回收对象达到该数量时尝试推进纪元
+
+/*
+ * 基于纪元的延迟回收（epoch-based reclamation）
+ *
+ * 读者在访问共享数据前进入临界区（epochEnter），记录当前的全局纪元；写者把已经从数据结构中
+ * 摘除的对象交给 epochRetire，而不是立即释放。只有当所有活跃读者都已观察到较新的纪元时，
+ * 全局纪元才会前进；对象在退休后纪元前进两次即可安全释放，此时不可能还有读者持有它的指针。
+ *
+ * 读者路径只有一次原子存储和一次内存屏障，不获取任何锁。
+ */
+
+/* 回收域：全局纪元、读者记录和待回收对象 */
+typedef struct EpochDomain EpochDomain;
+
+/* 读者记录，每个读者线程注册一个，只能由注册它的线程使用 */
+typedef struct EpochRecord EpochRecord;
+
+/**
+ * @brief 创建回收域
+ *
+ * @return 成功时返回回收域指针，失败时返回 NULL。
+ */
+EpochDomain *newEpochDomain(void);
+
+/**
+ * @brief 删除回收域
+ *
+ * 立即释放所有尚未回收的对象和读者记录。调用时不能有读者处于临界区内。
+ *
+ * @param domain 回收域指针
+ */
+void delEpochDomain(EpochDomain *domain);
+
+/**
+ * @brief 注册读者
+ *
+ * 优先复用已经注销的读者记录，否则分配新记录。可以被多个线程同时调用。
+ *
+ * @param domain 回收域指针
+ * @return 成功时返回读者记录，失败时返回 NULL。
+ */
+EpochRecord *epochRegister(EpochDomain *domain);
+
+/**
+ * @brief 注销读者
+ *
+ * 注销后记录可被其他线程复用，调用者不能再使用该记录。
+ *
+ * @param record 读者记录
+ */
+void epochUnregister(EpochRecord *record);
+
+/**
+ * @brief 进入读临界区
+ *
+ * 临界区内读到的共享指针在 epochExit 之前都不会被释放。支持嵌套调用。
+ *
+ * @param record 当前线程的读者记录
+ */
+void epochEnter(EpochRecord *record);
+
+/**
+ * @brief 退出读临界区
+ *
+ * @param record 当前线程的读者记录
+ */
+void epochExit(EpochRecord *record);
+
+/**
+ * @brief 延迟释放对象
+ *
+ * ptr 必须已经无法从共享数据结构中访问到。对象会在所有可能持有它的读者退出临界区后
+ * 由 freeFn 释放。可以被多个写者同时调用。
+ *
+ * @param domain 回收域指针
+ * @param ptr 要释放的对象
+ * @param freeFn 释放函数
+ */
+void epochRetire(EpochDomain *domain, void *ptr, void (*freeFn)(void*));
+
+/**
+ * @brief 延迟释放对象，但不在本次调用中回收
+ *
+ * 同 epochRetire，只是待回收对象达到 EPOCH_RECLAIM_THRESHOLD 时不自动调用 epochReclaim，
+ * 而是返回 true，由调用者在释放自己持有的锁之后调用 epochReclaim，
+ * 避免 freeFn 在调用者的锁内执行。
+ *
+ * @param domain 回收域指针
+ * @param ptr 要释放的对象
+ * @param freeFn 释放函数
+ * @return 待回收对象达到阈值、需要调用 epochReclaim 时返回 true
+ */
+bool epochRetireDeferred(EpochDomain *domain, void *ptr, void (*freeFn)(void*));
+
+/**
+ * @brief 尝试推进全局纪元并释放已经安全的对象
+ *
+ * 有读者停留在旧纪元时不会推进，此时直接返回。epochRetire 在待回收对象较多时会自动调用。
+ *
+ * @param domain 回收域指针
+ * @return 返回本次释放的对象数量
+ */
+size_t epochReclaim(EpochDomain *domain);
+
+/**
+ * @brief 获取尚未释放的退休对象数量
+ *
+ * @param domain 回收域指针
+ * @return 返回待回收对象数量
+ */
+size_t epochPending(EpochDomain *domain);
+
+#endif // EPOCH_H
@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "hash_map_epoch.h"
+#include "utility.h"
+
+#define TEST_READERS 4
+#define TEST_KEYS 20000
+
+static atomic_bool writerDone;
+
+typedef struct {
+    HashMapEpoch *hashMap;
+    HashMapEpochReader *reader;
+    long lookups;   // 查找次数
+    long hits;      // 命中次数
+    long errors;    // 读到错误值的次数
+} Reader;
+
+// 释放整数指针的回调函数
+void freeIntPtr(void *ptr) {
+    free(ptr);
+}
+
+// 创建整数指针
+int *createIntPtr(int value) {
+    int *ptr = (int *)malloc(sizeof(int));
+    if (ptr != NULL) {
+        *ptr = value;
+    }
+    return ptr;
+}
+
+// 读者线程：在写者插入、更新、删除和扩容的同时不断查找，并在临界区内解引用值
+static void *runReader(void *arg) {
+    Reader *reader = (Reader *)arg;
+    unsigned seed = 12345;
+    while (!atomic_load(&writerDone)) {
+        seed = seed * 1103515245u + 12345u;
+        int key = (int)((seed >> 8) % TEST_KEYS);
+
+        epochMapReadBegin(reader->reader);
+        int *value = (int *)epochMapGet(reader->hashMap, reader->reader, key);
+        if (value != NULL) {
+            reader->hits++;
+            if (*value / 10 != key) {
+                reader->errors++;
+            }
+        }
+        epochMapReadEnd(reader->reader);
+        reader->lookups++;
+    }
+    return NULL;
+}
+
+// 写者线程：插入全部键（期间多次扩容），更新一半，删除奇数键
+static void *runWriter(void *arg) {
+    HashMapEpoch *hashMap = (HashMapEpoch *)arg;
+    for (int key = 0; key < TEST_KEYS; key++) {
+        epochMapPut(hashMap, key, createIntPtr(key * 10));
+    }
+    for (int key = 0; key < TEST_KEYS; key += 2) {
+        epochMapPut(hashMap, key, createIntPtr(key * 10 + 1));
+    }
+    for (int key = 1; key < TEST_KEYS; key += 2) {
+        epochMapRemoveItem(hashMap, key);
+    }
+    atomic_store(&writerDone, true);
+    return NULL;
+}
+
+// 删除条件：键是 4 的倍数
+static bool isMultipleOf4(int key, void *val, void *ctx) {
+    (void)val;
+    (void)ctx;
+    return key % 4 == 0;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    HashMapEpoch *hashMap = newHashMapEpoch(8, freeIntPtr);
+    if (hashMap == NULL) {
+        printf("创建哈希表失败\n");
+        return 1;
+    }
+
+    // 读者句柄在主线程中注册，之后每个句柄只由一个线程使用
+    Reader readers[TEST_READERS];
+    pthread_t tids[TEST_READERS];
+    atomic_init(&writerDone, false);
+    for (int i = 0; i < TEST_READERS; i++) {
+        readers[i].hashMap = hashMap;
+        readers[i].reader = epochMapRegisterReader(hashMap);
+        readers[i].lookups = 0;
+        readers[i].hits = 0;
+        readers[i].errors = 0;
+        if (readers[i].reader == NULL) {
+            printf("注册读者失败\n");
+            delHashMapEpoch(hashMap);
+            return 1;
+        }
+    }
+    for (int i = 0; i < TEST_READERS; i++) {
+        pthread_create(&tids[i], NULL, runReader, &readers[i]);
+    }
+    pthread_t writer;
+    pthread_create(&writer, NULL, runWriter, hashMap);
+
+    pthread_join(writer, NULL);
+    long lookups = 0, hits = 0, errors = 0;
+    for (int i = 0; i < TEST_READERS; i++) {
+        pthread_join(tids[i], NULL);
+        lookups += readers[i].lookups;
+        hits += readers[i].hits;
+        errors += readers[i].errors;
+        epochMapUnregisterReader(readers[i].reader);
+    }
+    printf("读者查找 %ld 次，命中 %ld 次，错误 %ld 次\n", lookups, hits, errors);
+    printf("并发写入后键值对数量: %zu\n", epochMapSize(hashMap));
+
+    size_t removed = epochMapRemoveIf(hashMap, isMultipleOf4, NULL);
+    printf("删除 4 的倍数 %zu 个，剩余 %zu 个\n", removed, epochMapSize(hashMap));
+
+    if (errors != 0 || removed != TEST_KEYS / 4 || epochMapSize(hashMap) != TEST_KEYS / 4) {
+        printf("读无锁哈希表结果错误\n");
+        delHashMapEpoch(hashMap);
+        return 1;
+    }
+
+    delHashMapEpoch(hashMap);
+
+    // 报告内存使用情况
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return 0;
+}
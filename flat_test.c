@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "hash_map_flat.h"
+#include "utility.h"
+
+// 释放整数指针的回调函数
+void freeIntPtr(void *ptr) {
+    free(ptr);
+}
+
+// 创建整数指针
+int *createIntPtr(int value) {
+    int *ptr = (int *)malloc(sizeof(int));
+    if (ptr != NULL) {
+        *ptr = value;
+    }
+    return ptr;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    // 创建开放寻址哈希表
+    HashMapFlat *hashMap = newHashMapFlat(16, freeIntPtr);
+    if (hashMap == NULL) {
+        printf("创建哈希表失败\n");
+        return 1;
+    }
+
+    // 插入足够多的键以触发多次扩容，包含负数键
+    printf("添加键值对到哈希表...\n");
+    for (int i = -500; i < 1500; i++) {
+        int *value = createIntPtr(i * 10);
+        if (value == NULL) {
+            printf("内存分配失败\n");
+            delHashMapFlat(hashMap);
+            return 1;
+        }
+        flatPut(hashMap, i, value);
+    }
+    printf("键值对数量: %zu, 槽位数量: %zu\n", flatSize(hashMap), flatCapacity(hashMap));
+
+    // 验证查找结果
+    for (int i = -500; i < 1500; i++) {
+        int *value = (int *)flatGet(hashMap, i);
+        if (value == NULL || *value != i * 10) {
+            printf("查找键 %d 失败\n", i);
+            delHashMapFlat(hashMap);
+            return 1;
+        }
+    }
+    printf("查找键 %d: %s\n", 2000, flatGet(hashMap, 2000) ? "找到" : "未找到");
+
+    // 删除所有偶数键
+    for (int i = -500; i < 1500; i += 2) {
+        flatRemoveItem(hashMap, i);
+    }
+    printf("删除偶数键后数量: %zu\n", flatSize(hashMap));
+
+    // 使用迭代器遍历并在遍历中删除小于0的键
+    size_t visited = 0;
+    HashMapFlatIterator iterator = flatInitIterator(hashMap);
+    while (flatHasNext(&iterator)) {
+        int key = flatGetKey(&iterator);
+        int *value = (int *)flatGetValue(&iterator);
+        if (key % 2 == 0 || *value != key * 10) {
+            printf("迭代结果错误: 键 %d\n", key);
+            delHashMapFlat(hashMap);
+            return 1;
+        }
+        visited++;
+        if (key < 0) {
+            flatRemoveCurrent(&iterator);
+        } else {
+            flatNext(&iterator);
+        }
+    }
+    printf("迭代访问 %zu 个元素, 删除负数键后数量: %zu\n", visited, flatSize(hashMap));
+
+    // 墓碑槽位可以被重新使用
+    for (int i = -500; i < 0; i++) {
+        flatPut(hashMap, i, createIntPtr(i * 10));
+    }
+    printf("重新插入负数键后数量: %zu, 槽位数量: %zu\n", flatSize(hashMap), flatCapacity(hashMap));
+
+    // 释放哈希表
+    delHashMapFlat(hashMap);
+
+    // 内存检测报告
+    MEM_REPORT();
+    MEM_CLEANUP();
+
+    return 0;
+}
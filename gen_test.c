@@ -0,0 +1,162 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash_map_gen.h"
+#include "utility.h"
+
+#define TEST_KEYS 5000
+
+/* 值为结构体的字符串键表，验证自定义哈希和相等函数 */
+typedef struct {
+    int count;
+    double weight;
+} WordInfo;
+
+static inline uint64_t hashStr(const char *key) {
+    return hashBytes(key, strlen(key), HASH_WYP1);
+}
+
+#define STR_EQ(a, b) (strcmp((a), (b)) == 0)
+
+HASHMAP_DECLARE(IntMap, int, int, hashMurmur, HASHMAP_GEN_EQ)
+HASHMAP_DECLARE(U64Map, uint64_t, uint64_t, hashMurmur64, HASHMAP_GEN_EQ)
+HASHMAP_DECLARE(WordMap, const char *, WordInfo, hashStr, STR_EQ)
+
+// 64 位键，高 32 位互不相同，用于验证不会截断为 int
+static uint64_t wideKeyAt(uint64_t i) {
+    return (i << 32) | 0x5A5Au;
+}
+
+static int testIntMap(void) {
+    IntMap map;
+    if (!IntMap_init(&map, 4)) {
+        printf("创建哈希表失败\n");
+        return 1;
+    }
+
+    // 插入足够多的键以触发多次扩容，键包含负数
+    for (int i = 0; i < TEST_KEYS; i++) {
+        IntMap_put(&map, i - TEST_KEYS / 2, i);
+    }
+    // 覆盖已有键
+    IntMap_put(&map, 0, -1);
+    printf("IntMap 键值对数量: %zu, 容量: %zu\n", IntMap_size(&map), IntMap_end(&map));
+
+    for (int i = 0; i < TEST_KEYS; i++) {
+        int *value = IntMap_get(&map, i - TEST_KEYS / 2);
+        int expected = i - TEST_KEYS / 2 == 0 ? -1 : i;
+        if (value == NULL || *value != expected) {
+            printf("查找错误: 键 %d\n", i - TEST_KEYS / 2);
+            IntMap_destroy(&map);
+            return 1;
+        }
+    }
+    if (IntMap_get(&map, TEST_KEYS) != NULL) {
+        printf("查找不存在的键应返回NULL\n");
+        IntMap_destroy(&map);
+        return 1;
+    }
+
+    // 删除偶数键，向后移位后奇数键必须仍然可以找到
+    for (int i = 0; i < TEST_KEYS; i += 2) {
+        if (!IntMap_remove(&map, i - TEST_KEYS / 2)) {
+            printf("删除失败: 键 %d\n", i - TEST_KEYS / 2);
+            IntMap_destroy(&map);
+            return 1;
+        }
+    }
+    IntMap_remove(&map, TEST_KEYS);
+    for (int i = 0; i < TEST_KEYS; i++) {
+        bool found = IntMap_get(&map, i - TEST_KEYS / 2) != NULL;
+        if (found != (i % 2 == 1)) {
+            printf("删除后查找错误: 键 %d\n", i - TEST_KEYS / 2);
+            IntMap_destroy(&map);
+            return 1;
+        }
+    }
+
+    // 遍历剩余的键
+    size_t visited = 0;
+    long long sum = 0;
+    for (size_t i = IntMap_begin(&map); i < IntMap_end(&map); i = IntMap_next(&map, i)) {
+        sum += *IntMap_val(&map, i);
+        visited++;
+    }
+    long long expectedSum = (long long)(TEST_KEYS / 2) * (TEST_KEYS / 2);
+    printf("IntMap 删除后数量: %zu, 遍历: %zu, 值之和: %lld\n", IntMap_size(&map), visited, sum);
+    IntMap_destroy(&map);
+    return visited == TEST_KEYS / 2 && sum == expectedSum ? 0 : 1;
+}
+
+static int testU64Map(void) {
+    U64Map map;
+    if (!U64Map_init(&map, TEST_KEYS)) {
+        printf("创建哈希表失败\n");
+        return 1;
+    }
+    size_t capacity = U64Map_end(&map);
+    for (uint64_t i = 0; i < TEST_KEYS; i++) {
+        U64Map_put(&map, wideKeyAt(i), i);
+    }
+    // 按预计数量初始化后不应扩容
+    if (U64Map_end(&map) != capacity) {
+        printf("预分配后仍然扩容: %zu -> %zu\n", capacity, U64Map_end(&map));
+        U64Map_destroy(&map);
+        return 1;
+    }
+    for (uint64_t i = 0; i < TEST_KEYS; i++) {
+        uint64_t *value = U64Map_get(&map, wideKeyAt(i));
+        if (value == NULL || *value != i) {
+            printf("64位键查找错误: %llu\n", (unsigned long long)i);
+            U64Map_destroy(&map);
+            return 1;
+        }
+    }
+    // 低 32 位相同的键互不干扰
+    if (U64Map_get(&map, 0x5A5Au + ((uint64_t)TEST_KEYS << 32)) != NULL) {
+        printf("64位键被截断\n");
+        U64Map_destroy(&map);
+        return 1;
+    }
+    printf("U64Map 键值对数量: %zu, 容量: %zu\n", U64Map_size(&map), U64Map_end(&map));
+    U64Map_destroy(&map);
+    return 0;
+}
+
+static int testWordMap(void) {
+    const char *text[] = {"hash", "map", "hash", "table", "map", "hash"};
+    WordMap map;
+    if (!WordMap_init(&map, 0)) {
+        printf("创建哈希表失败\n");
+        return 1;
+    }
+    for (size_t i = 0; i < sizeof(text) / sizeof(text[0]); i++) {
+        WordInfo *info = WordMap_get(&map, text[i]);
+        if (info == NULL) {
+            WordInfo fresh = {0, 0.0};
+            info = WordMap_put(&map, text[i], fresh);
+        }
+        info->count++;
+        info->weight += 0.5;
+    }
+    // 用不同地址的相同字符串查找
+    char key[] = "hash";
+    WordInfo *info = WordMap_get(&map, key);
+    int ok = info != NULL && info->count == 3 && WordMap_size(&map) == 3;
+    printf("WordMap 单词数量: %zu, hash 出现次数: %d\n", WordMap_size(&map), info != NULL ? info->count : 0);
+    WordMap_destroy(&map);
+    return ok ? 0 : 1;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    int failed = testIntMap() || testU64Map() || testWordMap();
+    printf("%s\n", failed ? "测试失败" : "测试通过");
+
+    // 输出内存统计并检查泄漏
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return failed;
+}
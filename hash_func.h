@@ -0,0 +1,204 @@
+#ifndef HASH_FUNC_H
+#define HASH_FUNC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * 整数键哈希函数
+ *
+ * 所有函数都返回 64 位哈希值，由调用者再用掩码或取模映射到桶。
+ * 负数键先按 32 位无符号数处理，避免符号扩展成巨大的数值。
+ */
+
+/* 哈希策略 */
+typedef enum {
+    HASH_KIND_IDENTITY = 0,   // 恒等映射，连续键分布均匀，但步长为容量倍数的键会全部冲突
+    HASH_KIND_FIBONACCI,      // 乘法（Fibonacci）散列，开销最小的混合方式
+    HASH_KIND_MURMUR,         // 带种子的 murmur3 fmix64，雪崩效果好
+    HASH_KIND_WYHASH,         // 带种子的 wyhash 风格散列，可抵御构造的冲突键
+    HASH_KIND_COUNT
+} HashKind;
+
+#define HASH_FIBONACCI_MULT 0x9E3779B97F4A7C15ULL
+#define HASH_WYP0 0xa0761d6478bd642fULL
+#define HASH_WYP1 0xe7037ed1a0b428dbULL
+
+/* 恒等映射 */
+static inline uint64_t hashIdentity(int key) {
+    return (uint64_t)(uint32_t)key;
+}
+
+/* 乘法散列，乘积高位混合最充分，按字节反转使高位落到低位以便用掩码取桶 */
+static inline uint64_t hashFibonacci(int key) {
+    uint64_t h = (uint64_t)(uint32_t)key * HASH_FIBONACCI_MULT;
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_bswap64(h);
+#else
+    uint64_t r = 0;
+    for (int i = 0; i < 8; i++) {
+        r = (r << 8) | ((h >> (8 * i)) & 0xFF);
+    }
+    return r;
+#endif
+}
+
+/* murmur3 的 64 位终结混合函数 */
+static inline uint64_t hashMurmur(int key) {
+    uint64_t h = (uint64_t)(uint32_t)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/* murmur3 的 64 位终结混合函数，用于 64 位键 */
+static inline uint64_t hashMurmur64(uint64_t key) {
+    uint64_t h = key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/*
+ * 带种子的 murmur3 混合：种子异或到输入上再做 fmix64
+ *
+ * fmix64 是双射，不同种子给出不同的置换，同一组键在掩码取桶后的冲突关系随种子改变；
+ * 种子为 0 时与 hashMurmur 相同。
+ */
+static inline uint64_t hashMurmurSeeded(int key, uint64_t seed) {
+    return hashMurmur64((uint64_t)(uint32_t)key ^ seed);
+}
+
+/* 64x64 位乘法，*a 和 *b 分别替换为 128 位乘积的低 64 位和高 64 位 */
+static inline void hashMum128(uint64_t *a, uint64_t *b) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 HashU128;
+    HashU128 r = (HashU128)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+/* 64x64 位乘法，返回 128 位乘积高低两半异或的结果 */
+static inline uint64_t hashMum(uint64_t a, uint64_t b) {
+    hashMum128(&a, &b);
+    return a ^ b;
+}
+
+/* 带种子的 wyhash 风格散列（针对 4 字节输入的简化版本） */
+static inline uint64_t hashWy(int key, uint64_t seed) {
+    uint64_t x = (uint64_t)(uint32_t)key;
+    seed ^= HASH_WYP0;
+    return hashMum(HASH_WYP1 ^ 4, hashMum(((x << 32) | x) ^ HASH_WYP1, x ^ seed));
+}
+
+/* 按小端序读取 8 字节 / 4 字节，允许未对齐地址 */
+static inline uint64_t hashRead64(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t hashRead32(const unsigned char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+/*
+ * 带种子的字节串散列（wyhash 风格）
+ *
+ * 16 字节以内的输入只做一次 128 位乘法，更长的输入每 16 字节做一次。
+ */
+static inline uint64_t hashBytes(const void *data, size_t len, uint64_t seed) {
+    const unsigned char *p = (const unsigned char *)data;
+    uint64_t a, b;
+
+    seed ^= hashMum(seed ^ HASH_WYP0, HASH_WYP1);
+    if (len <= 16) {
+        if (len >= 4) {
+            size_t mid = (len >> 3) << 2;
+            a = (hashRead32(p) << 32) | hashRead32(p + mid);
+            b = (hashRead32(p + len - 4) << 32) | hashRead32(p + len - 4 - mid);
+        } else if (len > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8) | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        while (i > 16) {
+            seed = hashMum(hashRead64(p) ^ HASH_WYP1, hashRead64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = hashRead64(p + i - 16);
+        b = hashRead64(p + i - 8);
+    }
+
+    a ^= HASH_WYP1;
+    b ^= seed;
+    hashMum128(&a, &b);
+    return hashMum(a ^ HASH_WYP0 ^ (uint64_t)len, b ^ HASH_WYP1);
+}
+
+/* 由时间和对象地址生成哈希种子，用于未指定种子的哈希表 */
+static inline uint64_t hashRandomSeed(const void *addr) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    uint64_t x = (uint64_t)ts.tv_nsec ^ ((uint64_t)ts.tv_sec << 32) ^ (uint64_t)(uintptr_t)addr;
+    // 经过两轮 murmur 混合，保证种子各位都与输入相关
+    x = hashMurmur((int)(uint32_t)x) ^ (x >> 32);
+    return hashMurmur((int)(uint32_t)(x >> 7)) ^ (x << 17) ^ HASH_WYP0;
+}
+
+/* 按策略计算哈希值，kind 为编译期常量时分支会被完全消除 */
+static inline uint64_t hashInt(HashKind kind, int key, uint64_t seed) {
+    switch (kind) {
+    case HASH_KIND_FIBONACCI:
+        return hashFibonacci(key);
+    case HASH_KIND_MURMUR:
+        return hashMurmurSeeded(key, seed);
+    case HASH_KIND_WYHASH:
+        return hashWy(key, seed);
+    case HASH_KIND_IDENTITY:
+    default:
+        return hashIdentity(key);
+    }
+}
+
+/* 哈希策略名称，用于输出 */
+static inline const char *hashKindName(HashKind kind) {
+    switch (kind) {
+    case HASH_KIND_IDENTITY:
+        return "identity";
+    case HASH_KIND_FIBONACCI:
+        return "fibonacci";
+    case HASH_KIND_MURMUR:
+        return "murmur";
+    case HASH_KIND_WYHASH:
+        return "wyhash";
+    default:
+        return "unknown";
+    }
+}
+
+#endif // HASH_FUNC_H
@@ -0,0 +1,343 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash_map_bytes.h"
+#include "hash_func.h"
+#include "node_pool.h"
+#include "utility.h"
+
+/*
+ * 链表节点
+ *
+ * 节点中保存完整的 64 位哈希值：查找时先比较哈希值再比较键内容，
+ * 扩容时直接使用保存的哈希值，不需要重新计算。
+ * 键长度不超过 HASH_MAP_BYTES_INLINE_KEY 时键内容直接存放在 keyData 中，
+ * 否则 keyData 的前 sizeof(void*) 字节保存单独分配的键拷贝的地址。
+ */
+typedef struct BytesNode {
+    struct BytesNode *next;
+    uint64_t hash;
+    void *val;
+    uint32_t keyLen;
+    unsigned char keyData[HASH_MAP_BYTES_INLINE_KEY];
+} BytesNode;
+
+/* 字节串键哈希表 */
+struct HashMapBytes {
+    size_t size;            // 键值对数量
+    size_t capacity;        // 桶数量，2 的幂
+    size_t growAt;          // 键值对数量超过该值时扩容
+    uint64_t seed;          // 哈希种子
+    BytesNode **buckets;    // 桶数组
+    void (*freeVal)(void*); // 释放val的回调函数，如果为NULL则不释放
+    NodePool nodePool;      // 节点内存池
+};
+
+/* 获取节点中键内容的地址 */
+static inline const unsigned char *nodeKey(const BytesNode *node) {
+    if (node->keyLen <= HASH_MAP_BYTES_INLINE_KEY) {
+        return node->keyData;
+    }
+    const unsigned char *heapKey;
+    memcpy(&heapKey, node->keyData, sizeof(heapKey));
+    return heapKey;
+}
+
+/* 判断节点是否与给定键相同，先比较哈希值和长度，最后才比较内容 */
+static inline bool nodeMatches(const BytesNode *node, uint64_t hash, const void *key, size_t keyLen) {
+    return node->hash == hash && node->keyLen == keyLen && memcmp(nodeKey(node), key, keyLen) == 0;
+}
+
+/* 释放节点的键拷贝和值，并将节点归还内存池 */
+static void freeNode(HashMapBytes *hashMap, BytesNode *node) {
+    if (hashMap->freeVal != NULL && node->val != NULL) {
+        hashMap->freeVal(node->val);
+    }
+    if (node->keyLen > HASH_MAP_BYTES_INLINE_KEY) {
+        free((void *)nodeKey(node));
+    }
+    nodePoolFree(&hashMap->nodePool, node);
+}
+
+static void setCapacity(HashMapBytes *hashMap, size_t capacity) {
+    hashMap->capacity = capacity;
+    hashMap->growAt = (size_t)((double)capacity * HASH_MAP_BYTES_LOAD_FACTOR);
+}
+
+/* 容量翻倍：按保存的哈希值中新增的那一位拆分每条链表 */
+static void extend(HashMapBytes *hashMap) {
+    size_t oldCapacity = hashMap->capacity;
+    BytesNode **newBuckets = (BytesNode **)calloc(oldCapacity * 2, sizeof(BytesNode *));
+    if (newBuckets == NULL) {
+        return; // 扩容失败时保持原容量
+    }
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+        BytesNode *lo = NULL, *hi = NULL;
+        BytesNode **loTail = &lo, **hiTail = &hi;
+        for (BytesNode *cur = hashMap->buckets[i]; cur; cur = cur->next) {
+            if (cur->hash & oldCapacity) {
+                *hiTail = cur;
+                hiTail = &cur->next;
+            } else {
+                *loTail = cur;
+                loTail = &cur->next;
+            }
+        }
+        *loTail = NULL;
+        *hiTail = NULL;
+        newBuckets[i] = lo;
+        newBuckets[i + oldCapacity] = hi;
+    }
+
+    free(hashMap->buckets);
+    hashMap->buckets = newBuckets;
+    setCapacity(hashMap, oldCapacity * 2);
+}
+
+/* 查找键所在节点的链接位置，未找到返回 NULL */
+static BytesNode **findLink(HashMapBytes *hashMap, uint64_t hash, const void *key, size_t keyLen) {
+    BytesNode **link = &hashMap->buckets[hash & (hashMap->capacity - 1)];
+    for (; *link; link = &(*link)->next) {
+        if (nodeMatches(*link, hash, key, keyLen)) {
+            return link;
+        }
+    }
+    return NULL;
+}
+
+/* 创建字节串键哈希表 */
+HashMapBytes *newHashMapBytes(size_t capacity, void (*freeVal)(void*)) {
+    if (capacity == 0) {
+        return NULL;
+    }
+    HashMapBytes *hashMap = (HashMapBytes *)malloc(sizeof(HashMapBytes));
+    if (hashMap == NULL) {
+        return NULL;
+    }
+
+    size_t buckets = HASH_MAP_BYTES_MIN_CAPACITY;
+    while (buckets < capacity) {
+        buckets *= 2;
+    }
+    hashMap->buckets = (BytesNode **)calloc(buckets, sizeof(BytesNode *));
+    if (hashMap->buckets == NULL) {
+        free(hashMap);
+        return NULL;
+    }
+
+    hashMap->size = 0;
+    hashMap->seed = hashRandomSeed(hashMap);
+    hashMap->freeVal = freeVal;
+    nodePoolInit(&hashMap->nodePool, sizeof(BytesNode));
+    setCapacity(hashMap, buckets);
+    return hashMap;
+}
+
+/* 删除字节串键哈希表 */
+void delHashMapBytes(HashMapBytes *hashMap) {
+    if (hashMap == NULL) {
+        return;
+    }
+
+    // 释放值和单独分配的键拷贝，节点本身随 slab 整体释放
+    for (size_t i = 0; i < hashMap->capacity; i++) {
+        for (BytesNode *cur = hashMap->buckets[i]; cur; cur = cur->next) {
+            if (hashMap->freeVal != NULL && cur->val != NULL) {
+                hashMap->freeVal(cur->val);
+            }
+            if (cur->keyLen > HASH_MAP_BYTES_INLINE_KEY) {
+                free((void *)nodeKey(cur));
+            }
+        }
+    }
+    nodePoolDestroy(&hashMap->nodePool);
+    free(hashMap->buckets);
+    free(hashMap);
+}
+
+/* 查找操作 */
+void *bytesGet(HashMapBytes *hashMap, const void *key, size_t keyLen) {
+    if (hashMap == NULL || (key == NULL && keyLen > 0)) {
+        return NULL;
+    }
+
+    uint64_t hash = hashBytes(key, keyLen, hashMap->seed);
+    for (BytesNode *cur = hashMap->buckets[hash & (hashMap->capacity - 1)]; cur; cur = cur->next) {
+        if (nodeMatches(cur, hash, key, keyLen)) {
+            return cur->val;
+        }
+    }
+    return NULL;
+}
+
+/* 添加操作 */
+void bytesPut(HashMapBytes *hashMap, const void *key, size_t keyLen, const void *val) {
+    if (hashMap == NULL || val == NULL || (key == NULL && keyLen > 0) || keyLen > UINT32_MAX) {
+        return;
+    }
+
+    uint64_t hash = hashBytes(key, keyLen, hashMap->seed);
+    BytesNode **link = findLink(hashMap, hash, key, keyLen);
+    if (link != NULL) {
+        // 注意：这里假设调用者已经正确管理了旧val指向的内存
+        (*link)->val = (void *)val;
+        return;
+    }
+
+    if (hashMap->size >= hashMap->growAt) {
+        extend(hashMap);
+    }
+
+    BytesNode *node = (BytesNode *)nodePoolAlloc(&hashMap->nodePool);
+    if (node == NULL) {
+        return; // 内存分配失败
+    }
+    if (keyLen <= HASH_MAP_BYTES_INLINE_KEY) {
+        if (keyLen > 0) {
+            memcpy(node->keyData, key, keyLen);
+        }
+    } else {
+        unsigned char *heapKey = (unsigned char *)malloc(keyLen);
+        if (heapKey == NULL) {
+            nodePoolFree(&hashMap->nodePool, node);
+            return; // 内存分配失败
+        }
+        memcpy(heapKey, key, keyLen);
+        memcpy(node->keyData, &heapKey, sizeof(heapKey));
+    }
+    node->keyLen = (uint32_t)keyLen;
+    node->hash = hash;
+    node->val = (void *)val;
+
+    size_t index = hash & (hashMap->capacity - 1);
+    node->next = hashMap->buckets[index];
+    hashMap->buckets[index] = node;
+    hashMap->size++;
+}
+
+/* 删除操作 */
+void bytesRemoveItem(HashMapBytes *hashMap, const void *key, size_t keyLen) {
+    if (hashMap == NULL || (key == NULL && keyLen > 0)) {
+        return;
+    }
+
+    BytesNode **link = findLink(hashMap, hashBytes(key, keyLen, hashMap->seed), key, keyLen);
+    if (link == NULL) {
+        return;
+    }
+    BytesNode *node = *link;
+    *link = node->next;
+    freeNode(hashMap, node);
+    hashMap->size--;
+}
+
+/* 获取键值对数量 */
+size_t bytesSize(HashMapBytes *hashMap) {
+    return hashMap == NULL ? 0 : hashMap->size;
+}
+
+/* 从 start 号桶开始查找下一个非空桶，找到时更新迭代器位置 */
+static void seekBucket(HashMapBytesIterator *iterator, size_t start) {
+    HashMapBytes *hashMap = iterator->hashMap;
+    iterator->prevNode = NULL;
+    for (size_t i = start; i < hashMap->capacity; i++) {
+        if (hashMap->buckets[i] != NULL) {
+            iterator->bucketIndex = i;
+            iterator->currentNode = hashMap->buckets[i];
+            return;
+        }
+    }
+    iterator->currentNode = NULL;
+    iterator->hasNext = false;
+}
+
+/* 初始化哈希表迭代器 */
+HashMapBytesIterator bytesInitIterator(HashMapBytes *hashMap) {
+    HashMapBytesIterator iterator;
+    iterator.hashMap = hashMap;
+    iterator.bucketIndex = 0;
+    iterator.currentNode = NULL;
+    iterator.prevNode = NULL;
+    iterator.hasNext = false;
+
+    if (hashMap != NULL && hashMap->size > 0) {
+        iterator.hasNext = true;
+        seekBucket(&iterator, 0);
+    }
+    return iterator;
+}
+
+/* 判断迭代器是否有下一个元素 */
+bool bytesHasNext(HashMapBytesIterator *iterator) {
+    if (iterator == NULL) {
+        return false;
+    }
+    return iterator->hasNext;
+}
+
+/* 获取迭代器当前元素的键 */
+const void *bytesGetKey(HashMapBytesIterator *iterator, size_t *keyLen) {
+    if (iterator == NULL || !iterator->hasNext || iterator->currentNode == NULL) {
+        if (keyLen != NULL) {
+            *keyLen = 0;
+        }
+        return NULL;
+    }
+
+    const BytesNode *node = (const BytesNode *)iterator->currentNode;
+    if (keyLen != NULL) {
+        *keyLen = node->keyLen;
+    }
+    return nodeKey(node);
+}
+
+/* 获取迭代器当前元素的值 */
+void *bytesGetValue(HashMapBytesIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext || iterator->currentNode == NULL) {
+        return NULL;
+    }
+    return ((BytesNode *)iterator->currentNode)->val;
+}
+
+/* 将迭代器移动到下一个元素 */
+void bytesNext(HashMapBytesIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext || iterator->currentNode == NULL) {
+        return;
+    }
+
+    BytesNode *node = (BytesNode *)iterator->currentNode;
+    if (node->next != NULL) {
+        iterator->prevNode = node;
+        iterator->currentNode = node->next;
+        return;
+    }
+    seekBucket(iterator, iterator->bucketIndex + 1);
+}
+
+/* 删除迭代器当前指向的键值对 */
+void bytesRemoveCurrent(HashMapBytesIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext || iterator->currentNode == NULL) {
+        return;
+    }
+
+    HashMapBytes *hashMap = iterator->hashMap;
+    BytesNode *node = (BytesNode *)iterator->currentNode;
+    BytesNode *prev = (BytesNode *)iterator->prevNode;
+    BytesNode *next = node->next;
+
+    if (prev == NULL) {
+        hashMap->buckets[iterator->bucketIndex] = next;
+    } else {
+        prev->next = next;
+    }
+    freeNode(hashMap, node);
+    hashMap->size--;
+
+    // prevNode 保持不变
+    if (next != NULL) {
+        iterator->currentNode = next;
+    } else {
+        seekBucket(iterator, iterator->bucketIndex + 1);
+    }
+}
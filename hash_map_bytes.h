@@ -0,0 +1,136 @@
+#ifndef HASH_MAP_BYTES_H
+#define HASH_MAP_BYTES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define HASH_MAP_BYTES_INLINE_KEY 20      // 不超过该长度的键直接存放在节点中
+#define HASH_MAP_BYTES_LOAD_FACTOR 0.75   // 负载因子
+#define HASH_MAP_BYTES_MIN_CAPACITY 8     // 最小桶数量
+
+/* 字节串键哈希表（链式地址），键为任意二进制数据 */
+typedef struct HashMapBytes HashMapBytes;
+
+/* 字节串键哈希表迭代器 */
+typedef struct {
+    HashMapBytes *hashMap;  // 迭代器所属的哈希表
+    size_t bucketIndex;     // 当前桶索引
+    void *currentNode;      // 当前节点指针
+    void *prevNode;         // 前驱节点指针，用于删除当前节点
+    bool hasNext;           // 是否有下一个元素
+} HashMapBytesIterator;
+
+/**
+ * @brief 创建一个新的 HashMapBytes 对象
+ *
+ * 桶数量会向上取整为 2 的幂。每个哈希表使用随机种子，避免构造的冲突键。
+ *
+ * @param capacity 哈希表的初始桶数量，必须大于0。
+ * @param freeVal val 值释放函数指针，如果不需要释放，可以传递 NULL。
+ *
+ * @return 成功时返回新创建的 HashMapBytes 对象指针，失败时返回 NULL。
+ */
+HashMapBytes *newHashMapBytes(size_t capacity, void (*freeVal)(void*));
+
+/**
+ * @brief 删除字节串键哈希表
+ *
+ * 删除哈希表中的所有键值对，并释放哈希表及键拷贝所占用的内存。
+ *
+ * @param hashMap 哈希表的指针
+ */
+void delHashMapBytes(HashMapBytes *hashMap);
+
+/**
+ * @brief 根据键从哈希表中获取值
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 键数据的指针
+ * @param keyLen 键的字节数
+ *
+ * @return 返回与键对应的值，如果键不存在则返回NULL
+ */
+void *bytesGet(HashMapBytes *hashMap, const void *key, size_t keyLen);
+
+/**
+ * @brief 添加键值对到哈希表
+ *
+ * 键会被拷贝到哈希表中，调用返回后调用者可以释放键的内存。
+ * 如果键已存在，则更新对应的值。
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 键数据的指针
+ * @param keyLen 键的字节数
+ * @param val 要添加的值，不能为NULL
+ */
+void bytesPut(HashMapBytes *hashMap, const void *key, size_t keyLen, const void *val);
+
+/**
+ * @brief 从哈希表中删除键值对
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 键数据的指针
+ * @param keyLen 键的字节数
+ */
+void bytesRemoveItem(HashMapBytes *hashMap, const void *key, size_t keyLen);
+
+/**
+ * @brief 获取哈希表中的键值对数量
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回键值对数量
+ */
+size_t bytesSize(HashMapBytes *hashMap);
+
+/**
+ * @brief 初始化哈希表迭代器
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回初始化后的迭代器
+ */
+HashMapBytesIterator bytesInitIterator(HashMapBytes *hashMap);
+
+/**
+ * @brief 判断迭代器是否有下一个元素
+ *
+ * @param iterator 迭代器的指针
+ * @return 如果有下一个元素，则返回true；否则返回false
+ */
+bool bytesHasNext(HashMapBytesIterator *iterator);
+
+/**
+ * @brief 获取迭代器当前元素的键
+ *
+ * 返回的指针指向哈希表内部保存的键拷贝，在该键被删除前有效。
+ *
+ * @param iterator 迭代器的指针
+ * @param keyLen 输出键的字节数，可以为NULL
+ * @return 返回当前键值对的键
+ */
+const void *bytesGetKey(HashMapBytesIterator *iterator, size_t *keyLen);
+
+/**
+ * @brief 获取迭代器当前元素的值
+ *
+ * @param iterator 迭代器的指针
+ * @return 返回当前键值对的值
+ */
+void *bytesGetValue(HashMapBytesIterator *iterator);
+
+/**
+ * @brief 将迭代器移动到下一个元素
+ *
+ * @param iterator 迭代器的指针
+ */
+void bytesNext(HashMapBytesIterator *iterator);
+
+/**
+ * @brief 删除迭代器当前指向的键值对
+ *
+ * 删除后迭代器自动移动到下一个元素，不需要再调用 bytesNext。
+ *
+ * @param iterator 迭代器指针
+ */
+void bytesRemoveCurrent(HashMapBytesIterator *iterator);
+
+#endif // HASH_MAP_BYTES_H
@@ -0,0 +1,490 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash_map_cuckoo.h"
+#include "hash_func.h"
+#include "utility.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HASH_MAP_CUCKOO_USE_SSE2 1
+#else
+#define HASH_MAP_CUCKOO_USE_SSE2 0
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CUCKOO_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)
+#else
+#define CUCKOO_PREFETCH(addr) ((void)(addr))
+#endif
+
+#define BUCKET_SLOTS HASH_MAP_CUCKOO_BUCKET_SLOTS
+#define BUCKET_FULL ((1u << BUCKET_SLOTS) - 1)
+#define CACHE_LINE 64
+#define POSITION_NOT_FOUND ((size_t)-1)
+
+/* 桶：4 个键连续存放以便一次比较，used 的低 4 位标记已占用的槽位，整个桶占一条缓存行 */
+typedef struct {
+    _Alignas(CACHE_LINE) int keys[BUCKET_SLOTS];
+    uint32_t used;
+    void *vals[BUCKET_SLOTS];
+} CuckooBucket;
+
+/* 暂存区中的键值对 */
+typedef struct {
+    int key;
+    void *val;
+} CuckooEntry;
+
+/* 布谷鸟哈希表 */
+struct HashMapCuckoo {
+    size_t size;            // 键值对数量，包含暂存区
+    size_t bucketCount;     // 桶数量，2 的幂且不小于2
+    size_t mask;            // bucketCount - 1
+
+    CuckooBucket *buckets;  // 按缓存行对齐的桶数组
+    char *raw;              // 桶数组实际分配的内存
+    CuckooEntry stash[HASH_MAP_CUCKOO_STASH_SIZE];
+    size_t stashSize;       // 暂存区中的键值对数量
+    void (*freeVal)(void*); // 释放val的回调函数，如果为NULL则不释放
+};
+
+/* 广度优先搜索的队列项：桶 bucket 由父项所在桶 slot 槽位中的键挪过来 */
+typedef struct {
+    size_t bucket;
+    int parent;
+    unsigned slot;
+} SearchEntry;
+
+/* 键的两个候选桶：分别取哈希值的低 32 位和高 32 位，重合时取相邻的桶 */
+static inline void candidateBuckets(const HashMapCuckoo *hashMap, int key, size_t *first, size_t *second) {
+    uint64_t h = hashMurmur(key);
+    *first = (size_t)h & hashMap->mask;
+    *second = (size_t)(h >> 32) & hashMap->mask;
+    if (*second == *first) {
+        *second = *first ^ 1;
+    }
+}
+
+static inline size_t otherBucket(const HashMapCuckoo *hashMap, int key, size_t bucket) {
+    size_t first, second;
+    candidateBuckets(hashMap, key, &first, &second);
+    return bucket == first ? second : first;
+}
+
+/* 取最低位1的位置 */
+static inline unsigned lowestBit(unsigned mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned i = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/* 在桶中查找等于 key 的已占用槽位，返回槽位掩码 */
+static inline unsigned bucketMatch(const CuckooBucket *bucket, int key) {
+#if HASH_MAP_CUCKOO_USE_SSE2
+    __m128i keys = _mm_load_si128((const __m128i *)(const void *)bucket->keys);
+    __m128i eq = _mm_cmpeq_epi32(keys, _mm_set1_epi32(key));
+    return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq)) & bucket->used;
+#else
+    unsigned mask = 0;
+    for (unsigned i = 0; i < BUCKET_SLOTS; i++) {
+        if (bucket->keys[i] == key) {
+            mask |= 1u << i;
+        }
+    }
+    return mask & bucket->used;
+#endif
+}
+
+static inline unsigned bucketFree(const CuckooBucket *bucket) {
+    return ~bucket->used & BUCKET_FULL;
+}
+
+static inline void bucketSet(CuckooBucket *bucket, unsigned slot, int key, void *val) {
+    bucket->keys[slot] = key;
+    bucket->vals[slot] = val;
+    bucket->used |= 1u << slot;
+}
+
+/*
+ * 查找键的位置，未找到返回 POSITION_NOT_FOUND
+ *
+ * 位置与迭代器一致：小于槽位数量时为 桶 * 4 + 槽位，否则为槽位数量加暂存区下标。
+ * 比较第一个桶之前先预取第二个桶，两条缓存行的访问互相重叠。
+ */
+static size_t findPosition(const HashMapCuckoo *hashMap, int key) {
+    size_t first, second;
+    candidateBuckets(hashMap, key, &first, &second);
+    const CuckooBucket *bucket = &hashMap->buckets[second];
+    CUCKOO_PREFETCH(bucket);
+
+    unsigned match = bucketMatch(&hashMap->buckets[first], key);
+    if (match) {
+        return first * BUCKET_SLOTS + lowestBit(match);
+    }
+    match = bucketMatch(bucket, key);
+    if (match) {
+        return second * BUCKET_SLOTS + lowestBit(match);
+    }
+    for (size_t i = 0; i < hashMap->stashSize; i++) {
+        if (hashMap->stash[i].key == key) {
+            return hashMap->bucketCount * BUCKET_SLOTS + i;
+        }
+    }
+    return POSITION_NOT_FOUND;
+}
+
+static inline void **valueAt(HashMapCuckoo *hashMap, size_t position) {
+    size_t capacity = hashMap->bucketCount * BUCKET_SLOTS;
+    if (position < capacity) {
+        return &hashMap->buckets[position / BUCKET_SLOTS].vals[position % BUCKET_SLOTS];
+    }
+    return &hashMap->stash[position - capacity].val;
+}
+
+/*
+ * 沿广度优先搜索找到的路径挪动键，从有空槽位的桶往回，每一步把父桶中的键挪到它的另一个候选桶。
+ * 路径可能多次经过同一个桶，每一步都检查目标槽位为空且键确实属于目标桶，否则放弃；
+ * 放弃之前完成的每一步都合法，不会丢失键。成功时返回根桶中空出的槽位，失败返回 BUCKET_SLOTS。
+ */
+static unsigned applyPath(HashMapCuckoo *hashMap, const SearchEntry *queue, int end) {
+    const SearchEntry *entry = &queue[end];
+    unsigned slot = lowestBit(bucketFree(&hashMap->buckets[entry->bucket]));
+    while (entry->parent >= 0) {
+        const SearchEntry *parent = &queue[entry->parent];
+        CuckooBucket *from = &hashMap->buckets[parent->bucket];
+        CuckooBucket *to = &hashMap->buckets[entry->bucket];
+        int key = from->keys[entry->slot];
+        if ((to->used >> slot & 1u) || !(from->used >> entry->slot & 1u) ||
+            otherBucket(hashMap, key, parent->bucket) != entry->bucket) {
+            return BUCKET_SLOTS;
+        }
+        bucketSet(to, slot, key, from->vals[entry->slot]);
+        from->used &= ~(1u << entry->slot);
+        slot = entry->slot;
+        entry = parent;
+    }
+    return slot;
+}
+
+/* 把确定不存在的键放进两个候选桶之一，必要时用广度优先搜索挪出空槽位 */
+static bool placeInBuckets(HashMapCuckoo *hashMap, int key, void *val) {
+    SearchEntry queue[HASH_MAP_CUCKOO_MAX_SEARCH];
+    int tail = 0;
+    size_t first, second;
+    candidateBuckets(hashMap, key, &first, &second);
+    queue[tail++] = (SearchEntry){first, -1, 0};
+    queue[tail++] = (SearchEntry){second, -1, 0};
+
+    for (int head = 0; head < tail; head++) {
+        CuckooBucket *bucket = &hashMap->buckets[queue[head].bucket];
+        if (bucketFree(bucket)) {
+            unsigned slot = applyPath(hashMap, queue, head);
+            if (slot == BUCKET_SLOTS) {
+                return false;
+            }
+            // 路径的根是 first 或 second
+            for (int root = head; ; root = queue[root].parent) {
+                if (queue[root].parent < 0) {
+                    bucketSet(&hashMap->buckets[queue[root].bucket], slot, key, val);
+                    return true;
+                }
+            }
+        }
+        if (tail > HASH_MAP_CUCKOO_MAX_SEARCH - BUCKET_SLOTS) {
+            continue;
+        }
+        for (unsigned slot = 0; slot < BUCKET_SLOTS; slot++) {
+            size_t next = otherBucket(hashMap, bucket->keys[slot], queue[head].bucket);
+            queue[tail++] = (SearchEntry){next, head, slot};
+        }
+    }
+    return false;
+}
+
+/* 放入桶或暂存区，都放不下时返回false */
+static bool placeEntry(HashMapCuckoo *hashMap, int key, void *val) {
+    if (placeInBuckets(hashMap, key, val)) {
+        return true;
+    }
+    if (hashMap->stashSize < HASH_MAP_CUCKOO_STASH_SIZE) {
+        hashMap->stash[hashMap->stashSize++] = (CuckooEntry){key, val};
+        return true;
+    }
+    return false;
+}
+
+/* 分配按缓存行对齐、全部为空的桶数组 */
+static bool allocBuckets(HashMapCuckoo *hashMap, size_t bucketCount) {
+    char *raw = (char *)malloc(bucketCount * sizeof(CuckooBucket) + CACHE_LINE - 1);
+    if (raw == NULL) {
+        return false;
+    }
+    uintptr_t aligned = ((uintptr_t)raw + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1);
+    hashMap->raw = raw;
+    hashMap->buckets = (CuckooBucket *)(void *)(raw + (aligned - (uintptr_t)raw));
+    memset(hashMap->buckets, 0, bucketCount * sizeof(CuckooBucket));
+    hashMap->bucketCount = bucketCount;
+    hashMap->mask = bucketCount - 1;
+    hashMap->stashSize = 0;
+    return true;
+}
+
+/*
+ * 扩容到至少 bucketCount 个桶并重新放入所有键值对。
+ * 新表中仍然放不下时（概率极低）继续翻倍；内存分配失败时哈希表保持不变。
+ */
+static bool resize(HashMapCuckoo *hashMap, size_t bucketCount) {
+    CuckooBucket *oldBuckets = hashMap->buckets;
+    char *oldRaw = hashMap->raw;
+    size_t oldCount = hashMap->bucketCount;
+    CuckooEntry oldStash[HASH_MAP_CUCKOO_STASH_SIZE];
+    size_t oldStashSize = hashMap->stashSize;
+    memcpy(oldStash, hashMap->stash, sizeof(oldStash));
+
+    for (;; bucketCount *= 2) {
+        if (!allocBuckets(hashMap, bucketCount)) {
+            hashMap->buckets = oldBuckets;
+            hashMap->raw = oldRaw;
+            hashMap->bucketCount = oldCount;
+            hashMap->mask = oldCount - 1;
+            hashMap->stashSize = oldStashSize;
+            memcpy(hashMap->stash, oldStash, sizeof(oldStash));
+            return false;
+        }
+
+        bool placed = true;
+        for (size_t b = 0; b < oldCount && placed; b++) {
+            for (unsigned used = oldBuckets[b].used; used && placed; used &= used - 1) {
+                unsigned slot = lowestBit(used);
+                placed = placeEntry(hashMap, oldBuckets[b].keys[slot], oldBuckets[b].vals[slot]);
+            }
+        }
+        for (size_t i = 0; i < oldStashSize && placed; i++) {
+            placed = placeEntry(hashMap, oldStash[i].key, oldStash[i].val);
+        }
+        if (placed) {
+            free(oldRaw);
+            return true;
+        }
+        free(hashMap->raw);
+    }
+}
+
+/* 删除暂存区中的第 i 项，用最后一项填补 */
+static void stashErase(HashMapCuckoo *hashMap, size_t i) {
+    hashMap->stash[i] = hashMap->stash[--hashMap->stashSize];
+}
+
+/* 桶中空出槽位后，把暂存区中以该桶为候选桶的第一个键收回到这个槽位 */
+static void reclaimStash(HashMapCuckoo *hashMap, size_t bucket, unsigned slot) {
+    for (size_t i = 0; i < hashMap->stashSize; i++) {
+        size_t first, second;
+        candidateBuckets(hashMap, hashMap->stash[i].key, &first, &second);
+        if (first == bucket || second == bucket) {
+            bucketSet(&hashMap->buckets[bucket], slot, hashMap->stash[i].key, hashMap->stash[i].val);
+            stashErase(hashMap, i);
+            return;
+        }
+    }
+}
+
+/* 删除指定位置的键值对 */
+static void eraseAt(HashMapCuckoo *hashMap, size_t position) {
+    if (hashMap->freeVal != NULL) {
+        hashMap->freeVal(*valueAt(hashMap, position));
+    }
+    size_t capacity = hashMap->bucketCount * BUCKET_SLOTS;
+    if (position < capacity) {
+        size_t bucket = position / BUCKET_SLOTS;
+        unsigned slot = (unsigned)(position % BUCKET_SLOTS);
+        hashMap->buckets[bucket].used &= ~(1u << slot);
+        reclaimStash(hashMap, bucket, slot);
+    } else {
+        stashErase(hashMap, position - capacity);
+    }
+    hashMap->size--;
+}
+
+/* 创建布谷鸟哈希表 */
+HashMapCuckoo *newHashMapCuckoo(size_t capacity, void (*freeVal)(void*)) {
+    if (capacity == 0) {
+        return NULL;
+    }
+    HashMapCuckoo *hashMap = (HashMapCuckoo *)malloc(sizeof(HashMapCuckoo));
+    if (hashMap == NULL) {
+        return NULL;
+    }
+
+    size_t slots = HASH_MAP_CUCKOO_MIN_CAPACITY;
+    while (slots < capacity) {
+        slots *= 2;
+    }
+
+    hashMap->size = 0;
+    hashMap->freeVal = freeVal;
+    if (!allocBuckets(hashMap, slots / BUCKET_SLOTS)) {
+        free(hashMap);
+        return NULL;
+    }
+    return hashMap;
+}
+
+/* 删除布谷鸟哈希表 */
+void delHashMapCuckoo(HashMapCuckoo *hashMap) {
+    if (hashMap == NULL) {
+        return;
+    }
+
+    if (hashMap->freeVal != NULL) {
+        for (size_t b = 0; b < hashMap->bucketCount; b++) {
+            for (unsigned used = hashMap->buckets[b].used; used; used &= used - 1) {
+                hashMap->freeVal(hashMap->buckets[b].vals[lowestBit(used)]);
+            }
+        }
+        for (size_t i = 0; i < hashMap->stashSize; i++) {
+            hashMap->freeVal(hashMap->stash[i].val);
+        }
+    }
+    free(hashMap->raw);
+    free(hashMap);
+}
+
+/* 查找操作 */
+void *cuckooGet(HashMapCuckoo *hashMap, int key) {
+    if (hashMap == NULL) {
+        return NULL;
+    }
+
+    size_t position = findPosition(hashMap, key);
+    return position == POSITION_NOT_FOUND ? NULL : *valueAt(hashMap, position);
+}
+
+/* 添加操作 */
+void cuckooPut(HashMapCuckoo *hashMap, int key, const void *val) {
+    if (hashMap == NULL || val == NULL) {
+        return;
+    }
+
+    size_t position = findPosition(hashMap, key);
+    if (position != POSITION_NOT_FOUND) {
+        // 注意：这里假设调用者已经正确管理了旧val指向的内存
+        *valueAt(hashMap, position) = (void *)val;
+        return;
+    }
+
+    while (!placeEntry(hashMap, key, (void *)val)) {
+        if (!resize(hashMap, hashMap->bucketCount * 2)) {
+            return; // 内存分配失败
+        }
+    }
+    hashMap->size++;
+}
+
+/* 删除操作 */
+void cuckooRemoveItem(HashMapCuckoo *hashMap, int key) {
+    if (hashMap == NULL) {
+        return;
+    }
+
+    size_t position = findPosition(hashMap, key);
+    if (position != POSITION_NOT_FOUND) {
+        eraseAt(hashMap, position);
+    }
+}
+
+/* 获取键值对数量 */
+size_t cuckooSize(HashMapCuckoo *hashMap) {
+    return hashMap == NULL ? 0 : hashMap->size;
+}
+
+/* 获取槽位数量 */
+size_t cuckooCapacity(HashMapCuckoo *hashMap) {
+    return hashMap == NULL ? 0 : hashMap->bucketCount * BUCKET_SLOTS;
+}
+
+/* 获取暂存区中的键值对数量 */
+size_t cuckooStashSize(HashMapCuckoo *hashMap) {
+    return hashMap == NULL ? 0 : hashMap->stashSize;
+}
+
+/* 从迭代器当前位置开始查找下一个已占用的槽位或暂存区项 */
+static void seekFull(HashMapCuckooIterator *iterator) {
+    HashMapCuckoo *hashMap = iterator->hashMap;
+    size_t capacity = hashMap->bucketCount * BUCKET_SLOTS;
+    while (iterator->position < capacity &&
+           !(hashMap->buckets[iterator->position / BUCKET_SLOTS].used >> (iterator->position % BUCKET_SLOTS) & 1u)) {
+        iterator->position++;
+    }
+    iterator->hasNext = iterator->position < capacity + hashMap->stashSize;
+}
+
+/* 初始化哈希表迭代器 */
+HashMapCuckooIterator cuckooInitIterator(HashMapCuckoo *hashMap) {
+    HashMapCuckooIterator iterator;
+    iterator.hashMap = hashMap;
+    iterator.position = 0;
+    iterator.hasNext = false;
+
+    if (hashMap != NULL && hashMap->size > 0) {
+        seekFull(&iterator);
+    }
+    return iterator;
+}
+
+/* 判断迭代器是否有下一个元素 */
+bool cuckooHasNext(HashMapCuckooIterator *iterator) {
+    if (iterator == NULL) {
+        return false;
+    }
+    return iterator->hasNext;
+}
+
+/* 获取迭代器当前元素的键 */
+int cuckooGetKey(HashMapCuckooIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return -1;
+    }
+    HashMapCuckoo *hashMap = iterator->hashMap;
+    size_t capacity = hashMap->bucketCount * BUCKET_SLOTS;
+    if (iterator->position < capacity) {
+        return hashMap->buckets[iterator->position / BUCKET_SLOTS].keys[iterator->position % BUCKET_SLOTS];
+    }
+    return hashMap->stash[iterator->position - capacity].key;
+}
+
+/* 获取迭代器当前元素的值 */
+void *cuckooGetValue(HashMapCuckooIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return NULL;
+    }
+    return *valueAt(iterator->hashMap, iterator->position);
+}
+
+/* 将迭代器移动到下一个元素 */
+void cuckooNext(HashMapCuckooIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return;
+    }
+
+    iterator->position++;
+    seekFull(iterator);
+}
+
+/* 删除迭代器当前指向的键值对 */
+void cuckooRemoveCurrent(HashMapCuckooIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return;
+    }
+
+    // 暂存区的键可能移到当前位置，因此从当前位置重新查找
+    eraseAt(iterator->hashMap, iterator->position);
+    seekFull(iterator);
+}
@@ -0,0 +1,155 @@
+#ifndef HASH_MAP_CUCKOO_H
+#define HASH_MAP_CUCKOO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define HASH_MAP_CUCKOO_BUCKET_SLOTS 4    // 每个桶的槽位数量
+#define HASH_MAP_CUCKOO_MIN_CAPACITY 8    // 最小槽位数量
+#define HASH_MAP_CUCKOO_STASH_SIZE 8      // 暂存区容量
+#define HASH_MAP_CUCKOO_MAX_SEARCH 512    // 插入时广度优先搜索最多访问的桶数量
+
+/*
+ * 分桶布谷鸟哈希表
+ *
+ * 每个键有两个候选桶，每个桶 4 个槽位，正好占一条缓存行。查找最多读取两条缓存行，
+ * 用 SIMD 一次比较整个桶的 4 个键，最坏情况也是常数时间（暂存区不为空时再扫描最多 8 个键）。
+ * 两个候选桶都满时，用广度优先搜索找到最短的挪动路径，沿路径把键挪到各自的另一个候选桶；
+ * 找不到路径时放入暂存区，暂存区也满了才扩容。负载因子通常可以达到 0.95 左右。
+ */
+typedef struct HashMapCuckoo HashMapCuckoo;
+
+/* 布谷鸟哈希表迭代器 */
+typedef struct {
+    HashMapCuckoo *hashMap; // 迭代器所属的哈希表
+    size_t position;        // 当前槽位：先遍历所有桶的槽位，再遍历暂存区
+    bool hasNext;           // 是否有下一个元素
+} HashMapCuckooIterator;
+
+/**
+ * @brief 创建一个新的 HashMapCuckoo 对象
+ *
+ * 槽位数量会向上取整为 2 的幂。
+ *
+ * @param capacity 期望的槽位数量，必须大于0。
+ * @param freeVal val 值释放函数指针，用于释放存储在哈希表中的值。如果不需要释放，可以传递 NULL。
+ *
+ * @return 成功时返回新创建的 HashMapCuckoo 对象指针，失败时返回 NULL。
+ */
+HashMapCuckoo *newHashMapCuckoo(size_t capacity, void (*freeVal)(void*));
+
+/**
+ * @brief 删除布谷鸟哈希表
+ *
+ * 删除哈希表中的所有键值对，并释放哈希表所占用的内存。
+ *
+ * @param hashMap 哈希表的指针
+ */
+void delHashMapCuckoo(HashMapCuckoo *hashMap);
+
+/**
+ * @brief 根据键从哈希表中获取值
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要查找的键
+ *
+ * @return 返回与键对应的值，如果键不存在则返回NULL
+ */
+void *cuckooGet(HashMapCuckoo *hashMap, int key);
+
+/**
+ * @brief 添加键值对到哈希表
+ *
+ * 向哈希表中添加一个键值对。如果键已存在，则更新对应的值。
+ * 找不到挪动路径且暂存区已满时容量翻倍。
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要添加的键
+ * @param val 要添加的值，不能为NULL
+ */
+void cuckooPut(HashMapCuckoo *hashMap, int key, const void *val);
+
+/**
+ * @brief 从哈希表中删除键值对
+ *
+ * 删除后空出的槽位会优先收回暂存区中属于该桶的键。
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要删除的键
+ */
+void cuckooRemoveItem(HashMapCuckoo *hashMap, int key);
+
+/**
+ * @brief 获取哈希表中的键值对数量
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回键值对数量
+ */
+size_t cuckooSize(HashMapCuckoo *hashMap);
+
+/**
+ * @brief 获取哈希表的槽位数量（不含暂存区）
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回槽位数量
+ */
+size_t cuckooCapacity(HashMapCuckoo *hashMap);
+
+/**
+ * @brief 获取暂存区中的键值对数量
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回暂存区中的键值对数量
+ */
+size_t cuckooStashSize(HashMapCuckoo *hashMap);
+
+/**
+ * @brief 初始化哈希表迭代器
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回初始化后的迭代器
+ */
+HashMapCuckooIterator cuckooInitIterator(HashMapCuckoo *hashMap);
+
+/**
+ * @brief 判断迭代器是否有下一个元素
+ *
+ * @param iterator 迭代器的指针
+ * @return 如果有下一个元素，则返回true；否则返回false
+ */
+bool cuckooHasNext(HashMapCuckooIterator *iterator);
+
+/**
+ * @brief 获取迭代器当前元素的键
+ *
+ * @param iterator 迭代器的指针
+ * @return 返回当前键值对的键
+ */
+int cuckooGetKey(HashMapCuckooIterator *iterator);
+
+/**
+ * @brief 获取迭代器当前元素的值
+ *
+ * @param iterator 迭代器的指针
+ * @return 返回当前键值对的值
+ */
+void *cuckooGetValue(HashMapCuckooIterator *iterator);
+
+/**
+ * @brief 将迭代器移动到下一个元素
+ *
+ * @param iterator 迭代器的指针
+ */
+void cuckooNext(HashMapCuckooIterator *iterator);
+
+/**
+ * @brief 删除迭代器当前指向的键值对
+ *
+ * 删除后迭代器自动移动到下一个元素，不需要再调用 cuckooNext。
+ * 从暂存区收回到当前槽位的键尚未访问过，遍历不会遗漏或重复。
+ *
+ * @param iterator 迭代器指针
+ */
+void cuckooRemoveCurrent(HashMapCuckooIterator *iterator);
+
+#endif // HASH_MAP_CUCKOO_H
@@ -0,0 +1,349 @@
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "hash_map_epoch.h"
+#include "hash_func.h"
+#include "utility.h"
+
+/* 链表节点：next 和 val 可能被写者修改的同时被读者读取，因此都是原子变量 */
+typedef struct EpochNode {
+    _Atomic(struct EpochNode *) next;
+    _Atomic(void *) val;
+    int key;
+    bool pooled;    // 位于桶数组的节点块中，随桶数组一起释放，否则单独分配
+} EpochNode;
+
+/* 桶数组：扩容时整体替换，旧数组连同其中的节点一起延迟释放 */
+typedef struct {
+    size_t capacity;                    // 桶数量，2 的幂
+    EpochNode *nodes;                   // 扩容时一次分配的节点块，可能为NULL
+    _Atomic(EpochNode *) buckets[];     // 桶
+} EpochTable;
+
+/* 读无锁的并发哈希表 */
+struct HashMapEpoch {
+    _Atomic(EpochTable *) table;    // 当前桶数组
+    _Atomic size_t size;            // 键值对数量，只由写者修改
+    pthread_mutex_t writeLock;      // 串行化写者
+    void (*freeVal)(void*);         // 释放val的回调函数，如果为NULL则不释放
+    EpochDomain *domain;            // 纪元回收域
+    bool reclaimDue;                // 写锁内退休的对象达到回收阈值，解锁后回收，只由写者访问
+};
+
+/* 传给 epochRetire 的释放函数，必须经过 utility.h 中的 free 宏以保持内存检测计数一致 */
+static void freeNode(void *node) {
+    free(node);
+}
+
+/*
+ * 释放桶数组及其中的全部节点（节点已经被复制到新数组，这里不释放值）
+ *
+ * 节点块整块释放；链表中只有上次扩容之后插入的节点是单独分配的。
+ * 从节点块中删除的节点不单独退休，它们随节点块一起释放。
+ */
+static void freeTable(void *ptr) {
+    EpochTable *table = (EpochTable *)ptr;
+    for (size_t i = 0; i < table->capacity; i++) {
+        EpochNode *cur = atomic_load_explicit(&table->buckets[i], memory_order_relaxed);
+        while (cur != NULL) {
+            EpochNode *next = atomic_load_explicit(&cur->next, memory_order_relaxed);
+            if (!cur->pooled) {
+                free(cur);
+            }
+            cur = next;
+        }
+    }
+    if (table->nodes != NULL) {
+        free(table->nodes);
+    }
+    free(table);
+}
+
+static EpochTable *newTable(size_t capacity) {
+    EpochTable *table = (EpochTable *)malloc(sizeof(EpochTable) + capacity * sizeof(_Atomic(EpochNode *)));
+    if (table == NULL) {
+        return NULL;
+    }
+    table->capacity = capacity;
+    table->nodes = NULL;
+    for (size_t i = 0; i < capacity; i++) {
+        atomic_init(&table->buckets[i], NULL);
+    }
+    return table;
+}
+
+static inline size_t bucketFor(const EpochTable *table, int key) {
+    return (size_t)hashMurmur(key) & (table->capacity - 1);
+}
+
+/* 在写锁内退休对象，达到回收阈值时记下来，解锁后再回收 */
+static void retire(HashMapEpoch *hashMap, void *ptr, void (*freeFn)(void*)) {
+    if (epochRetireDeferred(hashMap->domain, ptr, freeFn)) {
+        hashMap->reclaimDue = true;
+    }
+}
+
+/* 释放写锁，需要时回收，freeVal 和 free 不在写锁内执行 */
+static void writeUnlock(HashMapEpoch *hashMap) {
+    bool reclaim = hashMap->reclaimDue;
+    hashMap->reclaimDue = false;
+    pthread_mutex_unlock(&hashMap->writeLock);
+    if (reclaim) {
+        epochReclaim(hashMap->domain);
+    }
+}
+
+/*
+ * 容量翻倍（持有写锁）
+ *
+ * 把每个节点复制到新数组后再一次性发布新数组。读者可能仍在遍历旧数组，
+ * 所以旧数组中的节点保持原样，随旧数组一起作为一个对象延迟释放。
+ * 副本从一次分配的节点块中依次取出，键和值指针原样复制。
+ */
+static void extend(HashMapEpoch *hashMap, EpochTable *old, size_t size) {
+    EpochTable *table = newTable(old->capacity * 2);
+    if (table == NULL) {
+        return; // 扩容失败时保持原容量
+    }
+    if (size > 0) {
+        table->nodes = (EpochNode *)malloc(size * sizeof(EpochNode));
+        if (table->nodes == NULL) {
+            free(table);
+            return;
+        }
+    }
+
+    EpochNode *copy = table->nodes;
+    for (size_t i = 0; i < old->capacity; i++) {
+        EpochNode *cur = atomic_load_explicit(&old->buckets[i], memory_order_relaxed);
+        for (; cur != NULL; cur = atomic_load_explicit(&cur->next, memory_order_relaxed), copy++) {
+            size_t index = bucketFor(table, cur->key);
+            copy->key = cur->key;
+            copy->pooled = true;
+            atomic_init(&copy->val, atomic_load_explicit(&cur->val, memory_order_relaxed));
+            atomic_init(&copy->next, atomic_load_explicit(&table->buckets[index], memory_order_relaxed));
+            atomic_store_explicit(&table->buckets[index], copy, memory_order_relaxed);
+        }
+    }
+
+    atomic_store_explicit(&hashMap->table, table, memory_order_release);
+    retire(hashMap, old, freeTable);
+}
+
+/* 创建读无锁的并发哈希表 */
+HashMapEpoch *newHashMapEpoch(size_t capacity, void (*freeVal)(void*)) {
+    if (capacity == 0) {
+        return NULL;
+    }
+    HashMapEpoch *hashMap = (HashMapEpoch *)malloc(sizeof(HashMapEpoch));
+    if (hashMap == NULL) {
+        return NULL;
+    }
+
+    size_t buckets = HASH_MAP_EPOCH_MIN_CAPACITY;
+    while (buckets < capacity) {
+        buckets *= 2;
+    }
+    EpochTable *table = newTable(buckets);
+    hashMap->domain = newEpochDomain();
+    if (table == NULL || hashMap->domain == NULL || pthread_mutex_init(&hashMap->writeLock, NULL) != 0) {
+        if (table != NULL) {
+            free(table);
+        }
+        delEpochDomain(hashMap->domain);
+        free(hashMap);
+        return NULL;
+    }
+    atomic_init(&hashMap->table, table);
+    atomic_init(&hashMap->size, 0);
+    hashMap->freeVal = freeVal;
+    hashMap->reclaimDue = false;
+    return hashMap;
+}
+
+/* 删除哈希表 */
+void delHashMapEpoch(HashMapEpoch *hashMap) {
+    if (hashMap == NULL) {
+        return;
+    }
+
+    EpochTable *table = atomic_load(&hashMap->table);
+    if (hashMap->freeVal != NULL) {
+        for (size_t i = 0; i < table->capacity; i++) {
+            EpochNode *cur = atomic_load_explicit(&table->buckets[i], memory_order_relaxed);
+            for (; cur != NULL; cur = atomic_load_explicit(&cur->next, memory_order_relaxed)) {
+                hashMap->freeVal(atomic_load_explicit(&cur->val, memory_order_relaxed));
+            }
+        }
+    }
+    freeTable(table);
+    delEpochDomain(hashMap->domain);
+    pthread_mutex_destroy(&hashMap->writeLock);
+    free(hashMap);
+}
+
+/* 注册读者 */
+HashMapEpochReader *epochMapRegisterReader(HashMapEpoch *hashMap) {
+    return hashMap == NULL ? NULL : epochRegister(hashMap->domain);
+}
+
+/* 注销读者 */
+void epochMapUnregisterReader(HashMapEpochReader *reader) {
+    epochUnregister(reader);
+}
+
+/* 进入读临界区 */
+void epochMapReadBegin(HashMapEpochReader *reader) {
+    if (reader != NULL) {
+        epochEnter(reader);
+    }
+}
+
+/* 退出读临界区 */
+void epochMapReadEnd(HashMapEpochReader *reader) {
+    if (reader != NULL) {
+        epochExit(reader);
+    }
+}
+
+/* 查找操作（无锁） */
+void *epochMapGet(HashMapEpoch *hashMap, HashMapEpochReader *reader, int key) {
+    if (hashMap == NULL || reader == NULL) {
+        return NULL;
+    }
+
+    void *val = NULL;
+    epochEnter(reader);
+    EpochTable *table = atomic_load_explicit(&hashMap->table, memory_order_acquire);
+    EpochNode *cur = atomic_load_explicit(&table->buckets[bucketFor(table, key)], memory_order_acquire);
+    for (; cur != NULL; cur = atomic_load_explicit(&cur->next, memory_order_acquire)) {
+        if (cur->key == key) {
+            val = atomic_load_explicit(&cur->val, memory_order_acquire);
+            break;
+        }
+    }
+    epochExit(reader);
+    return val;
+}
+
+/* 添加操作 */
+void epochMapPut(HashMapEpoch *hashMap, int key, const void *val) {
+    if (hashMap == NULL || val == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&hashMap->writeLock);
+    EpochTable *table = atomic_load_explicit(&hashMap->table, memory_order_relaxed);
+    EpochNode *cur = atomic_load_explicit(&table->buckets[bucketFor(table, key)], memory_order_relaxed);
+    for (; cur != NULL; cur = atomic_load_explicit(&cur->next, memory_order_relaxed)) {
+        if (cur->key == key) {
+            void *old = atomic_exchange_explicit(&cur->val, (void *)val, memory_order_acq_rel);
+            if (hashMap->freeVal != NULL && old != val) {
+                retire(hashMap, old, hashMap->freeVal);
+            }
+            writeUnlock(hashMap);
+            return;
+        }
+    }
+
+    size_t size = atomic_load_explicit(&hashMap->size, memory_order_relaxed);
+    if ((double)(size + 1) > (double)table->capacity * HASH_MAP_EPOCH_LOAD_FACTOR) {
+        extend(hashMap, table, size);
+        table = atomic_load_explicit(&hashMap->table, memory_order_relaxed);
+    }
+
+    EpochNode *node = (EpochNode *)malloc(sizeof(EpochNode));
+    if (node == NULL) {
+        writeUnlock(hashMap);
+        return; // 内存分配失败
+    }
+    size_t index = bucketFor(table, key);
+    node->key = key;
+    node->pooled = false;
+    atomic_init(&node->val, (void *)val);
+    atomic_init(&node->next, atomic_load_explicit(&table->buckets[index], memory_order_relaxed));
+    // release 保证读者看到新节点时，节点内容已经写好
+    atomic_store_explicit(&table->buckets[index], node, memory_order_release);
+    atomic_store_explicit(&hashMap->size, size + 1, memory_order_relaxed);
+    writeUnlock(hashMap);
+}
+
+/* 摘除 link 指向的节点并延迟释放（持有写锁），节点块中的节点随桶数组释放 */
+static void unlinkNode(HashMapEpoch *hashMap, _Atomic(EpochNode *) *link, EpochNode *node) {
+    atomic_store_explicit(link, atomic_load_explicit(&node->next, memory_order_relaxed), memory_order_release);
+    if (hashMap->freeVal != NULL) {
+        retire(hashMap, atomic_load_explicit(&node->val, memory_order_relaxed), hashMap->freeVal);
+    }
+    if (!node->pooled) {
+        retire(hashMap, node, freeNode);
+    }
+    atomic_fetch_sub_explicit(&hashMap->size, 1, memory_order_relaxed);
+}
+
+/* 删除操作 */
+void epochMapRemoveItem(HashMapEpoch *hashMap, int key) {
+    if (hashMap == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&hashMap->writeLock);
+    EpochTable *table = atomic_load_explicit(&hashMap->table, memory_order_relaxed);
+    _Atomic(EpochNode *) *link = &table->buckets[bucketFor(table, key)];
+    EpochNode *cur;
+    while ((cur = atomic_load_explicit(link, memory_order_relaxed)) != NULL) {
+        if (cur->key == key) {
+            unlinkNode(hashMap, link, cur);
+            break;
+        }
+        link = &cur->next;
+    }
+    writeUnlock(hashMap);
+}
+
+/* 删除所有满足条件的键值对 */
+size_t epochMapRemoveIf(HashMapEpoch *hashMap, bool (*pred)(int key, void *val, void *ctx), void *ctx) {
+    if (hashMap == NULL || pred == NULL) {
+        return 0;
+    }
+
+    size_t removed = 0;
+    pthread_mutex_lock(&hashMap->writeLock);
+    EpochTable *table = atomic_load_explicit(&hashMap->table, memory_order_relaxed);
+    for (size_t i = 0; i < table->capacity; i++) {
+        _Atomic(EpochNode *) *link = &table->buckets[i];
+        EpochNode *cur;
+        while ((cur = atomic_load_explicit(link, memory_order_relaxed)) != NULL) {
+            if (pred(cur->key, atomic_load_explicit(&cur->val, memory_order_relaxed), ctx)) {
+                unlinkNode(hashMap, link, cur);
+                removed++;
+            } else {
+                link = &cur->next;
+            }
+        }
+    }
+    writeUnlock(hashMap);
+    return removed;
+}
+
+/* 获取键值对数量 */
+size_t epochMapSize(HashMapEpoch *hashMap) {
+    return hashMap == NULL ? 0 : atomic_load_explicit(&hashMap->size, memory_order_relaxed);
+}
+
+/* 遍历所有键值对（无锁） */
+void epochMapForEach(HashMapEpoch *hashMap, HashMapEpochReader *reader,
+                     void (*visit)(int key, void *val, void *ctx), void *ctx) {
+    if (hashMap == NULL || reader == NULL || visit == NULL) {
+        return;
+    }
+
+    epochEnter(reader);
+    EpochTable *table = atomic_load_explicit(&hashMap->table, memory_order_acquire);
+    for (size_t i = 0; i < table->capacity; i++) {
+        EpochNode *cur = atomic_load_explicit(&table->buckets[i], memory_order_acquire);
+        for (; cur != NULL; cur = atomic_load_explicit(&cur->next, memory_order_acquire)) {
+            visit(cur->key, atomic_load_explicit(&cur->val, memory_order_acquire), ctx);
+        }
+    }
+    epochExit(reader);
+}
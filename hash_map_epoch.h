@@ -0,0 +1,141 @@
+#ifndef HASH_MAP_EPOCH_H
+#define HASH_MAP_EPOCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "epoch.h"
+
+#define HASH_MAP_EPOCH_LOAD_FACTOR 0.75   // 负载因子
+#define HASH_MAP_EPOCH_MIN_CAPACITY 8     // 最小桶数量
+
+/*
+ * 读无锁的并发哈希表（链式地址）
+ *
+ * 读者（epochMapGet、epochMapForEach）不获取任何锁，只在进入和退出时更新自己的纪元记录；
+ * 写者之间用互斥锁串行化。被删除的节点、被替换的值以及扩容后废弃的桶数组都通过纪元回收
+ * 延迟释放，读者永远不会访问到已释放的内存。扩容时复制节点而不是移动节点，
+ * 正在遍历旧桶数组的读者不受影响；副本一次分配成一个节点块，旧桶数组连同旧节点作为一个对象回收。
+ * 回收在写锁之外进行，freeVal 不会阻塞其它写者。
+ */
+typedef struct HashMapEpoch HashMapEpoch;
+
+/* 读者句柄，每个读者线程注册一个 */
+typedef EpochRecord HashMapEpochReader;
+
+/**
+ * @brief 创建一个新的 HashMapEpoch 对象
+ *
+ * @param capacity 哈希表的初始桶数量，必须大于0，会向上取整为 2 的幂。
+ * @param freeVal val 值释放函数指针，如果不需要释放，可以传递 NULL。值同样会被延迟释放。
+ *
+ * @return 成功时返回新创建的 HashMapEpoch 对象指针，失败时返回 NULL。
+ */
+HashMapEpoch *newHashMapEpoch(size_t capacity, void (*freeVal)(void*));
+
+/**
+ * @brief 删除哈希表
+ *
+ * 调用时不能有其他线程正在访问该哈希表，所有读者句柄随之失效。
+ *
+ * @param hashMap 哈希表的指针
+ */
+void delHashMapEpoch(HashMapEpoch *hashMap);
+
+/**
+ * @brief 为当前线程注册读者句柄
+ *
+ * @param hashMap 哈希表的指针
+ * @return 成功时返回读者句柄，失败时返回 NULL。
+ */
+HashMapEpochReader *epochMapRegisterReader(HashMapEpoch *hashMap);
+
+/**
+ * @brief 注销读者句柄
+ *
+ * @param reader 读者句柄
+ */
+void epochMapUnregisterReader(HashMapEpochReader *reader);
+
+/**
+ * @brief 进入读临界区
+ *
+ * 设置了 freeVal 时，epochMapGet 返回的值只在临界区内有效；需要在返回后继续使用值时，
+ * 用 epochMapReadBegin / epochMapReadEnd 包住查找和使用值的代码。可以嵌套。
+ *
+ * @param reader 当前线程的读者句柄
+ */
+void epochMapReadBegin(HashMapEpochReader *reader);
+
+/**
+ * @brief 退出读临界区
+ *
+ * @param reader 当前线程的读者句柄
+ */
+void epochMapReadEnd(HashMapEpochReader *reader);
+
+/**
+ * @brief 根据键从哈希表中获取值（无锁）
+ *
+ * @param hashMap 哈希表的指针
+ * @param reader 当前线程的读者句柄
+ * @param key 要查找的键
+ *
+ * @return 返回与键对应的值，如果键不存在则返回NULL
+ */
+void *epochMapGet(HashMapEpoch *hashMap, HashMapEpochReader *reader, int key);
+
+/**
+ * @brief 添加键值对到哈希表
+ *
+ * 写者之间串行执行。如果键已存在，则更新对应的值，旧值通过纪元回收延迟释放。
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要添加的键
+ * @param val 要添加的值，不能为NULL
+ */
+void epochMapPut(HashMapEpoch *hashMap, int key, const void *val);
+
+/**
+ * @brief 从哈希表中删除键值对
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要删除的键
+ */
+void epochMapRemoveItem(HashMapEpoch *hashMap, int key);
+
+/**
+ * @brief 删除所有满足条件的键值对
+ *
+ * 持有写锁遍历整个哈希表，相当于迭代器中的 removeCurrent。回调中不能再调用写操作。
+ *
+ * @param hashMap 哈希表的指针
+ * @param pred 判断函数，返回true的键值对会被删除
+ * @param ctx 传给判断函数的用户数据
+ *
+ * @return 返回删除的键值对数量
+ */
+size_t epochMapRemoveIf(HashMapEpoch *hashMap, bool (*pred)(int key, void *val, void *ctx), void *ctx);
+
+/**
+ * @brief 获取哈希表中的键值对数量
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回键值对数量
+ */
+size_t epochMapSize(HashMapEpoch *hashMap);
+
+/**
+ * @brief 遍历哈希表中的所有键值对（无锁）
+ *
+ * 遍历期间写操作可以并发进行：遍历开始前已存在且未被删除的键一定会被访问到，
+ * 遍历过程中插入或删除的键可能被访问到也可能不会。
+ *
+ * @param hashMap 哈希表的指针
+ * @param reader 当前线程的读者句柄
+ * @param visit 对每个键值对调用的回调函数
+ * @param ctx 传给回调函数的用户数据
+ */
+void epochMapForEach(HashMapEpoch *hashMap, HashMapEpochReader *reader,
+                     void (*visit)(int key, void *val, void *ctx), void *ctx);
+
+#endif // HASH_MAP_EPOCH_H
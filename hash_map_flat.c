@@ -0,0 +1,314 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash_map_flat.h"
+#include "hash_map_flat_group.h"
+#include "hash_func.h"
+#include "utility.h"
+
+/* 槽位：键和值放在一起，命中时只需再访问一条缓存行 */
+typedef struct {
+    int key;
+    void *val;
+} FlatSlot;
+
+/* 开放寻址哈希表 */
+struct HashMapFlat {
+    size_t size;            // 键值对数量
+    size_t capacity;        // 槽位数量，2 的幂
+    size_t growthLeft;      // 在扩容前还可占用的空槽位数量（墓碑不计入）
+
+    uint8_t *ctrl;          // 控制字节数组，长度为 capacity
+    FlatSlot *slots;        // 槽位数组，长度为 capacity
+    void (*freeVal)(void*); // 释放val的回调函数，如果为NULL则不释放
+};
+
+/* 对键做充分混合，高位用于定位组，低7位作为控制字节 */
+static inline uint64_t flatHash(int key) {
+    return hashMurmur(key);
+}
+
+static inline bool slotIsFull(const HashMapFlat *hashMap, size_t slot) {
+    return (hashMap->ctrl[slot] & 0x80) == 0;
+}
+
+static size_t maxLoad(size_t capacity) {
+    return capacity / HASH_MAP_FLAT_MAX_LOAD_DEN * HASH_MAP_FLAT_MAX_LOAD_NUM;
+}
+
+/* 查找键所在的槽位，未找到返回 SLOT_NOT_FOUND */
+static size_t findSlot(const HashMapFlat *hashMap, int key, uint64_t hash) {
+    size_t groupMask = hashMap->capacity / GROUP_WIDTH - 1;
+    size_t group = hashH1(hash) & groupMask;
+    uint8_t h2 = hashH2(hash);
+
+    // 按组做三角数探测，组数量为 2 的幂时可以遍历所有组
+    for (size_t step = 1; step <= groupMask + 1; step++) {
+        const uint8_t *ctrl = hashMap->ctrl + group * GROUP_WIDTH;
+        GroupMask match = groupMatch(ctrl, h2);
+        while (match) {
+            size_t slot = group * GROUP_WIDTH + lowestBit(match);
+            if (hashMap->slots[slot].key == key) {
+                return slot;
+            }
+            match &= match - 1;
+        }
+        // 组内存在空槽位说明键不可能出现在更后面的组中
+        if (groupMatchEmpty(ctrl)) {
+            return SLOT_NOT_FOUND;
+        }
+        group = (group + step) & groupMask;
+    }
+    return SLOT_NOT_FOUND;
+}
+
+/* 沿探测序列查找第一个可插入的槽位（空槽位或墓碑） */
+static size_t findInsertSlot(const HashMapFlat *hashMap, uint64_t hash) {
+    return ctrlFindInsertSlot(hashMap->ctrl, hashMap->capacity, hash);
+}
+
+/* 分配指定容量的槽位数组，成功返回true */
+static bool allocSlots(HashMapFlat *hashMap, size_t capacity) {
+    uint8_t *ctrl = (uint8_t *)malloc(capacity);
+    if (ctrl == NULL) {
+        return false;
+    }
+    FlatSlot *slots = (FlatSlot *)malloc(capacity * sizeof(FlatSlot));
+    if (slots == NULL) {
+        free(ctrl);
+        return false;
+    }
+    memset(ctrl, CTRL_EMPTY, capacity);
+
+    hashMap->ctrl = ctrl;
+    hashMap->slots = slots;
+    hashMap->capacity = capacity;
+    hashMap->growthLeft = maxLoad(capacity);
+    return true;
+}
+
+/* 以新容量重建槽位数组，同时清除所有墓碑 */
+static bool resize(HashMapFlat *hashMap, size_t newCapacity) {
+    uint8_t *oldCtrl = hashMap->ctrl;
+    FlatSlot *oldSlots = hashMap->slots;
+    size_t oldCapacity = hashMap->capacity;
+
+    if (!allocSlots(hashMap, newCapacity)) {
+        return false;
+    }
+
+    // 旧表中的键互不相同，直接放入第一个可用槽位即可
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldCtrl[i] & 0x80) {
+            continue;
+        }
+        uint64_t hash = flatHash(oldSlots[i].key);
+        size_t slot = findInsertSlot(hashMap, hash);
+        hashMap->ctrl[slot] = hashH2(hash);
+        hashMap->slots[slot] = oldSlots[i];
+    }
+    hashMap->growthLeft -= hashMap->size;
+
+    free(oldCtrl);
+    free(oldSlots);
+    return true;
+}
+
+/* 槽位用尽时调用：墓碑较多则原地重建，否则容量翻倍 */
+static bool grow(HashMapFlat *hashMap) {
+    size_t newCapacity = hashMap->capacity;
+    if (hashMap->size * 2 >= maxLoad(hashMap->capacity)) {
+        newCapacity *= 2;
+    }
+    return resize(hashMap, newCapacity);
+}
+
+/* 删除指定槽位的键值对 */
+static void eraseSlot(HashMapFlat *hashMap, size_t slot) {
+    if (hashMap->freeVal != NULL && hashMap->slots[slot].val != NULL) {
+        hashMap->freeVal(hashMap->slots[slot].val);
+    }
+
+    if (ctrlErase(hashMap->ctrl, slot)) {
+        hashMap->growthLeft++;
+    }
+    hashMap->size--;
+}
+
+/* 从 start 开始查找下一个已占用槽位，没有则返回 capacity */
+static size_t nextFullSlot(const HashMapFlat *hashMap, size_t start) {
+    for (size_t i = start; i < hashMap->capacity; i++) {
+        if (slotIsFull(hashMap, i)) {
+            return i;
+        }
+    }
+    return hashMap->capacity;
+}
+
+/* 创建开放寻址哈希表 */
+HashMapFlat *newHashMapFlat(size_t capacity, void (*freeVal)(void*)) {
+    if (capacity == 0) {
+        return NULL;
+    }
+    HashMapFlat *hashMap = (HashMapFlat *)malloc(sizeof(HashMapFlat));
+    if (hashMap == NULL) {
+        return NULL;
+    }
+
+    size_t slots = GROUP_WIDTH;
+    while (slots < capacity) {
+        slots *= 2;
+    }
+
+    hashMap->size = 0;
+    hashMap->freeVal = freeVal;
+    if (!allocSlots(hashMap, slots)) {
+        free(hashMap);
+        return NULL;
+    }
+    return hashMap;
+}
+
+/* 删除开放寻址哈希表 */
+void delHashMapFlat(HashMapFlat *hashMap) {
+    if (hashMap == NULL) {
+        return;
+    }
+
+    if (hashMap->freeVal != NULL) {
+        for (size_t i = 0; i < hashMap->capacity; i++) {
+            if (slotIsFull(hashMap, i) && hashMap->slots[i].val != NULL) {
+                hashMap->freeVal(hashMap->slots[i].val);
+            }
+        }
+    }
+    free(hashMap->ctrl);
+    free(hashMap->slots);
+    free(hashMap);
+}
+
+/* 查找操作 */
+void *flatGet(HashMapFlat *hashMap, int key) {
+    if (hashMap == NULL) {
+        return NULL;
+    }
+
+    size_t slot = findSlot(hashMap, key, flatHash(key));
+    if (slot == SLOT_NOT_FOUND) {
+        return NULL;
+    }
+    return hashMap->slots[slot].val;
+}
+
+/* 添加操作 */
+void flatPut(HashMapFlat *hashMap, int key, const void *val) {
+    if (hashMap == NULL || val == NULL) {
+        return;
+    }
+
+    uint64_t hash = flatHash(key);
+    size_t slot = findSlot(hashMap, key, hash);
+    if (slot != SLOT_NOT_FOUND) {
+        // 注意：这里假设调用者已经正确管理了旧val指向的内存
+        hashMap->slots[slot].val = (void *)val;
+        return;
+    }
+
+    slot = findInsertSlot(hashMap, hash);
+    // 复用墓碑不消耗空槽位，只有占用空槽位时才需要检查是否扩容
+    if (slot == SLOT_NOT_FOUND || (hashMap->ctrl[slot] == CTRL_EMPTY && hashMap->growthLeft == 0)) {
+        if (!grow(hashMap)) {
+            return; // 内存分配失败
+        }
+        slot = findInsertSlot(hashMap, hash);
+    }
+
+    if (hashMap->ctrl[slot] == CTRL_EMPTY) {
+        hashMap->growthLeft--;
+    }
+    hashMap->ctrl[slot] = hashH2(hash);
+    hashMap->slots[slot].key = key;
+    hashMap->slots[slot].val = (void *)val;
+    hashMap->size++;
+}
+
+/* 删除操作 */
+void flatRemoveItem(HashMapFlat *hashMap, int key) {
+    if (hashMap == NULL) {
+        return;
+    }
+
+    size_t slot = findSlot(hashMap, key, flatHash(key));
+    if (slot != SLOT_NOT_FOUND) {
+        eraseSlot(hashMap, slot);
+    }
+}
+
+/* 获取键值对数量 */
+size_t flatSize(HashMapFlat *hashMap) {
+    return hashMap == NULL ? 0 : hashMap->size;
+}
+
+/* 获取槽位数量 */
+size_t flatCapacity(HashMapFlat *hashMap) {
+    return hashMap == NULL ? 0 : hashMap->capacity;
+}
+
+/* 初始化哈希表迭代器 */
+HashMapFlatIterator flatInitIterator(HashMapFlat *hashMap) {
+    HashMapFlatIterator iterator;
+    iterator.hashMap = hashMap;
+    iterator.slotIndex = 0;
+    iterator.hasNext = false;
+
+    if (hashMap != NULL && hashMap->size > 0) {
+        iterator.slotIndex = nextFullSlot(hashMap, 0);
+        iterator.hasNext = iterator.slotIndex < hashMap->capacity;
+    }
+    return iterator;
+}
+
+/* 判断迭代器是否有下一个元素 */
+bool flatHasNext(HashMapFlatIterator *iterator) {
+    if (iterator == NULL) {
+        return false;
+    }
+    return iterator->hasNext;
+}
+
+/* 获取迭代器当前元素的键 */
+int flatGetKey(HashMapFlatIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return -1;
+    }
+    return iterator->hashMap->slots[iterator->slotIndex].key;
+}
+
+/* 获取迭代器当前元素的值 */
+void *flatGetValue(HashMapFlatIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return NULL;
+    }
+    return iterator->hashMap->slots[iterator->slotIndex].val;
+}
+
+/* 将迭代器移动到下一个元素 */
+void flatNext(HashMapFlatIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return;
+    }
+
+    iterator->slotIndex = nextFullSlot(iterator->hashMap, iterator->slotIndex + 1);
+    iterator->hasNext = iterator->slotIndex < iterator->hashMap->capacity;
+}
+
+/* 删除迭代器当前指向的键值对 */
+void flatRemoveCurrent(HashMapFlatIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return;
+    }
+
+    // 删除不会移动其它槽位，直接前进即可
+    eraseSlot(iterator->hashMap, iterator->slotIndex);
+    flatNext(iterator);
+}
@@ -0,0 +1,136 @@
+#ifndef HASH_MAP_FLAT_H
+#define HASH_MAP_FLAT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define HASH_MAP_FLAT_GROUP_WIDTH 16      // 每组控制字节数量（一次SIMD扫描的槽位数）
+#define HASH_MAP_FLAT_MAX_LOAD_NUM 7      // 最大负载因子分子：7/8
+#define HASH_MAP_FLAT_MAX_LOAD_DEN 8      // 最大负载因子分母
+
+/* 开放寻址哈希表（Swiss table），键值存放在连续的槽位数组中 */
+typedef struct HashMapFlat HashMapFlat;
+
+/* 开放寻址哈希表迭代器 */
+typedef struct {
+    HashMapFlat *hashMap;  // 迭代器所属的哈希表
+    size_t slotIndex;      // 当前槽位索引
+    bool hasNext;          // 是否有下一个元素
+} HashMapFlatIterator;
+
+/**
+ * @brief 创建一个新的 HashMapFlat 对象
+ *
+ * 槽位数量会向上取整为 2 的幂且不小于一组控制字节的宽度。
+ *
+ * @param capacity 期望的槽位数量，必须大于0。
+ * @param freeVal val 值释放函数指针，用于释放存储在哈希表中的值。如果不需要释放，可以传递 NULL。
+ *
+ * @return 成功时返回新创建的 HashMapFlat 对象指针，失败时返回 NULL。
+ */
+HashMapFlat *newHashMapFlat(size_t capacity, void (*freeVal)(void*));
+
+/**
+ * @brief 删除开放寻址哈希表
+ *
+ * 删除哈希表中的所有键值对，并释放哈希表所占用的内存。
+ *
+ * @param hashMap 哈希表的指针
+ */
+void delHashMapFlat(HashMapFlat *hashMap);
+
+/**
+ * @brief 根据键从哈希表中获取值
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要查找的键
+ *
+ * @return 返回与键对应的值，如果键不存在则返回NULL
+ */
+void *flatGet(HashMapFlat *hashMap, int key);
+
+/**
+ * @brief 添加键值对到哈希表
+ *
+ * 向哈希表中添加一个键值对。如果键已存在，则更新对应的值。
+ * 当已用槽位超过 7/8 时自动扩容。
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要添加的键
+ * @param val 要添加的值，不能为NULL
+ */
+void flatPut(HashMapFlat *hashMap, int key, const void *val);
+
+/**
+ * @brief 从哈希表中删除键值对
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要删除的键
+ */
+void flatRemoveItem(HashMapFlat *hashMap, int key);
+
+/**
+ * @brief 获取哈希表中的键值对数量
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回键值对数量
+ */
+size_t flatSize(HashMapFlat *hashMap);
+
+/**
+ * @brief 获取哈希表的槽位数量
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回槽位数量
+ */
+size_t flatCapacity(HashMapFlat *hashMap);
+
+/**
+ * @brief 初始化哈希表迭代器
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回初始化后的迭代器
+ */
+HashMapFlatIterator flatInitIterator(HashMapFlat *hashMap);
+
+/**
+ * @brief 判断迭代器是否有下一个元素
+ *
+ * @param iterator 迭代器的指针
+ * @return 如果有下一个元素，则返回true；否则返回false
+ */
+bool flatHasNext(HashMapFlatIterator *iterator);
+
+/**
+ * @brief 获取迭代器当前元素的键
+ *
+ * @param iterator 迭代器的指针
+ * @return 返回当前键值对的键
+ */
+int flatGetKey(HashMapFlatIterator *iterator);
+
+/**
+ * @brief 获取迭代器当前元素的值
+ *
+ * @param iterator 迭代器的指针
+ * @return 返回当前键值对的值
+ */
+void *flatGetValue(HashMapFlatIterator *iterator);
+
+/**
+ * @brief 将迭代器移动到下一个元素
+ *
+ * @param iterator 迭代器的指针
+ */
+void flatNext(HashMapFlatIterator *iterator);
+
+/**
+ * @brief 删除迭代器当前指向的键值对
+ *
+ * 删除后迭代器自动移动到下一个元素，不需要再调用 flatNext。
+ *
+ * @param iterator 迭代器指针
+ */
+void flatRemoveCurrent(HashMapFlatIterator *iterator);
+
+#endif // HASH_MAP_FLAT_H
@@ -0,0 +1,131 @@
+#ifndef HASH_MAP_FLAT_GROUP_H
+#define HASH_MAP_FLAT_GROUP_H
+
+/*
+ * Swiss table 控制字节组的匹配与哈希值拆分
+ *
+ * HashMapFlat 与 HashSet 共用的内部实现，不属于公开API。
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hash_map_flat.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HASH_MAP_FLAT_USE_SSE2 1
+#else
+#define HASH_MAP_FLAT_USE_SSE2 0
+#endif
+
+/*
+ * 控制字节：
+ *   0x00 ~ 0x7F  槽位已占用，低7位为哈希值的 H2 部分
+ *   0x80         空槽位（EMPTY）
+ *   0xFE         已删除槽位（DELETED，墓碑）
+ * 空槽位与墓碑的最高位都为1，已占用槽位最高位为0。
+ */
+#define CTRL_EMPTY   ((uint8_t)0x80)
+#define CTRL_DELETED ((uint8_t)0xFE)
+
+#define GROUP_WIDTH HASH_MAP_FLAT_GROUP_WIDTH
+#define SLOT_NOT_FOUND ((size_t)-1)
+
+/* 一组控制字节的匹配结果，第 i 位为1表示第 i 个槽位匹配 */
+typedef uint32_t GroupMask;
+
+/* 哈希值高位用于定位组，低7位作为控制字节 */
+static inline size_t hashH1(uint64_t hash) {
+    return (size_t)(hash >> 7);
+}
+
+static inline uint8_t hashH2(uint64_t hash) {
+    return (uint8_t)(hash & 0x7F);
+}
+
+/* 取最低位1的位置 */
+static inline unsigned lowestBit(GroupMask mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned i = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/* 在一组控制字节中查找等于 h2 的槽位 */
+static inline GroupMask groupMatch(const uint8_t *ctrl, uint8_t h2) {
+#if HASH_MAP_FLAT_USE_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i *)(const void *)ctrl);
+    return (GroupMask)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)h2)));
+#else
+    GroupMask mask = 0;
+    for (unsigned i = 0; i < GROUP_WIDTH; i++) {
+        if (ctrl[i] == h2) {
+            mask |= (GroupMask)1 << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+/* 在一组控制字节中查找空槽位 */
+static inline GroupMask groupMatchEmpty(const uint8_t *ctrl) {
+#if HASH_MAP_FLAT_USE_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i *)(const void *)ctrl);
+    return (GroupMask)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)CTRL_EMPTY)));
+#else
+    return groupMatch(ctrl, CTRL_EMPTY);
+#endif
+}
+
+/* 在一组控制字节中查找空槽位或墓碑（最高位为1） */
+static inline GroupMask groupMatchEmptyOrDeleted(const uint8_t *ctrl) {
+#if HASH_MAP_FLAT_USE_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i *)(const void *)ctrl);
+    return (GroupMask)_mm_movemask_epi8(group);
+#else
+    GroupMask mask = 0;
+    for (unsigned i = 0; i < GROUP_WIDTH; i++) {
+        if (ctrl[i] & 0x80) {
+            mask |= (GroupMask)1 << i;
+        }
+    }
+    return mask;
+#endif
+}
+
+/* 沿探测序列查找第一个可插入的槽位（空槽位或墓碑） */
+static inline size_t ctrlFindInsertSlot(const uint8_t *ctrl, size_t capacity, uint64_t hash) {
+    size_t groupMask = capacity / GROUP_WIDTH - 1;
+    size_t group = hashH1(hash) & groupMask;
+
+    for (size_t step = 1; step <= groupMask + 1; step++) {
+        GroupMask mask = groupMatchEmptyOrDeleted(ctrl + group * GROUP_WIDTH);
+        if (mask) {
+            return group * GROUP_WIDTH + lowestBit(mask);
+        }
+        group = (group + step) & groupMask;
+    }
+    return SLOT_NOT_FOUND;
+}
+
+/*
+ * 把槽位标记为删除，槽位变为空槽位时返回true。
+ * 所在组内已有空槽位时，任何探测都不会越过该组，可以直接标记为空，否则留下墓碑。
+ */
+static inline bool ctrlErase(uint8_t *ctrl, size_t slot) {
+    if (groupMatchEmpty(ctrl + slot / GROUP_WIDTH * GROUP_WIDTH)) {
+        ctrl[slot] = CTRL_EMPTY;
+        return true;
+    }
+    ctrl[slot] = CTRL_DELETED;
+    return false;
+}
+
+#endif // HASH_MAP_FLAT_GROUP_H
@@ -0,0 +1,208 @@
+#ifndef HASH_MAP_GEN_H
+#define HASH_MAP_GEN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hash_func.h"
+
+/*
+ * 类型特化哈希表生成器（只有头文件）
+ *
+ * HASHMAP_DECLARE(name, KeyT, ValT, hashFn, eqFn) 生成一个键类型为 KeyT、值类型为 ValT 的哈希表，
+ * 所有函数都是 static inline，hashFn(key) 和 eqFn(a, b) 在展开处直接调用，编译器可以把整个探测循环内联，
+ * 键和值按原生宽度存放在各自的连续数组中，不经过 void* 和函数指针。
+ *
+ * 布局：线性探测的开放寻址表，容量为 2 的幂，最大负载因子 HASHMAP_GEN_LOAD_NUM / HASHMAP_GEN_LOAD_DEN。
+ * 每个槽位有一个控制字节，0 表示空，否则为 0x80 | 哈希值最高 7 位，查找时先比较控制字节再调用 eqFn。
+ * 删除采用向后移位，不留墓碑。
+ *
+ * 生成的接口（以 name = IntMap 为例）：
+ *   bool IntMap_init(IntMap *map, size_t capacity);       初始化，失败返回false
+ *   void IntMap_destroy(IntMap *map);                     释放内存
+ *   ValT *IntMap_get(IntMap *map, KeyT key);              返回值的地址，不存在返回NULL
+ *   ValT *IntMap_put(IntMap *map, KeyT key, ValT val);    插入或覆盖，返回值的地址，内存不足返回NULL
+ *   bool IntMap_remove(IntMap *map, KeyT key);            删除，键存在时返回true
+ *   size_t IntMap_size(const IntMap *map);
+ *   遍历：for (size_t i = IntMap_begin(map); i < IntMap_end(map); i = IntMap_next(map, i))
+ *         { IntMap_key(map, i); IntMap_val(map, i); }
+ *
+ * 内存通过 HASHMAP_GEN_MALLOC / HASHMAP_GEN_FREE 分配，默认为展开处的 malloc / free，
+ * 因此包含 utility.h 后同样经过内存检测。
+ */
+
+#define HASHMAP_GEN_MIN_CAPACITY 16
+#define HASHMAP_GEN_LOAD_NUM 3   // 最大负载因子分子：3/4
+#define HASHMAP_GEN_LOAD_DEN 4   // 最大负载因子分母
+
+#ifndef HASHMAP_GEN_MALLOC
+#define HASHMAP_GEN_MALLOC(size) malloc(size)
+#endif
+#ifndef HASHMAP_GEN_FREE
+#define HASHMAP_GEN_FREE(ptr) free(ptr)
+#endif
+
+/* 按值比较的相等函数，hashFn 可以直接使用 hash_func.h 中的 hashMurmur（int）或 hashMurmur64（uint64_t） */
+#define HASHMAP_GEN_EQ(a, b) ((a) == (b))
+
+#define HASHMAP_DECLARE(name, KeyT, ValT, hashFn, eqFn)                                             \
+    typedef struct {                                                                                \
+        size_t size;      /* 键值对数量 */                                                          \
+        size_t mask;      /* 容量 - 1 */                                                            \
+        size_t growAt;    /* 键值对数量达到该值时扩容 */                                            \
+        uint8_t *ctrl;    /* 控制字节 */                                                            \
+        KeyT *keys;                                                                                 \
+        ValT *vals;                                                                                 \
+    } name;                                                                                         \
+                                                                                                    \
+    static inline uint8_t name##_tag(uint64_t hash) {                                               \
+        return (uint8_t)(0x80u | (unsigned)(hash >> 57));                                           \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_alloc(name *map, size_t capacity) {                                   \
+        map->ctrl = (uint8_t *)HASHMAP_GEN_MALLOC(capacity);                                        \
+        map->keys = (KeyT *)HASHMAP_GEN_MALLOC(capacity * sizeof(KeyT));                            \
+        map->vals = (ValT *)HASHMAP_GEN_MALLOC(capacity * sizeof(ValT));                            \
+        if (map->ctrl == NULL || map->keys == NULL || map->vals == NULL) {                          \
+            if (map->ctrl != NULL) HASHMAP_GEN_FREE(map->ctrl);                                     \
+            if (map->keys != NULL) HASHMAP_GEN_FREE(map->keys);                                     \
+            if (map->vals != NULL) HASHMAP_GEN_FREE(map->vals);                                     \
+            return false;                                                                           \
+        }                                                                                           \
+        memset(map->ctrl, 0, capacity);                                                             \
+        map->mask = capacity - 1;                                                                   \
+        map->growAt = capacity / HASHMAP_GEN_LOAD_DEN * HASHMAP_GEN_LOAD_NUM;                       \
+        return true;                                                                                \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_init(name *map, size_t capacity) {                                    \
+        size_t slots = HASHMAP_GEN_MIN_CAPACITY;                                                    \
+        while (slots / HASHMAP_GEN_LOAD_DEN * HASHMAP_GEN_LOAD_NUM < capacity) {                    \
+            slots *= 2;                                                                             \
+        }                                                                                           \
+        map->size = 0;                                                                              \
+        return name##_alloc(map, slots);                                                            \
+    }                                                                                               \
+                                                                                                    \
+    static inline void name##_destroy(name *map) {                                                  \
+        HASHMAP_GEN_FREE(map->ctrl);                                                                \
+        HASHMAP_GEN_FREE(map->keys);                                                                \
+        HASHMAP_GEN_FREE(map->vals);                                                                \
+        map->ctrl = NULL;                                                                           \
+        map->keys = NULL;                                                                           \
+        map->vals = NULL;                                                                           \
+        map->size = 0;                                                                              \
+    }                                                                                               \
+                                                                                                    \
+    /* 查找键所在槽位，不存在时返回容量 */                                                          \
+    static inline size_t name##_find(const name *map, KeyT key) {                                   \
+        uint64_t hash = hashFn(key);                                                                \
+        uint8_t tag = name##_tag(hash);                                                             \
+        for (size_t i = (size_t)hash & map->mask;; i = (i + 1) & map->mask) {                       \
+            uint8_t c = map->ctrl[i];                                                               \
+            if (c == 0) {                                                                           \
+                return map->mask + 1;                                                               \
+            }                                                                                       \
+            if (c == tag && eqFn(map->keys[i], key)) {                                              \
+                return i;                                                                           \
+            }                                                                                       \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    static inline ValT *name##_get(name *map, KeyT key) {                                           \
+        size_t i = name##_find(map, key);                                                           \
+        return i <= map->mask ? &map->vals[i] : NULL;                                               \
+    }                                                                                               \
+                                                                                                    \
+    /* 把键值对放入第一个空槽位，调用前已确认键不存在且有空槽位 */                                  \
+    static inline size_t name##_place(name *map, KeyT key, ValT val, uint64_t hash) {               \
+        size_t i = (size_t)hash & map->mask;                                                        \
+        while (map->ctrl[i] != 0) {                                                                 \
+            i = (i + 1) & map->mask;                                                                \
+        }                                                                                           \
+        map->ctrl[i] = name##_tag(hash);                                                            \
+        map->keys[i] = key;                                                                         \
+        map->vals[i] = val;                                                                         \
+        return i;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline bool name##_grow(name *map) {                                                     \
+        name old = *map;                                                                            \
+        if (!name##_alloc(map, (old.mask + 1) * 2)) {                                               \
+            *map = old;                                                                             \
+            return false;                                                                           \
+        }                                                                                           \
+        for (size_t i = 0; i <= old.mask; i++) {                                                    \
+            if (old.ctrl[i] != 0) {                                                                 \
+                name##_place(map, old.keys[i], old.vals[i], hashFn(old.keys[i]));                   \
+            }                                                                                       \
+        }                                                                                           \
+        HASHMAP_GEN_FREE(old.ctrl);                                                                 \
+        HASHMAP_GEN_FREE(old.keys);                                                                 \
+        HASHMAP_GEN_FREE(old.vals);                                                                 \
+        return true;                                                                                \
+    }                                                                                               \
+                                                                                                    \
+    static inline ValT *name##_put(name *map, KeyT key, ValT val) {                                 \
+        size_t i = name##_find(map, key);                                                           \
+        if (i <= map->mask) {                                                                       \
+            map->vals[i] = val;                                                                     \
+            return &map->vals[i];                                                                   \
+        }                                                                                           \
+        if (map->size >= map->growAt && !name##_grow(map)) {                                        \
+            return NULL;                                                                            \
+        }                                                                                           \
+        map->size++;                                                                                \
+        return &map->vals[name##_place(map, key, val, hashFn(key))];                                \
+    }                                                                                               \
+                                                                                                    \
+    /* 向后移位删除：把后面本应更靠前的槽位前移，保持探测序列连续 */                                \
+    static inline bool name##_remove(name *map, KeyT key) {                                         \
+        size_t hole = name##_find(map, key);                                                        \
+        if (hole > map->mask) {                                                                     \
+            return false;                                                                           \
+        }                                                                                           \
+        for (size_t i = (hole + 1) & map->mask; map->ctrl[i] != 0; i = (i + 1) & map->mask) {       \
+            size_t home = (size_t)hashFn(map->keys[i]) & map->mask;                                 \
+            /* home 不在 (hole, i] 之间时，该键可以移动到空位 */                                    \
+            if (((i - home) & map->mask) >= ((i - hole) & map->mask)) {                             \
+                map->ctrl[hole] = map->ctrl[i];                                                     \
+                map->keys[hole] = map->keys[i];                                                     \
+                map->vals[hole] = map->vals[i];                                                     \
+                hole = i;                                                                           \
+            }                                                                                       \
+        }                                                                                           \
+        map->ctrl[hole] = 0;                                                                        \
+        map->size--;                                                                                \
+        return true;                                                                                \
+    }                                                                                               \
+                                                                                                    \
+    static inline size_t name##_size(const name *map) {                                             \
+        return map->size;                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    static inline size_t name##_end(const name *map) {                                              \
+        return map->mask + 1;                                                                       \
+    }                                                                                               \
+                                                                                                    \
+    static inline size_t name##_next(const name *map, size_t i) {                                   \
+        for (i++; i <= map->mask && map->ctrl[i] == 0; i++) {                                       \
+        }                                                                                           \
+        return i;                                                                                   \
+    }                                                                                               \
+                                                                                                    \
+    static inline size_t name##_begin(const name *map) {                                            \
+        return map->ctrl[0] != 0 ? 0 : name##_next(map, 0);                                         \
+    }                                                                                               \
+                                                                                                    \
+    static inline KeyT name##_key(const name *map, size_t i) {                                      \
+        return map->keys[i];                                                                        \
+    }                                                                                               \
+                                                                                                    \
+    static inline ValT *name##_val(name *map, size_t i) {                                           \
+        return &map->vals[i];                                                                       \
+    }
+
+#endif // HASH_MAP_GEN_H
@@ -0,0 +1,336 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash_map_ordered.h"
+#include "hash_func.h"
+#include "utility.h"
+
+/*
+ * 索引表槽位：
+ *   INDEX_EMPTY    空槽位，探测到此结束
+ *   INDEX_DUMMY    已删除，探测需要继续
+ *   其它值         条目数组下标
+ */
+#define INDEX_EMPTY UINT32_MAX
+#define INDEX_DUMMY (UINT32_MAX - 1)
+#define INDEX_NOT_FOUND ((size_t)-1)
+
+/* 条目：val 为 NULL 表示墓碑 */
+typedef struct {
+    int key;
+    void *val;
+} OrderedEntry;
+
+/* 保持插入顺序的紧凑哈希表 */
+struct HashMapOrdered {
+    size_t size;            // 键值对数量
+    size_t used;            // 条目数组中已使用的条目数量，含墓碑
+    size_t entryCapacity;   // 条目数组容量，为索引表槽位数量的 2/3
+    size_t indexCapacity;   // 索引表槽位数量，2 的幂
+
+    OrderedEntry *entries;  // 按插入顺序排列的条目数组
+    uint32_t *index;        // 索引表，保存条目下标
+    void (*freeVal)(void*); // 释放val的回调函数，如果为NULL则不释放
+};
+
+static inline uint64_t orderedHash(int key) {
+    return hashMurmur(key);
+}
+
+/* 查找键所在的索引表槽位，未找到返回 INDEX_NOT_FOUND */
+static size_t findIndex(const HashMapOrdered *hashMap, int key) {
+    size_t mask = hashMap->indexCapacity - 1;
+    // 条目数量不超过槽位数量的 2/3，探测一定会遇到空槽位
+    for (size_t i = (size_t)orderedHash(key) & mask;; i = (i + 1) & mask) {
+        uint32_t ix = hashMap->index[i];
+        if (ix == INDEX_EMPTY) {
+            return INDEX_NOT_FOUND;
+        }
+        if (ix != INDEX_DUMMY && hashMap->entries[ix].key == key) {
+            return i;
+        }
+    }
+}
+
+/* 沿探测序列查找第一个可插入的槽位（空槽位或已删除槽位） */
+static size_t findInsertIndex(const HashMapOrdered *hashMap, int key) {
+    size_t mask = hashMap->indexCapacity - 1;
+    size_t i = (size_t)orderedHash(key) & mask;
+    while (hashMap->index[i] != INDEX_EMPTY && hashMap->index[i] != INDEX_DUMMY) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+/*
+ * 以指定的索引表大小重建哈希表，同时移除所有墓碑
+ *
+ * position 不为 NULL 时，把它从旧条目下标换算为压缩后的下标（即它之前的有效条目数量）。
+ * 失败时哈希表保持不变。
+ */
+static bool rebuild(HashMapOrdered *hashMap, size_t indexCapacity, size_t *position) {
+    size_t entryCapacity = indexCapacity * 2 / 3;
+    uint32_t *index = (uint32_t *)malloc(indexCapacity * sizeof(uint32_t));
+    if (index == NULL) {
+        return false;
+    }
+    OrderedEntry *entries = hashMap->entries;
+    if (entryCapacity != hashMap->entryCapacity) {
+        entries = (OrderedEntry *)malloc(entryCapacity * sizeof(OrderedEntry));
+        if (entries == NULL) {
+            free(index);
+            return false;
+        }
+    }
+    memset(index, 0xFF, indexCapacity * sizeof(uint32_t));
+
+    // 按原顺序搬运有效条目；原地压缩时写入位置总是不超过读取位置
+    size_t count = 0;
+    size_t newPosition = 0;
+    for (size_t i = 0; i < hashMap->used; i++) {
+        if (position != NULL && i == *position) {
+            newPosition = count;
+        }
+        if (hashMap->entries[i].val == NULL) {
+            continue;
+        }
+        entries[count] = hashMap->entries[i];
+        count++;
+    }
+    if (position != NULL) {
+        *position = *position >= hashMap->used ? count : newPosition;
+    }
+
+    if (entries != hashMap->entries) {
+        free(hashMap->entries);
+    }
+    free(hashMap->index);
+    hashMap->entries = entries;
+    hashMap->index = index;
+    hashMap->entryCapacity = entryCapacity;
+    hashMap->indexCapacity = indexCapacity;
+    hashMap->used = count;
+    for (size_t i = 0; i < count; i++) {
+        index[findInsertIndex(hashMap, entries[i].key)] = (uint32_t)i;
+    }
+    return true;
+}
+
+/* 条目数组用尽时调用：墓碑较多则原地压缩，否则容量翻倍 */
+static bool grow(HashMapOrdered *hashMap) {
+    size_t indexCapacity = hashMap->indexCapacity;
+    if (hashMap->size * 2 >= hashMap->used) {
+        // 条目下标必须小于 INDEX_DUMMY
+        if (indexCapacity > (size_t)INDEX_DUMMY) {
+            return false;
+        }
+        indexCapacity *= 2;
+    }
+    return rebuild(hashMap, indexCapacity, NULL);
+}
+
+/* 墓碑超过已用条目的一半时压缩，position 的含义同 rebuild */
+static void compactIfSparse(HashMapOrdered *hashMap, size_t *position) {
+    size_t tombstones = hashMap->used - hashMap->size;
+    if (tombstones >= HASH_MAP_ORDERED_MIN_COMPACT && tombstones * 2 > hashMap->used) {
+        // 压缩失败只影响遍历速度
+        rebuild(hashMap, hashMap->indexCapacity, position);
+    }
+}
+
+/* 删除索引表槽位 slot 指向的键值对，条目数组中留下墓碑 */
+static void eraseIndex(HashMapOrdered *hashMap, size_t slot) {
+    OrderedEntry *entry = &hashMap->entries[hashMap->index[slot]];
+    if (hashMap->freeVal != NULL) {
+        hashMap->freeVal(entry->val);
+    }
+    entry->val = NULL;
+    hashMap->index[slot] = INDEX_DUMMY;
+    hashMap->size--;
+}
+
+/* 从 start 开始查找下一个有效条目，没有则返回 used */
+static size_t nextLiveEntry(const HashMapOrdered *hashMap, size_t start) {
+    for (size_t i = start; i < hashMap->used; i++) {
+        if (hashMap->entries[i].val != NULL) {
+            return i;
+        }
+    }
+    return hashMap->used;
+}
+
+/* 创建有序哈希表 */
+HashMapOrdered *newHashMapOrdered(size_t capacity, void (*freeVal)(void*)) {
+    if (capacity == 0) {
+        return NULL;
+    }
+    HashMapOrdered *hashMap = (HashMapOrdered *)malloc(sizeof(HashMapOrdered));
+    if (hashMap == NULL) {
+        return NULL;
+    }
+
+    size_t indexCapacity = HASH_MAP_ORDERED_MIN_INDEX;
+    while (indexCapacity * 2 / 3 < capacity) {
+        indexCapacity *= 2;
+    }
+
+    hashMap->size = 0;
+    hashMap->used = 0;
+    hashMap->entryCapacity = 0;
+    hashMap->indexCapacity = 0;
+    hashMap->entries = NULL;
+    hashMap->index = NULL;
+    hashMap->freeVal = freeVal;
+    if (!rebuild(hashMap, indexCapacity, NULL)) {
+        free(hashMap);
+        return NULL;
+    }
+    return hashMap;
+}
+
+/* 删除有序哈希表 */
+void delHashMapOrdered(HashMapOrdered *hashMap) {
+    if (hashMap == NULL) {
+        return;
+    }
+
+    if (hashMap->freeVal != NULL) {
+        for (size_t i = 0; i < hashMap->used; i++) {
+            if (hashMap->entries[i].val != NULL) {
+                hashMap->freeVal(hashMap->entries[i].val);
+            }
+        }
+    }
+    free(hashMap->entries);
+    free(hashMap->index);
+    free(hashMap);
+}
+
+/* 查找操作 */
+void *orderedGet(HashMapOrdered *hashMap, int key) {
+    if (hashMap == NULL) {
+        return NULL;
+    }
+
+    size_t slot = findIndex(hashMap, key);
+    if (slot == INDEX_NOT_FOUND) {
+        return NULL;
+    }
+    return hashMap->entries[hashMap->index[slot]].val;
+}
+
+/* 添加操作 */
+void orderedPut(HashMapOrdered *hashMap, int key, const void *val) {
+    if (hashMap == NULL || val == NULL) {
+        return;
+    }
+
+    size_t slot = findIndex(hashMap, key);
+    if (slot != INDEX_NOT_FOUND) {
+        // 注意：这里假设调用者已经正确管理了旧val指向的内存
+        hashMap->entries[hashMap->index[slot]].val = (void *)val;
+        return;
+    }
+
+    if (hashMap->used == hashMap->entryCapacity && !grow(hashMap)) {
+        return; // 内存分配失败
+    }
+    size_t i = hashMap->used++;
+    hashMap->entries[i].key = key;
+    hashMap->entries[i].val = (void *)val;
+    hashMap->index[findInsertIndex(hashMap, key)] = (uint32_t)i;
+    hashMap->size++;
+}
+
+/* 删除操作 */
+void orderedRemoveItem(HashMapOrdered *hashMap, int key) {
+    if (hashMap == NULL) {
+        return;
+    }
+
+    size_t slot = findIndex(hashMap, key);
+    if (slot != INDEX_NOT_FOUND) {
+        eraseIndex(hashMap, slot);
+        compactIfSparse(hashMap, NULL);
+    }
+}
+
+/* 获取键值对数量 */
+size_t orderedSize(HashMapOrdered *hashMap) {
+    return hashMap == NULL ? 0 : hashMap->size;
+}
+
+/* 获取已使用的条目数量 */
+size_t orderedUsed(HashMapOrdered *hashMap) {
+    return hashMap == NULL ? 0 : hashMap->used;
+}
+
+/* 压缩条目数组 */
+void orderedCompact(HashMapOrdered *hashMap) {
+    if (hashMap != NULL && hashMap->used > hashMap->size) {
+        rebuild(hashMap, hashMap->indexCapacity, NULL);
+    }
+}
+
+/* 初始化哈希表迭代器 */
+HashMapOrderedIterator orderedInitIterator(HashMapOrdered *hashMap) {
+    HashMapOrderedIterator iterator;
+    iterator.hashMap = hashMap;
+    iterator.entryIndex = 0;
+    iterator.hasNext = false;
+
+    if (hashMap != NULL && hashMap->size > 0) {
+        iterator.entryIndex = nextLiveEntry(hashMap, 0);
+        iterator.hasNext = iterator.entryIndex < hashMap->used;
+    }
+    return iterator;
+}
+
+/* 判断迭代器是否有下一个元素 */
+bool orderedHasNext(HashMapOrderedIterator *iterator) {
+    if (iterator == NULL) {
+        return false;
+    }
+    return iterator->hasNext;
+}
+
+/* 获取迭代器当前元素的键 */
+int orderedGetKey(HashMapOrderedIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return -1;
+    }
+    return iterator->hashMap->entries[iterator->entryIndex].key;
+}
+
+/* 获取迭代器当前元素的值 */
+void *orderedGetValue(HashMapOrderedIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return NULL;
+    }
+    return iterator->hashMap->entries[iterator->entryIndex].val;
+}
+
+/* 将迭代器移动到下一个元素 */
+void orderedNext(HashMapOrderedIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return;
+    }
+
+    iterator->entryIndex = nextLiveEntry(iterator->hashMap, iterator->entryIndex + 1);
+    iterator->hasNext = iterator->entryIndex < iterator->hashMap->used;
+}
+
+/* 删除迭代器当前指向的键值对 */
+void orderedRemoveCurrent(HashMapOrderedIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return;
+    }
+
+    HashMapOrdered *hashMap = iterator->hashMap;
+    eraseIndex(hashMap, findIndex(hashMap, hashMap->entries[iterator->entryIndex].key));
+    iterator->entryIndex = nextLiveEntry(hashMap, iterator->entryIndex + 1);
+
+    // 压缩保持顺序，迭代器的位置换算为压缩后的下标
+    compactIfSparse(hashMap, &iterator->entryIndex);
+    iterator->hasNext = iterator->entryIndex < hashMap->used;
+}
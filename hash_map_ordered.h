@@ -0,0 +1,157 @@
+#ifndef HASH_MAP_ORDERED_H
+#define HASH_MAP_ORDERED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define HASH_MAP_ORDERED_MIN_INDEX 8        // 索引表的最小槽位数量
+#define HASH_MAP_ORDERED_MIN_COMPACT 16     // 墓碑少于该数量时不压缩
+
+/*
+ * 保持插入顺序的紧凑哈希表
+ *
+ * 键值对按插入顺序存放在连续的条目数组中，另有一个只保存条目下标的索引表（开放寻址）。
+ * 遍历只需顺序扫描条目数组，耗时与键值对数量成正比，与索引表大小无关，顺序确定。
+ * 删除只在条目数组中留下墓碑，墓碑超过已用条目的一半时压缩条目数组并重建索引表。
+ */
+typedef struct HashMapOrdered HashMapOrdered;
+
+/* 有序哈希表迭代器 */
+typedef struct {
+    HashMapOrdered *hashMap;  // 迭代器所属的哈希表
+    size_t entryIndex;        // 当前条目下标
+    bool hasNext;             // 是否有下一个元素
+} HashMapOrderedIterator;
+
+/**
+ * @brief 创建一个新的 HashMapOrdered 对象
+ *
+ * 索引表槽位数量为 2 的幂，条目数组容量为其 2/3。
+ *
+ * @param capacity 预计的键值对数量，必须大于0。
+ * @param freeVal val 值释放函数指针，用于释放存储在哈希表中的值。如果不需要释放，可以传递 NULL。
+ *
+ * @return 成功时返回新创建的 HashMapOrdered 对象指针，失败时返回 NULL。
+ */
+HashMapOrdered *newHashMapOrdered(size_t capacity, void (*freeVal)(void*));
+
+/**
+ * @brief 删除有序哈希表
+ *
+ * 删除哈希表中的所有键值对，并释放哈希表所占用的内存。
+ *
+ * @param hashMap 哈希表的指针
+ */
+void delHashMapOrdered(HashMapOrdered *hashMap);
+
+/**
+ * @brief 根据键从哈希表中获取值
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要查找的键
+ *
+ * @return 返回与键对应的值，如果键不存在则返回NULL
+ */
+void *orderedGet(HashMapOrdered *hashMap, int key);
+
+/**
+ * @brief 添加键值对到哈希表
+ *
+ * 新键追加到条目数组末尾；键已存在时原位更新值，不改变顺序。
+ * 条目数组用尽时，墓碑较多则原地压缩，否则容量翻倍。
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要添加的键
+ * @param val 要添加的值，不能为NULL
+ */
+void orderedPut(HashMapOrdered *hashMap, int key, const void *val);
+
+/**
+ * @brief 从哈希表中删除键值对
+ *
+ * 条目数组中留下墓碑，其它键值对的顺序不变。
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要删除的键
+ */
+void orderedRemoveItem(HashMapOrdered *hashMap, int key);
+
+/**
+ * @brief 获取哈希表中的键值对数量
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回键值对数量
+ */
+size_t orderedSize(HashMapOrdered *hashMap);
+
+/**
+ * @brief 获取条目数组中已使用的条目数量（含墓碑）
+ *
+ * 遍历的耗时与该值成正比。
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回已使用的条目数量
+ */
+size_t orderedUsed(HashMapOrdered *hashMap);
+
+/**
+ * @brief 压缩条目数组
+ *
+ * 移除所有墓碑并重建索引表，键值对顺序不变。迭代过程中不能调用。
+ *
+ * @param hashMap 哈希表的指针
+ */
+void orderedCompact(HashMapOrdered *hashMap);
+
+/**
+ * @brief 初始化哈希表迭代器
+ *
+ * 按插入顺序遍历。
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回初始化后的迭代器
+ */
+HashMapOrderedIterator orderedInitIterator(HashMapOrdered *hashMap);
+
+/**
+ * @brief 判断迭代器是否有下一个元素
+ *
+ * @param iterator 迭代器的指针
+ * @return 如果有下一个元素，则返回true；否则返回false
+ */
+bool orderedHasNext(HashMapOrderedIterator *iterator);
+
+/**
+ * @brief 获取迭代器当前元素的键
+ *
+ * @param iterator 迭代器的指针
+ * @return 返回当前键值对的键
+ */
+int orderedGetKey(HashMapOrderedIterator *iterator);
+
+/**
+ * @brief 获取迭代器当前元素的值
+ *
+ * @param iterator 迭代器的指针
+ * @return 返回当前键值对的值
+ */
+void *orderedGetValue(HashMapOrderedIterator *iterator);
+
+/**
+ * @brief 将迭代器移动到下一个元素
+ *
+ * @param iterator 迭代器的指针
+ */
+void orderedNext(HashMapOrderedIterator *iterator);
+
+/**
+ * @brief 删除迭代器当前指向的键值对
+ *
+ * 删除后迭代器自动移动到下一个元素，不需要再调用 orderedNext。
+ * 墓碑过多时会在此处压缩条目数组，迭代器的位置随之调整，遍历可以继续。
+ *
+ * @param iterator 迭代器指针
+ */
+void orderedRemoveCurrent(HashMapOrderedIterator *iterator);
+
+#endif // HASH_MAP_ORDERED_H
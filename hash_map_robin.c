@@ -0,0 +1,334 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash_map_robin.h"
+#include "hash_func.h"
+#include "utility.h"
+
+#define SLOT_NOT_FOUND ((size_t)-1)
+
+/*
+ * 槽位：dist 为 0 表示空槽位，否则为探测距离加一。
+ * dist 填在 int 键之后原本的对齐空隙里，槽位仍为 16 字节，记录探测距离不增加内存。
+ */
+typedef struct {
+    int key;
+    uint32_t dist;
+    void *val;
+} RobinSlot;
+
+/* Robin Hood 哈希表 */
+struct HashMapRobin {
+    size_t size;            // 键值对数量
+    size_t capacity;        // 槽位数量，2 的幂
+    size_t mask;            // capacity - 1
+    size_t growAt;          // 键值对数量达到该值时扩容
+
+    RobinSlot *slots;       // 槽位数组
+    void (*freeVal)(void*); // 释放val的回调函数，如果为NULL则不释放
+};
+
+static inline uint64_t robinHash(int key) {
+    return hashMurmur(key);
+}
+
+static size_t maxLoad(size_t capacity) {
+    return capacity * HASH_MAP_ROBIN_MAX_LOAD_NUM / HASH_MAP_ROBIN_MAX_LOAD_DEN;
+}
+
+/* 取最低位1的位置 */
+static inline unsigned lowestBit(unsigned mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned i = 0;
+    while ((mask & 1u) == 0) {
+        mask >>= 1;
+        i++;
+    }
+    return i;
+#endif
+}
+
+/*
+ * 查找键所在的槽位，未找到返回 SLOT_NOT_FOUND
+ *
+ * 每次比较 PROBE_GROUP 个相邻槽位（一条缓存行），组内不分支：键唯一，任何已占用且键相等的槽位就是结果；
+ * 遇到空槽位或探测距离更短的键说明键不存在（若存在，插入时早已把它换到这里之前）。
+ * 探测距离多数不超过 3，查找通常只需一次判断，避免逐个槽位比较时难以预测的分支。
+ */
+#define PROBE_GROUP 4
+
+static size_t findSlot(const HashMapRobin *hashMap, int key) {
+    size_t i = (size_t)robinHash(key) & hashMap->mask;
+    for (uint32_t dist = 1;; dist += PROBE_GROUP) {
+        unsigned hit = 0;
+        unsigned stop = 0;
+        for (unsigned j = 0; j < PROBE_GROUP; j++) {
+            const RobinSlot *slot = &hashMap->slots[(i + j) & hashMap->mask];
+            hit |= (unsigned)((slot->key == key) & (slot->dist != 0)) << j;
+            stop |= (unsigned)(slot->dist < dist + j) << j;
+        }
+        if (hit) {
+            return (i + lowestBit(hit)) & hashMap->mask;
+        }
+        if (stop) {
+            return SLOT_NOT_FOUND;
+        }
+        i += PROBE_GROUP;
+    }
+}
+
+/* 插入确定不存在的键，沿途与探测距离更短的键交换位置 */
+static void insertSlot(HashMapRobin *hashMap, int key, void *val) {
+    RobinSlot cur = {key, 1, val};
+    size_t i = (size_t)robinHash(key) & hashMap->mask;
+    for (;; i = (i + 1) & hashMap->mask, cur.dist++) {
+        RobinSlot *slot = &hashMap->slots[i];
+        if (slot->dist == 0) {
+            *slot = cur;
+            return;
+        }
+        if (slot->dist < cur.dist) {
+            RobinSlot tmp = *slot;
+            *slot = cur;
+            cur = tmp;
+        }
+    }
+}
+
+/* 分配指定容量的槽位数组并重新插入原有键值对，失败时哈希表保持不变 */
+static bool resize(HashMapRobin *hashMap, size_t newCapacity) {
+    RobinSlot *slots = (RobinSlot *)calloc(newCapacity, sizeof(RobinSlot));
+    if (slots == NULL) {
+        return false;
+    }
+    RobinSlot *oldSlots = hashMap->slots;
+    size_t oldCapacity = hashMap->capacity;
+
+    hashMap->slots = slots;
+    hashMap->capacity = newCapacity;
+    hashMap->mask = newCapacity - 1;
+    hashMap->growAt = maxLoad(newCapacity);
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldSlots[i].dist != 0) {
+            insertSlot(hashMap, oldSlots[i].key, oldSlots[i].val);
+        }
+    }
+    free(oldSlots);
+    return true;
+}
+
+/* 删除槽位中的键值对：后续探测距离大于1的键依次前移一格，直到空槽位或已在初始槽位的键 */
+static void eraseSlot(HashMapRobin *hashMap, size_t i) {
+    if (hashMap->freeVal != NULL) {
+        hashMap->freeVal(hashMap->slots[i].val);
+    }
+    for (size_t j = (i + 1) & hashMap->mask; hashMap->slots[j].dist > 1; j = (j + 1) & hashMap->mask) {
+        hashMap->slots[i] = hashMap->slots[j];
+        hashMap->slots[i].dist--;
+        i = j;
+    }
+    hashMap->slots[i].dist = 0;
+    hashMap->size--;
+}
+
+/* 创建 Robin Hood 哈希表 */
+HashMapRobin *newHashMapRobin(size_t capacity, void (*freeVal)(void*)) {
+    if (capacity == 0) {
+        return NULL;
+    }
+    HashMapRobin *hashMap = (HashMapRobin *)malloc(sizeof(HashMapRobin));
+    if (hashMap == NULL) {
+        return NULL;
+    }
+
+    size_t slots = HASH_MAP_ROBIN_MIN_CAPACITY;
+    while (slots < capacity) {
+        slots *= 2;
+    }
+
+    hashMap->size = 0;
+    hashMap->capacity = 0;
+    hashMap->slots = NULL;
+    hashMap->freeVal = freeVal;
+    if (!resize(hashMap, slots)) {
+        free(hashMap);
+        return NULL;
+    }
+    return hashMap;
+}
+
+/* 删除 Robin Hood 哈希表 */
+void delHashMapRobin(HashMapRobin *hashMap) {
+    if (hashMap == NULL) {
+        return;
+    }
+
+    if (hashMap->freeVal != NULL) {
+        for (size_t i = 0; i < hashMap->capacity; i++) {
+            if (hashMap->slots[i].dist != 0) {
+                hashMap->freeVal(hashMap->slots[i].val);
+            }
+        }
+    }
+    free(hashMap->slots);
+    free(hashMap);
+}
+
+/* 查找操作 */
+void *robinGet(HashMapRobin *hashMap, int key) {
+    if (hashMap == NULL) {
+        return NULL;
+    }
+
+    size_t slot = findSlot(hashMap, key);
+    return slot == SLOT_NOT_FOUND ? NULL : hashMap->slots[slot].val;
+}
+
+/* 添加操作 */
+void robinPut(HashMapRobin *hashMap, int key, const void *val) {
+    if (hashMap == NULL || val == NULL) {
+        return;
+    }
+
+    size_t slot = findSlot(hashMap, key);
+    if (slot != SLOT_NOT_FOUND) {
+        // 注意：这里假设调用者已经正确管理了旧val指向的内存
+        hashMap->slots[slot].val = (void *)val;
+        return;
+    }
+
+    if (hashMap->size >= hashMap->growAt && !resize(hashMap, hashMap->capacity * 2)) {
+        return; // 内存分配失败
+    }
+    insertSlot(hashMap, key, (void *)val);
+    hashMap->size++;
+}
+
+/* 删除操作 */
+void robinRemoveItem(HashMapRobin *hashMap, int key) {
+    if (hashMap == NULL) {
+        return;
+    }
+
+    size_t slot = findSlot(hashMap, key);
+    if (slot != SLOT_NOT_FOUND) {
+        eraseSlot(hashMap, slot);
+    }
+}
+
+/* 获取键值对数量 */
+size_t robinSize(HashMapRobin *hashMap) {
+    return hashMap == NULL ? 0 : hashMap->size;
+}
+
+/* 获取槽位数量 */
+size_t robinCapacity(HashMapRobin *hashMap) {
+    return hashMap == NULL ? 0 : hashMap->capacity;
+}
+
+/* 统计探测距离 */
+void robinProbeStats(HashMapRobin *hashMap, double *average, size_t *max) {
+    size_t total = 0;
+    size_t longest = 0;
+    if (hashMap != NULL) {
+        for (size_t i = 0; i < hashMap->capacity; i++) {
+            if (hashMap->slots[i].dist != 0) {
+                size_t dist = hashMap->slots[i].dist - 1;
+                total += dist;
+                longest = dist > longest ? dist : longest;
+            }
+        }
+    }
+    if (average != NULL) {
+        *average = hashMap != NULL && hashMap->size > 0 ? (double)total / (double)hashMap->size : 0.0;
+    }
+    if (max != NULL) {
+        *max = longest;
+    }
+}
+
+/* 从迭代器当前位置开始查找下一个已占用槽位 */
+static void seekFull(HashMapRobinIterator *iterator) {
+    HashMapRobin *hashMap = iterator->hashMap;
+    while (iterator->position < hashMap->capacity &&
+           hashMap->slots[(iterator->start + iterator->position) & hashMap->mask].dist == 0) {
+        iterator->position++;
+    }
+    iterator->hasNext = iterator->position < hashMap->capacity;
+}
+
+static inline size_t currentSlot(const HashMapRobinIterator *iterator) {
+    return (iterator->start + iterator->position) & iterator->hashMap->mask;
+}
+
+/*
+ * 初始化哈希表迭代器
+ *
+ * 从某个空槽位之后开始遍历：任何一段连续的已占用槽位都不会跨过遍历起点，
+ * 删除时向后移位的键只来自当前位置之后、尚未访问的槽位。
+ */
+HashMapRobinIterator robinInitIterator(HashMapRobin *hashMap) {
+    HashMapRobinIterator iterator;
+    iterator.hashMap = hashMap;
+    iterator.start = 0;
+    iterator.position = 0;
+    iterator.hasNext = false;
+
+    if (hashMap != NULL && hashMap->size > 0) {
+        // 负载不超过 9/10，一定存在空槽位
+        size_t empty = 0;
+        while (hashMap->slots[empty].dist != 0) {
+            empty++;
+        }
+        iterator.start = (empty + 1) & hashMap->mask;
+        seekFull(&iterator);
+    }
+    return iterator;
+}
+
+/* 判断迭代器是否有下一个元素 */
+bool robinHasNext(HashMapRobinIterator *iterator) {
+    if (iterator == NULL) {
+        return false;
+    }
+    return iterator->hasNext;
+}
+
+/* 获取迭代器当前元素的键 */
+int robinGetKey(HashMapRobinIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return -1;
+    }
+    return iterator->hashMap->slots[currentSlot(iterator)].key;
+}
+
+/* 获取迭代器当前元素的值 */
+void *robinGetValue(HashMapRobinIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return NULL;
+    }
+    return iterator->hashMap->slots[currentSlot(iterator)].val;
+}
+
+/* 将迭代器移动到下一个元素 */
+void robinNext(HashMapRobinIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return;
+    }
+
+    iterator->position++;
+    seekFull(iterator);
+}
+
+/* 删除迭代器当前指向的键值对 */
+void robinRemoveCurrent(HashMapRobinIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return;
+    }
+
+    // 后续的键可能前移到当前槽位，因此从当前位置重新查找
+    eraseSlot(iterator->hashMap, currentSlot(iterator));
+    seekFull(iterator);
+}
@@ -0,0 +1,156 @@
+#ifndef HASH_MAP_ROBIN_H
+#define HASH_MAP_ROBIN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define HASH_MAP_ROBIN_MIN_CAPACITY 8     // 最小槽位数量
+#define HASH_MAP_ROBIN_MAX_LOAD_NUM 9     // 最大负载因子分子：9/10
+#define HASH_MAP_ROBIN_MAX_LOAD_DEN 10    // 最大负载因子分母
+
+/*
+ * Robin Hood 线性探测哈希表
+ *
+ * 每个槽位记录键到其初始槽位的探测距离。插入时遇到探测距离比自己短的键就交换位置（劫富济贫），
+ * 探测距离的方差因此很小，0.9 的负载下平均探测距离约为 4，最长也只有几十个槽位；
+ * 查找时一旦遇到探测距离比当前更短的槽位即可判定键不存在，未命中不必走到空槽位。
+ * 删除采用向后移位：把后续槽位前移一格并把探测距离减一，不留下墓碑。
+ */
+typedef struct HashMapRobin HashMapRobin;
+
+/* Robin Hood 哈希表迭代器 */
+typedef struct {
+    HashMapRobin *hashMap;  // 迭代器所属的哈希表
+    size_t start;           // 遍历起点：某个空槽位的下一个槽位
+    size_t position;        // 已经越过的槽位数量，当前槽位为 (start + position) % 槽位数量
+    bool hasNext;           // 是否有下一个元素
+} HashMapRobinIterator;
+
+/**
+ * @brief 创建一个新的 HashMapRobin 对象
+ *
+ * 槽位数量会向上取整为 2 的幂。
+ *
+ * @param capacity 期望的槽位数量，必须大于0。
+ * @param freeVal val 值释放函数指针，用于释放存储在哈希表中的值。如果不需要释放，可以传递 NULL。
+ *
+ * @return 成功时返回新创建的 HashMapRobin 对象指针，失败时返回 NULL。
+ */
+HashMapRobin *newHashMapRobin(size_t capacity, void (*freeVal)(void*));
+
+/**
+ * @brief 删除 Robin Hood 哈希表
+ *
+ * 删除哈希表中的所有键值对，并释放哈希表所占用的内存。
+ *
+ * @param hashMap 哈希表的指针
+ */
+void delHashMapRobin(HashMapRobin *hashMap);
+
+/**
+ * @brief 根据键从哈希表中获取值
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要查找的键
+ *
+ * @return 返回与键对应的值，如果键不存在则返回NULL
+ */
+void *robinGet(HashMapRobin *hashMap, int key);
+
+/**
+ * @brief 添加键值对到哈希表
+ *
+ * 向哈希表中添加一个键值对。如果键已存在，则更新对应的值。
+ * 键值对数量超过槽位数量的 9/10 时容量翻倍。
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要添加的键
+ * @param val 要添加的值，不能为NULL
+ */
+void robinPut(HashMapRobin *hashMap, int key, const void *val);
+
+/**
+ * @brief 从哈希表中删除键值对
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要删除的键
+ */
+void robinRemoveItem(HashMapRobin *hashMap, int key);
+
+/**
+ * @brief 获取哈希表中的键值对数量
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回键值对数量
+ */
+size_t robinSize(HashMapRobin *hashMap);
+
+/**
+ * @brief 获取哈希表的槽位数量
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回槽位数量
+ */
+size_t robinCapacity(HashMapRobin *hashMap);
+
+/**
+ * @brief 统计探测距离
+ *
+ * 探测距离为键所在槽位与初始槽位之差，命中查找需要比较的槽位数量为探测距离加一。
+ *
+ * @param hashMap 哈希表的指针
+ * @param average 不为NULL时输出平均探测距离
+ * @param max 不为NULL时输出最大探测距离
+ */
+void robinProbeStats(HashMapRobin *hashMap, double *average, size_t *max);
+
+/**
+ * @brief 初始化哈希表迭代器
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回初始化后的迭代器
+ */
+HashMapRobinIterator robinInitIterator(HashMapRobin *hashMap);
+
+/**
+ * @brief 判断迭代器是否有下一个元素
+ *
+ * @param iterator 迭代器的指针
+ * @return 如果有下一个元素，则返回true；否则返回false
+ */
+bool robinHasNext(HashMapRobinIterator *iterator);
+
+/**
+ * @brief 获取迭代器当前元素的键
+ *
+ * @param iterator 迭代器的指针
+ * @return 返回当前键值对的键
+ */
+int robinGetKey(HashMapRobinIterator *iterator);
+
+/**
+ * @brief 获取迭代器当前元素的值
+ *
+ * @param iterator 迭代器的指针
+ * @return 返回当前键值对的值
+ */
+void *robinGetValue(HashMapRobinIterator *iterator);
+
+/**
+ * @brief 将迭代器移动到下一个元素
+ *
+ * @param iterator 迭代器的指针
+ */
+void robinNext(HashMapRobinIterator *iterator);
+
+/**
+ * @brief 删除迭代器当前指向的键值对
+ *
+ * 删除后迭代器自动移动到下一个元素，不需要再调用 robinNext。
+ * 向后移位只会把尚未访问的键移到当前位置，遍历不会遗漏或重复。
+ *
+ * @param iterator 迭代器指针
+ */
+void robinRemoveCurrent(HashMapRobinIterator *iterator);
+
+#endif // HASH_MAP_ROBIN_H
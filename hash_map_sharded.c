@@ -0,0 +1,195 @@
+#include <stdint.h>
+#include <pthread.h>
+#include "hash_map_sharded.h"
+#include "hash_func.h"
+#include "utility.h"
+
+/* 分片：读写锁和分片哈希表独占缓存行，相邻分片的锁不会发生伪共享 */
+typedef struct {
+    _Alignas(HASH_MAP_SHARDED_CACHE_LINE) pthread_rwlock_t lock;
+    HashMapChaining *map;
+} HashShard;
+
+/* 线程安全的分片哈希表 */
+struct HashMapSharded {
+    size_t shardCount;  // 分片数量，2 的幂
+    unsigned shardShift; // 取哈希值高位时的右移位数
+    HashShard *shards;  // 分片数组，按缓存行对齐
+    void *rawShards;    // 分片数组的原始分配地址
+    bool exclusiveGet;  // 分片为缓存模式时 get 会写访问位和计数器，需要持有写锁
+    uint64_t shardSeed; // 选择分片的哈希种子
+};
+
+/*
+ * 按键哈希值的高位选择分片
+ *
+ * 分片内部的桶由哈希值的低位决定，这里使用高位，保证同一分片内的键在桶之间仍然分布均匀。
+ * 无论分片采用哪种哈希策略都使用 murmur 混合，避免恒等映射时高位全为0；
+ * 混合带有种子，无法离线构造集中到同一分片的键。
+ */
+static inline HashShard *shardFor(HashMapSharded *hashMap, int key) {
+    size_t index = (size_t)(hashMurmurSeeded(key, hashMap->shardSeed) >> hashMap->shardShift) & (hashMap->shardCount - 1);
+    return &hashMap->shards[index];
+}
+
+/* 释放前 count 个分片 */
+static void destroyShards(HashMapSharded *hashMap, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        delHashMapChaining(hashMap->shards[i].map);
+        pthread_rwlock_destroy(&hashMap->shards[i].lock);
+    }
+}
+
+/* 创建分片哈希表 */
+HashMapSharded *newHashMapSharded(size_t shardCount, const HashMapChainingConfig *config) {
+    if (config == NULL || config->capacity == 0 || shardCount > HASH_MAP_SHARDED_MAX_SHARDS) {
+        return NULL;
+    }
+    if (shardCount == 0) {
+        shardCount = HASH_MAP_SHARDED_DEFAULT_SHARDS;
+    }
+
+    unsigned bits = 0;
+    while (((size_t)1 << bits) < shardCount) {
+        bits++;
+    }
+    shardCount = (size_t)1 << bits;
+
+    HashMapSharded *hashMap = (HashMapSharded *)malloc(sizeof(HashMapSharded));
+    if (hashMap == NULL) {
+        return NULL;
+    }
+    char *raw = (char *)malloc(shardCount * sizeof(HashShard) + HASH_MAP_SHARDED_CACHE_LINE - 1);
+    if (raw == NULL) {
+        free(hashMap);
+        return NULL;
+    }
+    uintptr_t aligned = ((uintptr_t)raw + HASH_MAP_SHARDED_CACHE_LINE - 1) & ~(uintptr_t)(HASH_MAP_SHARDED_CACHE_LINE - 1);
+    hashMap->shards = (HashShard *)(void *)(raw + (aligned - (uintptr_t)raw));
+    hashMap->rawShards = raw;
+    hashMap->shardCount = shardCount;
+    hashMap->shardShift = 64u - (bits > 0 ? bits : 1u);
+    hashMap->shardSeed = config->hashSeed != 0 ? config->hashSeed : hashRandomSeed(hashMap);
+
+    // 总容量平均分配到各分片
+    HashMapChainingConfig shardConfig = *config;
+    shardConfig.capacity = config->capacity / shardCount > 0 ? config->capacity / shardCount : 1;
+    // 缓存上限同样平均分配，每个分片独立淘汰
+    shardConfig.cacheMaxEntries = (config->cacheMaxEntries + shardCount - 1) / shardCount;
+    shardConfig.cacheMaxBytes = (config->cacheMaxBytes + shardCount - 1) / shardCount;
+    hashMap->exclusiveGet = config->cacheMaxEntries > 0 || config->cacheMaxBytes > 0;
+    for (size_t i = 0; i < shardCount; i++) {
+        HashShard *shard = &hashMap->shards[i];
+        shard->map = newHashMapChainingWithConfig(&shardConfig);
+        if (shard->map == NULL) {
+            destroyShards(hashMap, i);
+            free(raw);
+            free(hashMap);
+            return NULL;
+        }
+        if (pthread_rwlock_init(&shard->lock, NULL) != 0) {
+            delHashMapChaining(shard->map);
+            destroyShards(hashMap, i);
+            free(raw);
+            free(hashMap);
+            return NULL;
+        }
+    }
+    return hashMap;
+}
+
+/* 删除分片哈希表 */
+void delHashMapSharded(HashMapSharded *hashMap) {
+    if (hashMap == NULL) {
+        return;
+    }
+    destroyShards(hashMap, hashMap->shardCount);
+    free(hashMap->rawShards);
+    free(hashMap);
+}
+
+/* 查找操作 */
+void *shardedGet(HashMapSharded *hashMap, int key) {
+    if (hashMap == NULL) {
+        return NULL;
+    }
+    HashShard *shard = shardFor(hashMap, key);
+    if (hashMap->exclusiveGet) {
+        pthread_rwlock_wrlock(&shard->lock);
+    } else {
+        pthread_rwlock_rdlock(&shard->lock);
+    }
+    void *val = get(shard->map, key);
+    pthread_rwlock_unlock(&shard->lock);
+    return val;
+}
+
+/* 添加操作 */
+void shardedPut(HashMapSharded *hashMap, int key, const void *val) {
+    if (hashMap == NULL) {
+        return;
+    }
+    HashShard *shard = shardFor(hashMap, key);
+    pthread_rwlock_wrlock(&shard->lock);
+    put(shard->map, key, val);
+    pthread_rwlock_unlock(&shard->lock);
+}
+
+/* 删除操作 */
+void shardedRemoveItem(HashMapSharded *hashMap, int key) {
+    if (hashMap == NULL) {
+        return;
+    }
+    HashShard *shard = shardFor(hashMap, key);
+    pthread_rwlock_wrlock(&shard->lock);
+    removeItem(shard->map, key);
+    pthread_rwlock_unlock(&shard->lock);
+}
+
+/* 按分片顺序获取所有读锁，写操作只持有单个分片的锁，因此不会死锁 */
+static void lockAllShared(HashMapSharded *hashMap) {
+    for (size_t i = 0; i < hashMap->shardCount; i++) {
+        pthread_rwlock_rdlock(&hashMap->shards[i].lock);
+    }
+}
+
+static void unlockAll(HashMapSharded *hashMap) {
+    for (size_t i = hashMap->shardCount; i > 0; i--) {
+        pthread_rwlock_unlock(&hashMap->shards[i - 1].lock);
+    }
+}
+
+/* 获取键值对数量 */
+size_t shardedSize(HashMapSharded *hashMap) {
+    if (hashMap == NULL) {
+        return 0;
+    }
+    size_t total = 0;
+    lockAllShared(hashMap);
+    for (size_t i = 0; i < hashMap->shardCount; i++) {
+        total += size(hashMap->shards[i].map);
+    }
+    unlockAll(hashMap);
+    return total;
+}
+
+/* 获取分片数量 */
+size_t shardedShardCount(HashMapSharded *hashMap) {
+    return hashMap == NULL ? 0 : hashMap->shardCount;
+}
+
+/* 遍历所有键值对 */
+void shardedForEach(HashMapSharded *hashMap, void (*visit)(int key, void *val, void *ctx), void *ctx) {
+    if (hashMap == NULL || visit == NULL) {
+        return;
+    }
+    lockAllShared(hashMap);
+    for (size_t i = 0; i < hashMap->shardCount; i++) {
+        HashMapIterator it = initIterator(hashMap->shards[i].map);
+        while (hasNext(&it)) {
+            visit(getKey(&it), getValue(&it), ctx);
+            next(&it);
+        }
+    }
+    unlockAll(hashMap);
+}
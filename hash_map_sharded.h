@@ -0,0 +1,105 @@
+#ifndef HASH_MAP_SHARDED_H
+#define HASH_MAP_SHARDED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "hash_table.h"
+
+#define HASH_MAP_SHARDED_DEFAULT_SHARDS 64  // 默认分片数量
+#define HASH_MAP_SHARDED_MAX_SHARDS 4096    // 最大分片数量
+#define HASH_MAP_SHARDED_CACHE_LINE 64      // 每个分片独占的缓存行大小，避免伪共享
+
+/*
+ * 线程安全的分片哈希表
+ *
+ * 按键哈希值的高位把键分配到若干个相互独立的 HashMapChaining 分片，
+ * 每个分片有自己的读写锁，不同分片上的操作互不阻塞，扩容也只在单个分片内进行。
+ */
+typedef struct HashMapSharded HashMapSharded;
+
+/**
+ * @brief 创建一个新的 HashMapSharded 对象
+ *
+ * 分片数量向上取整为 2 的幂。config 中的 capacity 为所有分片的总桶数量，平均分配到各分片，
+ * 其余参数（freeVal、哈希策略、渐进式扩容等）对每个分片都生效。缓存上限同样平均分配到各分片，
+ * 每个分片独立淘汰；此时 shardedGet 需要修改分片的访问位，改为持有写锁。
+ *
+ * @param shardCount 分片数量，为0时使用 HASH_MAP_SHARDED_DEFAULT_SHARDS，最大为 HASH_MAP_SHARDED_MAX_SHARDS
+ * @param config 分片的创建参数，不能为NULL
+ *
+ * @return 成功时返回新创建的 HashMapSharded 对象指针，失败时返回 NULL。
+ */
+HashMapSharded *newHashMapSharded(size_t shardCount, const HashMapChainingConfig *config);
+
+/**
+ * @brief 删除分片哈希表
+ *
+ * 调用时不能有其他线程正在访问该哈希表。
+ *
+ * @param hashMap 哈希表的指针
+ */
+void delHashMapSharded(HashMapSharded *hashMap);
+
+/**
+ * @brief 根据键从哈希表中获取值
+ *
+ * 只持有键所在分片的读锁（缓存模式下为写锁）。返回后其他线程仍可能删除该键；
+ * 如果设置了 freeVal，调用者需要自行保证返回的值在使用期间不会被删除。
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要查找的键
+ *
+ * @return 返回与键对应的值，如果键不存在则返回NULL
+ */
+void *shardedGet(HashMapSharded *hashMap, int key);
+
+/**
+ * @brief 添加键值对到哈希表
+ *
+ * 持有键所在分片的写锁，分片需要扩容时只阻塞该分片上的操作。
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要添加的键
+ * @param val 要添加的值
+ */
+void shardedPut(HashMapSharded *hashMap, int key, const void *val);
+
+/**
+ * @brief 从哈希表中删除键值对
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要删除的键
+ */
+void shardedRemoveItem(HashMapSharded *hashMap, int key);
+
+/**
+ * @brief 获取哈希表中的键值对数量
+ *
+ * 按顺序获取所有分片的读锁后再求和，返回值对应同一时刻的一致状态。
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回键值对数量
+ */
+size_t shardedSize(HashMapSharded *hashMap);
+
+/**
+ * @brief 获取分片数量
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回分片数量
+ */
+size_t shardedShardCount(HashMapSharded *hashMap);
+
+/**
+ * @brief 遍历哈希表中的所有键值对
+ *
+ * 遍历期间持有所有分片的读锁，回调看到的是同一时刻的一致快照，写操作会被阻塞到遍历结束。
+ * 回调中不能再调用会获取写锁的函数（shardedPut、shardedRemoveItem），否则会死锁。
+ *
+ * @param hashMap 哈希表的指针
+ * @param visit 对每个键值对调用的回调函数
+ * @param ctx 传给回调函数的用户数据
+ */
+void shardedForEach(HashMapSharded *hashMap, void (*visit)(int key, void *val, void *ctx), void *ctx);
+
+#endif // HASH_MAP_SHARDED_H
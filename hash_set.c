@@ -0,0 +1,336 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "hash_set.h"
+#include "hash_map_flat_group.h"
+#include "hash_func.h"
+#include "utility.h"
+
+/* 整数键集合 */
+struct HashSet {
+    size_t size;            // 键的数量
+    size_t capacity;        // 槽位数量，2 的幂
+    size_t growthLeft;      // 在扩容前还可占用的空槽位数量（墓碑不计入）
+
+    uint8_t *ctrl;          // 控制字节数组，长度为 capacity
+    int *keys;              // 键数组，长度为 capacity
+};
+
+/* 与 HashMapFlat 相同的哈希函数，同一个键在两种结构中的探测序列一致 */
+static inline uint64_t setHash(int key) {
+    return hashMurmur(key);
+}
+
+static inline bool slotIsFull(const HashSet *set, size_t slot) {
+    return (set->ctrl[slot] & 0x80) == 0;
+}
+
+static size_t maxLoad(size_t capacity) {
+    return capacity / HASH_MAP_FLAT_MAX_LOAD_DEN * HASH_MAP_FLAT_MAX_LOAD_NUM;
+}
+
+/* 查找键所在的槽位，未找到返回 SLOT_NOT_FOUND */
+static size_t findSlot(const HashSet *set, int key, uint64_t hash) {
+    size_t groupMask = set->capacity / GROUP_WIDTH - 1;
+    size_t group = hashH1(hash) & groupMask;
+    uint8_t h2 = hashH2(hash);
+
+    for (size_t step = 1; step <= groupMask + 1; step++) {
+        const uint8_t *ctrl = set->ctrl + group * GROUP_WIDTH;
+        GroupMask match = groupMatch(ctrl, h2);
+        while (match) {
+            size_t slot = group * GROUP_WIDTH + lowestBit(match);
+            if (set->keys[slot] == key) {
+                return slot;
+            }
+            match &= match - 1;
+        }
+        if (groupMatchEmpty(ctrl)) {
+            return SLOT_NOT_FOUND;
+        }
+        group = (group + step) & groupMask;
+    }
+    return SLOT_NOT_FOUND;
+}
+
+/* 分配指定容量的槽位数组，成功返回true */
+static bool allocSlots(HashSet *set, size_t capacity) {
+    uint8_t *ctrl = (uint8_t *)malloc(capacity);
+    if (ctrl == NULL) {
+        return false;
+    }
+    int *keys = (int *)malloc(capacity * sizeof(int));
+    if (keys == NULL) {
+        free(ctrl);
+        return false;
+    }
+    memset(ctrl, CTRL_EMPTY, capacity);
+
+    set->ctrl = ctrl;
+    set->keys = keys;
+    set->capacity = capacity;
+    set->growthLeft = maxLoad(capacity);
+    return true;
+}
+
+/* 以新容量重建槽位数组，同时清除所有墓碑 */
+static bool resize(HashSet *set, size_t newCapacity) {
+    uint8_t *oldCtrl = set->ctrl;
+    int *oldKeys = set->keys;
+    size_t oldCapacity = set->capacity;
+
+    if (!allocSlots(set, newCapacity)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (oldCtrl[i] & 0x80) {
+            continue;
+        }
+        uint64_t hash = setHash(oldKeys[i]);
+        size_t slot = ctrlFindInsertSlot(set->ctrl, set->capacity, hash);
+        set->ctrl[slot] = hashH2(hash);
+        set->keys[slot] = oldKeys[i];
+    }
+    set->growthLeft -= set->size;
+
+    free(oldCtrl);
+    free(oldKeys);
+    return true;
+}
+
+/* 槽位用尽时调用：墓碑较多则原地重建，否则容量翻倍 */
+static bool grow(HashSet *set) {
+    size_t newCapacity = set->capacity;
+    if (set->size * 2 >= maxLoad(set->capacity)) {
+        newCapacity *= 2;
+    }
+    return resize(set, newCapacity);
+}
+
+/* 删除指定槽位的键 */
+static void eraseSlot(HashSet *set, size_t slot) {
+    if (ctrlErase(set->ctrl, slot)) {
+        set->growthLeft++;
+    }
+    set->size--;
+}
+
+/* 从 start 开始查找下一个已占用槽位，没有则返回 capacity */
+static size_t nextFullSlot(const HashSet *set, size_t start) {
+    for (size_t i = start; i < set->capacity; i++) {
+        if (slotIsFull(set, i)) {
+            return i;
+        }
+    }
+    return set->capacity;
+}
+
+/* 创建集合 */
+HashSet *newHashSet(size_t capacity) {
+    if (capacity == 0) {
+        return NULL;
+    }
+    HashSet *set = (HashSet *)malloc(sizeof(HashSet));
+    if (set == NULL) {
+        return NULL;
+    }
+
+    size_t slots = GROUP_WIDTH;
+    while (slots < capacity) {
+        slots *= 2;
+    }
+
+    set->size = 0;
+    if (!allocSlots(set, slots)) {
+        free(set);
+        return NULL;
+    }
+    return set;
+}
+
+/* 删除集合 */
+void delHashSet(HashSet *set) {
+    if (set == NULL) {
+        return;
+    }
+    free(set->ctrl);
+    free(set->keys);
+    free(set);
+}
+
+/* 插入确定不在集合中的键，内存分配失败时返回false */
+static bool insertNew(HashSet *set, int key, uint64_t hash) {
+    size_t slot = ctrlFindInsertSlot(set->ctrl, set->capacity, hash);
+    // 复用墓碑不消耗空槽位，只有占用空槽位时才需要检查是否扩容
+    if (slot == SLOT_NOT_FOUND || (set->ctrl[slot] == CTRL_EMPTY && set->growthLeft == 0)) {
+        if (!grow(set)) {
+            return false;
+        }
+        slot = ctrlFindInsertSlot(set->ctrl, set->capacity, hash);
+    }
+
+    if (set->ctrl[slot] == CTRL_EMPTY) {
+        set->growthLeft--;
+    }
+    set->ctrl[slot] = hashH2(hash);
+    set->keys[slot] = key;
+    set->size++;
+    return true;
+}
+
+/* 添加操作 */
+bool setInsert(HashSet *set, int key) {
+    if (set == NULL) {
+        return false;
+    }
+
+    uint64_t hash = setHash(key);
+    return findSlot(set, key, hash) == SLOT_NOT_FOUND && insertNew(set, key, hash);
+}
+
+/* 查找操作 */
+bool setContains(const HashSet *set, int key) {
+    return set != NULL && findSlot(set, key, setHash(key)) != SLOT_NOT_FOUND;
+}
+
+/* 删除操作 */
+bool setErase(HashSet *set, int key) {
+    if (set == NULL) {
+        return false;
+    }
+
+    size_t slot = findSlot(set, key, setHash(key));
+    if (slot == SLOT_NOT_FOUND) {
+        return false;
+    }
+    eraseSlot(set, slot);
+    return true;
+}
+
+/* 获取键的数量 */
+size_t setSize(const HashSet *set) {
+    return set == NULL ? 0 : set->size;
+}
+
+/* 获取槽位数量 */
+size_t setCapacity(const HashSet *set) {
+    return set == NULL ? 0 : set->capacity;
+}
+
+/* 并集 */
+bool setUnion(HashSet *set, const HashSet *other) {
+    if (set == NULL || other == NULL) {
+        return false;
+    }
+    if (set == other) {
+        return true;
+    }
+
+    // 按合并后可能的最大数量预先扩容
+    size_t capacity = set->capacity;
+    while (maxLoad(capacity) < set->size + other->size) {
+        capacity *= 2;
+    }
+    if (capacity != set->capacity && !resize(set, capacity)) {
+        return false;
+    }
+
+    for (size_t i = nextFullSlot(other, 0); i < other->capacity; i = nextFullSlot(other, i + 1)) {
+        int key = other->keys[i];
+        uint64_t hash = setHash(key);
+        if (findSlot(set, key, hash) == SLOT_NOT_FOUND && !insertNew(set, key, hash)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* 交集 */
+void setIntersect(HashSet *set, const HashSet *other) {
+    if (set == NULL || other == NULL || set == other) {
+        return;
+    }
+
+    for (size_t i = nextFullSlot(set, 0); i < set->capacity; i = nextFullSlot(set, i + 1)) {
+        if (!setContains(other, set->keys[i])) {
+            eraseSlot(set, i);
+        }
+    }
+}
+
+/* 差集 */
+void setDifference(HashSet *set, const HashSet *other) {
+    if (set == NULL || other == NULL) {
+        return;
+    }
+
+    if (set == other) {
+        memset(set->ctrl, CTRL_EMPTY, set->capacity);
+        set->size = 0;
+        set->growthLeft = maxLoad(set->capacity);
+        return;
+    }
+    if (other->size < set->size) {
+        for (size_t i = nextFullSlot(other, 0); i < other->capacity; i = nextFullSlot(other, i + 1)) {
+            setErase(set, other->keys[i]);
+        }
+        return;
+    }
+    for (size_t i = nextFullSlot(set, 0); i < set->capacity; i = nextFullSlot(set, i + 1)) {
+        if (setContains(other, set->keys[i])) {
+            eraseSlot(set, i);
+        }
+    }
+}
+
+/* 初始化集合迭代器 */
+HashSetIterator setInitIterator(HashSet *set) {
+    HashSetIterator iterator;
+    iterator.set = set;
+    iterator.slotIndex = 0;
+    iterator.hasNext = false;
+
+    if (set != NULL && set->size > 0) {
+        iterator.slotIndex = nextFullSlot(set, 0);
+        iterator.hasNext = iterator.slotIndex < set->capacity;
+    }
+    return iterator;
+}
+
+/* 判断迭代器是否有下一个元素 */
+bool setHasNext(HashSetIterator *iterator) {
+    if (iterator == NULL) {
+        return false;
+    }
+    return iterator->hasNext;
+}
+
+/* 获取迭代器当前指向的键 */
+int setGetKey(HashSetIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return -1;
+    }
+    return iterator->set->keys[iterator->slotIndex];
+}
+
+/* 将迭代器移动到下一个元素 */
+void setNext(HashSetIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return;
+    }
+
+    iterator->slotIndex = nextFullSlot(iterator->set, iterator->slotIndex + 1);
+    iterator->hasNext = iterator->slotIndex < iterator->set->capacity;
+}
+
+/* 删除迭代器当前指向的键 */
+void setRemoveCurrent(HashSetIterator *iterator) {
+    if (iterator == NULL || !iterator->hasNext) {
+        return;
+    }
+
+    // 删除不会移动其它槽位，直接前进即可
+    eraseSlot(iterator->set, iterator->slotIndex);
+    setNext(iterator);
+}
@@ -0,0 +1,158 @@
+#ifndef HASH_SET_H
+#define HASH_SET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * 整数键集合
+ *
+ * 与 HashMapFlat 使用同一套 Swiss table 控制字节与探测方式，但槽位只存放键：
+ * 每个槽位 4 字节键加 1 字节控制字节，适合只判断成员关系、不需要值的场景。
+ */
+typedef struct HashSet HashSet;
+
+/* 集合迭代器 */
+typedef struct {
+    HashSet *set;          // 迭代器所属的集合
+    size_t slotIndex;      // 当前槽位索引
+    bool hasNext;          // 是否有下一个元素
+} HashSetIterator;
+
+/**
+ * @brief 创建一个新的 HashSet 对象
+ *
+ * 槽位数量会向上取整为 2 的幂且不小于一组控制字节的宽度。
+ *
+ * @param capacity 期望的槽位数量，必须大于0。
+ *
+ * @return 成功时返回新创建的 HashSet 对象指针，失败时返回 NULL。
+ */
+HashSet *newHashSet(size_t capacity);
+
+/**
+ * @brief 删除集合并释放其占用的内存
+ *
+ * @param set 集合的指针
+ */
+void delHashSet(HashSet *set);
+
+/**
+ * @brief 向集合中添加键
+ *
+ * 当已用槽位超过 7/8 时自动扩容。
+ *
+ * @param set 集合的指针
+ * @param key 要添加的键
+ *
+ * @return 键原本不在集合中且添加成功时返回true，键已存在或内存分配失败时返回false
+ */
+bool setInsert(HashSet *set, int key);
+
+/**
+ * @brief 判断键是否在集合中
+ *
+ * @param set 集合的指针
+ * @param key 要查找的键
+ *
+ * @return 键在集合中时返回true
+ */
+bool setContains(const HashSet *set, int key);
+
+/**
+ * @brief 从集合中删除键
+ *
+ * @param set 集合的指针
+ * @param key 要删除的键
+ *
+ * @return 键原本在集合中时返回true
+ */
+bool setErase(HashSet *set, int key);
+
+/**
+ * @brief 获取集合中键的数量
+ *
+ * @param set 集合的指针
+ * @return 返回键的数量
+ */
+size_t setSize(const HashSet *set);
+
+/**
+ * @brief 获取集合的槽位数量
+ *
+ * @param set 集合的指针
+ * @return 返回槽位数量
+ */
+size_t setCapacity(const HashSet *set);
+
+/**
+ * @brief 并集：把 other 中的键全部加入 set
+ *
+ * 先按两个集合的大小之和一次性扩容，合并过程中不会反复扩容。
+ *
+ * @param set 被修改的集合
+ * @param other 另一个集合，不会被修改，可以与 set 相同
+ *
+ * @return 成功返回true，内存分配失败时返回false（set 中可能已加入部分键）
+ */
+bool setUnion(HashSet *set, const HashSet *other);
+
+/**
+ * @brief 交集：从 set 中删除不在 other 中的键
+ *
+ * @param set 被修改的集合
+ * @param other 另一个集合，不会被修改
+ */
+void setIntersect(HashSet *set, const HashSet *other);
+
+/**
+ * @brief 差集：从 set 中删除在 other 中的键
+ *
+ * 遍历两个集合中较小的一个。
+ *
+ * @param set 被修改的集合
+ * @param other 另一个集合，不会被修改，与 set 相同时清空 set
+ */
+void setDifference(HashSet *set, const HashSet *other);
+
+/**
+ * @brief 初始化集合迭代器
+ *
+ * @param set 集合的指针
+ * @return 返回初始化后的迭代器
+ */
+HashSetIterator setInitIterator(HashSet *set);
+
+/**
+ * @brief 判断迭代器是否有下一个元素
+ *
+ * @param iterator 迭代器的指针
+ * @return 如果有下一个元素，则返回true；否则返回false
+ */
+bool setHasNext(HashSetIterator *iterator);
+
+/**
+ * @brief 获取迭代器当前指向的键
+ *
+ * @param iterator 迭代器的指针
+ * @return 返回当前键
+ */
+int setGetKey(HashSetIterator *iterator);
+
+/**
+ * @brief 将迭代器移动到下一个元素
+ *
+ * @param iterator 迭代器的指针
+ */
+void setNext(HashSetIterator *iterator);
+
+/**
+ * @brief 删除迭代器当前指向的键
+ *
+ * 删除后迭代器自动移动到下一个元素，不需要再调用 setNext。
+ *
+ * @param iterator 迭代器指针
+ */
+void setRemoveCurrent(HashSetIterator *iterator);
+
+#endif // HASH_SET_H
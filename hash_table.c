@@ -1,36 +1,68 @@
 #include <stdio.h>
+#include <stdint.h>
 #include <string.h>
 #include "hash_table.h"
+#include "hash_table_internal.h"
+#include "thread_pool.h"
 #include "utility.h"
 
-/* 键值对 int->void */
-typedef struct {
-    int key;
-    void *val;
-} Pair;
+static void extend(HashMapChaining *hashMap);
+static void finishRehash(HashMapChaining *hashMap);
+
+/* 将容量向上取整为 2 的幂 */
+static size_t roundUpPow2(size_t capacity) {
+    size_t pow2 = 1;
+    while (pow2 < capacity) {
+        pow2 <<= 1;
+    }
+    return pow2;
+}
 
-/* 链表节点 */
-typedef struct HashNode {
-    Pair pair;
-    struct HashNode *next;
-} HashNode;
+/*
+ * 分配清零的桶数组，起始地址按 HASH_BUCKET_ALIGN 对齐，并行遍历的每个块都从缓存行边界开始
+ *
+ * 多分配一个对齐单位，malloc 返回的原始地址保存在对齐地址之前的一个指针中，由 freeBuckets 释放。
+ */
+static HashNode **allocBuckets(size_t capacity) {
+    char *raw = (char *)calloc(1, capacity * sizeof(HashNode *) + HASH_BUCKET_ALIGN + sizeof(void *));
+    if (raw == NULL) {
+        return NULL;
+    }
+    uintptr_t aligned = ((uintptr_t)raw + sizeof(void *) + HASH_BUCKET_ALIGN - 1) & ~(uintptr_t)(HASH_BUCKET_ALIGN - 1);
+    HashNode **buckets = (HashNode **)(void *)(raw + (aligned - (uintptr_t)raw));
+    ((void **)buckets)[-1] = raw;
+    return buckets;
+}
 
-/* 链式地址哈希表 */
-typedef struct HashMapChaining{
-    size_t size;         // 键值对数量
-    size_t capacity;     // 哈希表容量
+/* 释放 allocBuckets 分配的桶数组 */
+static void freeBuckets(HashNode **buckets) {
+    if (buckets != NULL) {
+        free(((void **)buckets)[-1]);
+    }
+}
 
+/* 更新与容量相关的派生字段 */
+static void setCapacity(HashMapChaining *hashMap, size_t capacity) {
+    hashMap->capacity = capacity;
+    hashMap->mask = capacity - 1;
 #ifdef HASH_TABLE_AUTO_EXPAND
-    float loadThres; // 触发扩容的负载因子阈值
-    int extendRatio;  // 扩容倍数
+    hashMap->growAt = (size_t)((float)capacity * hashMap->loadThres);
+    hashMap->shrinkAt = capacity > hashMap->minCapacity ? hashMap->growAt / HASH_TABLE_SHRINK_DIVISOR : 0;
 #endif // HASH_TABLE_AUTO_EXPAND
+}
 
-    HashNode **buckets;   // 桶数组
-    void (*freeVal)(void*); // 释放val的回调函数，如果为NULL则不释放
-
-} HashMapChaining;
-
-static void extend(HashMapChaining *hashMap);
+/* 容纳 n 个键值对而不触发扩容的最小容量 */
+static size_t capacityFor(HashMapChaining *hashMap, size_t n) {
+#ifdef HASH_TABLE_AUTO_EXPAND
+    size_t capacity = (size_t)((float)n / hashMap->loadThres) + 1;
+    while ((size_t)((float)capacity * hashMap->loadThres) < n) {
+        capacity++;
+    }
+#else
+    size_t capacity = n > 0 ? n : 1;
+#endif // HASH_TABLE_AUTO_EXPAND
+    return hashMap->pow2Capacity ? roundUpPow2(capacity) : capacity;
+}
 
 /**
  * @brief 创建一个新的 HashMapChaining 对象
@@ -44,7 +76,32 @@ static void extend(HashMapChaining *hashMap);
  */
 HashMapChaining *newHashMapChaining(size_t capacity, void (*freeVal)(void*))
 {
-    if (capacity <= 0) {
+    HashMapChainingConfig config = defaultHashMapConfig(capacity, freeVal);
+    return newHashMapChainingWithConfig(&config);
+}
+
+/* 获取默认的哈希表创建参数 */
+HashMapChainingConfig defaultHashMapConfig(size_t capacity, void (*freeVal)(void*)) {
+    HashMapChainingConfig config;
+    config.capacity = capacity;
+    config.freeVal = freeVal;
+    config.pow2Capacity = false;
+    config.incrementalRehash = false;
+    config.hashKind = HASH_KIND_MURMUR;
+    config.hashSeed = 0;
+    config.autoShrink = false;
+    config.valSize = 0;
+    config.rehashThreads = 0;
+    config.cacheMaxEntries = 0;
+    config.cacheMaxBytes = 0;
+    config.cacheValBytes = NULL;
+    return config;
+}
+
+/* 按指定参数创建哈希表 */
+HashMapChaining *newHashMapChainingWithConfig(const HashMapChainingConfig *config)
+{
+    if (config == NULL || config->capacity <= 0) {
         return NULL; 
     }
     HashMapChaining *hashMap = (HashMapChaining *)malloc(sizeof(HashMapChaining));
@@ -53,21 +110,55 @@ HashMapChaining *newHashMapChaining(size_t capacity, void (*freeVal)(void*))
     }
 
     hashMap->size = 0;
-    hashMap->capacity = capacity;
-    hashMap->freeVal = freeVal;
+    // 内联值按 8 字节对齐存放在节点之后，不需要释放
+    hashMap->valSize = config->valSize;
+    hashMap->freeVal = config->valSize > 0 ? NULL : config->freeVal;
+    nodePoolInit(&hashMap->nodePool, sizeof(HashNode) + (config->valSize + 7) / 8 * 8);
 #ifdef HASH_TABLE_AUTO_EXPAND
     hashMap->loadThres = HASH_TABLE_LOAD_FACTOR;
     hashMap->extendRatio = HASH_TABLE_EXPAND_RATIO;
 #endif // HASH_TABLE_AUTO_EXPAND
-    hashMap->buckets = (HashNode **)malloc((size_t)hashMap->capacity * sizeof(HashNode *));
+    hashMap->pow2Capacity = config->pow2Capacity;
+    // 淘汰指针只扫描当前桶数组，缓存模式不使用渐进式扩容
+    hashMap->cacheMode = config->cacheMaxEntries > 0 || config->cacheMaxBytes > 0;
+    memset(&hashMap->cache, 0, sizeof(hashMap->cache));
+    hashMap->cache.maxEntries = config->cacheMaxEntries;
+    hashMap->cache.maxBytes = config->cacheMaxBytes;
+    hashMap->cache.valBytes = config->cacheValBytes;
+    hashMap->incrementalRehash = config->incrementalRehash && !hashMap->cacheMode;
+    hashMap->autoShrink = config->autoShrink;
+#ifdef HASH_TABLE_PINNED_HASH
+    hashMap->hashKind = HASH_TABLE_PINNED_HASH;
+#else
+    hashMap->hashKind = config->hashKind;
+#endif
+    hashMap->hashSeed = config->hashSeed != 0 ? config->hashSeed : hashRandomSeed(hashMap);
+    hashMap->oldBuckets = NULL;
+    hashMap->oldCapacity = 0;
+    hashMap->rehashIndex = 0;
+    hashMap->rehashThreads = config->rehashThreads;
+    hashMap->image = NULL;
+#ifdef HASH_TABLE_STATS
+    memset(&hashMap->stats, 0, sizeof(hashMap->stats));
+#endif
+    size_t capacity = config->pow2Capacity ? roundUpPow2(config->capacity) : config->capacity;
+    hashMap->minCapacity = capacity;
+#ifdef HASH_TABLE_AUTO_EXPAND
+    if (hashMap->cacheMode) {
+        // 缓存模式的桶数量不超过容纳 cacheMaxEntries 所需，淘汰后自动缩容，避免淘汰指针扫描大量空桶
+        if (config->cacheMaxEntries > 0 && capacityFor(hashMap, config->cacheMaxEntries) < capacity) {
+            capacity = capacityFor(hashMap, config->cacheMaxEntries);
+        }
+        hashMap->minCapacity = capacity < HASH_TABLE_CACHE_MIN_CAPACITY ? capacity : HASH_TABLE_CACHE_MIN_CAPACITY;
+        hashMap->autoShrink = true;
+    }
+#endif // HASH_TABLE_AUTO_EXPAND
+    setCapacity(hashMap, capacity);
+    hashMap->buckets = allocBuckets(hashMap->capacity);
     if (hashMap->buckets == NULL) {
         free(hashMap);
         return NULL;
     }
-
-    for (size_t i = 0; i < hashMap->capacity; i++) {
-        hashMap->buckets[i] = NULL;
-    }
     return hashMap;
 }
 
@@ -83,19 +174,23 @@ void delHashMapChaining(HashMapChaining *hashMap) {
         return;
     }
     
-    for (size_t i = 0; i < hashMap->capacity; i++) {
-        HashNode *cur = hashMap->buckets[i];
-        while (cur) {
-            HashNode *tmp = cur;
-            cur = cur->next;
-            // 如果设置了释放回调函数，则释放val指向的内存
-            if (hashMap->freeVal != NULL && tmp->pair.val != NULL) {
-                hashMap->freeVal(tmp->pair.val);
+    // 只有需要释放val时才遍历链表，节点本身随 slab 整体释放
+    if (hashMap->freeVal != NULL) {
+        finishRehash(hashMap);
+        for (size_t i = 0; i < hashMap->capacity; i++) {
+            for (HashNode *cur = hashMap->buckets[i]; cur; cur = cur->next) {
+                if (cur->pair.val != NULL) {
+                    hashMap->freeVal(cur->pair.val);
+                }
             }
-            free(tmp);
         }
     }
-    free(hashMap->buckets);
+    nodePoolDestroy(&hashMap->nodePool);
+    freeBuckets(hashMap->oldBuckets);
+    if (hashMap->image != NULL) {
+        free(hashMap->image);
+    }
+    freeBuckets(hashMap->buckets);
     free(hashMap);
 }
 
@@ -110,7 +205,7 @@ void delHashMapChaining(HashMapChaining *hashMap) {
  * @return 返回计算得到的哈希值，类型为int
  */
  size_t hashFunc(HashMapChaining *hashMap, int key) {
-    return (size_t)key % hashMap->capacity;
+    return indexFor(hashMap, keyHash(hashMap, key), hashMap->capacity);
 }
 
 /**
@@ -125,11 +220,51 @@ float loadFactor(HashMapChaining *hashMap) {
     return (float)hashMap->size / (float)hashMap->capacity;
 }
 
+/* 获取键值对数量 */
+size_t size(HashMapChaining *hashMap) {
+    return hashMap == NULL ? 0 : hashMap->size;
+}
+
+/* 判断哈希表是否为空 */
+bool isEmpty(HashMapChaining *hashMap) {
+    return size(hashMap) == 0;
+}
+
+/*
+ * 查找键所在节点的链接位置（指向该节点的 next 指针或桶头指针）
+ *
+ * 渐进式扩容期间，键可能位于新桶数组，也可能位于尚未迁移的旧桶中。
+ * 未找到时返回 NULL。probes 累加比较过的节点数。
+ */
+static HashNode **findLink(HashMapChaining *hashMap, int key, size_t *probes) {
+    uint64_t hash = keyHash(hashMap, key);
+    HashNode **link = &hashMap->buckets[indexFor(hashMap, hash, hashMap->capacity)];
+    for (; *link; link = &(*link)->next) {
+        ++*probes;
+        if ((*link)->pair.key == key) {
+            return link;
+        }
+    }
+
+    if (hashMap->oldBuckets != NULL) {
+        size_t oldIndex = indexFor(hashMap, hash, hashMap->oldCapacity);
+        if (oldIndex >= hashMap->rehashIndex) {
+            for (link = &hashMap->oldBuckets[oldIndex]; *link; link = &(*link)->next) {
+                ++*probes;
+                if ((*link)->pair.key == key) {
+                    return link;
+                }
+            }
+        }
+    }
+    return NULL;
+}
 
 /**
  * @brief 根据键从哈希表中获取值
  *
  * 从哈希表中获取与指定键对应的值。如果键存在，则返回对应的值；如果键不存在，则返回NULL。
+ * get 不会推进渐进式扩容，因此是只读操作，可以在迭代过程中或读锁保护下调用。
  *
  * @param hashMap 哈希表的指针
  * @param key 要查找的键
@@ -141,142 +276,527 @@ void *get(HashMapChaining *hashMap, int key) {
         return NULL;
     }
     
-    size_t index = hashFunc(hashMap, key);
+    uint64_t hash = keyHash(hashMap, key);
+    size_t probes = 0;
     // 遍历桶，若找到 key ，则返回对应 val
-    HashNode *cur = hashMap->buckets[index];
-    while (cur) {
-        if (cur->pair.key == key) {
-            return cur->pair.val;
-        }
+    HashNode *cur = hashMap->buckets[indexFor(hashMap, hash, hashMap->capacity)];
+    while (cur && cur->pair.key != key) {
+        probes++;
         cur = cur->next;
     }
-    return NULL; 
+
+    // 渐进式扩容期间，新桶中没有时再查找尚未迁移的旧桶，复用同一个哈希值，新链表只遍历一次
+    if (cur == NULL && hashMap->oldBuckets != NULL) {
+        size_t oldIndex = indexFor(hashMap, hash, hashMap->oldCapacity);
+        if (oldIndex >= hashMap->rehashIndex) {
+            cur = hashMap->oldBuckets[oldIndex];
+            while (cur && cur->pair.key != key) {
+                probes++;
+                cur = cur->next;
+            }
+        }
+    }
+
+    probes += cur != NULL;
+    HASH_STATS_PROBE(hashMap, get, cur != NULL, probes);
+    if (hashMap->cacheMode) {
+        cacheRecord(hashMap, cur);
+    }
+    return cur ? cur->pair.val : NULL;
 }
 
-/* 添加操作 */
-void put(HashMapChaining *hashMap, int key, const void *val) {
-    if (hashMap == NULL || val == NULL) {
+/*
+ * 将一条旧链表中的节点移动到当前桶数组
+ *
+ * 容量为 2 的幂且扩容倍数为 2 时，旧桶 i 中的节点只会落到新桶 i 或 i + oldCapacity，
+ * 由哈希值中对应旧容量的那一位决定。按该位把链表拆成两条，保持节点原有顺序后整体接到新桶头部；
+ * 其它情况逐个节点重新计算桶索引并头插到新桶。
+ */
+static void migrateChain(HashMapChaining *hashMap, HashNode *chain, size_t oldIndex, size_t oldCapacity)
+{
+    if (hashMap->pow2Capacity && hashMap->capacity == oldCapacity * 2) {
+        HashNode *loHead = NULL, *loTail = NULL;
+        HashNode *hiHead = NULL, *hiTail = NULL;
+        for (HashNode *cur = chain; cur; cur = cur->next) {
+            if ((keyHash(hashMap, cur->pair.key) & oldCapacity) == 0) {
+                if (loTail) {
+                    loTail->next = cur;
+                } else {
+                    loHead = cur;
+                }
+                loTail = cur;
+            } else {
+                if (hiTail) {
+                    hiTail->next = cur;
+                } else {
+                    hiHead = cur;
+                }
+                hiTail = cur;
+            }
+        }
+        if (loTail) {
+            loTail->next = hashMap->buckets[oldIndex];
+            hashMap->buckets[oldIndex] = loHead;
+        }
+        if (hiTail) {
+            hiTail->next = hashMap->buckets[oldIndex + oldCapacity];
+            hashMap->buckets[oldIndex + oldCapacity] = hiHead;
+        }
         return;
     }
+
+    while (chain) {
+        HashNode *next = chain->next;
+        size_t index = hashFunc(hashMap, chain->pair.key);
+        chain->next = hashMap->buckets[index];
+        hashMap->buckets[index] = chain;
+        chain = next;
+    }
+}
+
+/* 切换到新的桶数组，返回旧桶数组，分配失败时返回 NULL 且哈希表保持不变 */
+static HashNode **swapBuckets(HashMapChaining *hashMap, size_t newCapacity)
+{
+    HashNode **newBuckets = allocBuckets(newCapacity);
+    if (newBuckets == NULL) {
+        return NULL;
+    }
+    HashNode **oldBuckets = hashMap->buckets;
+    hashMap->buckets = newBuckets;
+    setCapacity(hashMap, newCapacity);
+    return oldBuckets;
+}
+
+/* 多线程迁移的参数 */
+typedef struct {
+    HashMapChaining *hashMap;
+    HashNode **oldBuckets;
+    size_t oldCapacity;
+} MigrateTask;
+
+/* 迁移旧桶区间 [begin, end) */
+static void migrateRange(size_t begin, size_t end, size_t worker, void *ctx)
+{
+    (void)worker;
+    MigrateTask *task = (MigrateTask *)ctx;
+    for (size_t i = begin; i < end; i++) {
+        migrateChain(task->hashMap, task->oldBuckets[i], i, task->oldCapacity);
+    }
+}
+
+/*
+ * 多线程迁移全部旧桶
+ *
+ * 容量为 2 的幂且新容量是旧容量的整数倍时，新桶 j 中的节点只来自旧桶 j & (oldCapacity - 1)，
+ * 各线程处理互不相交的旧桶区间，写入的新桶也互不相交，不需要任何同步。
+ * 每个旧桶仍由 migrateChain 迁移，结果与单线程完全相同。
+ * 不满足条件或线程创建失败时返回false，由调用者单线程迁移。
+ */
+static bool migrateParallel(HashMapChaining *hashMap, HashNode **oldBuckets, size_t oldCapacity)
+{
+    if (hashMap->rehashThreads <= 1 || !hashMap->pow2Capacity || oldCapacity < HASH_TABLE_PARALLEL_REHASH_MIN ||
+        hashMap->capacity <= oldCapacity || hashMap->capacity % oldCapacity != 0) {
+        return false;
+    }
+    ThreadPool *pool = newThreadPool(hashMap->rehashThreads);
+    if (pool == NULL) {
+        return false;
+    }
+    MigrateTask task = {hashMap, oldBuckets, oldCapacity};
+    threadPoolParallelFor(pool, oldCapacity, HASH_TABLE_PARALLEL_REHASH_GRAIN, migrateRange, &task);
+    delThreadPool(pool);
+    return true;
+}
+
+/*
+ * 将哈希表重新散列到 newCapacity 个桶中
+ *
+ * 只分配新的桶数组，已有节点直接移动到新桶，不分配也不释放节点，
+ * 也不需要检查重复键。失败时哈希表保持不变。
+ */
+static bool rehash(HashMapChaining *hashMap, size_t newCapacity)
+{
+    finishRehash(hashMap);
+
+    // 暂存原哈希表
+    size_t oldCapacity = hashMap->capacity;
+    HashNode **oldBuckets = swapBuckets(hashMap, newCapacity);
+    if (oldBuckets == NULL) {
+        return false;
+    }
+
+    // 将节点从原哈希表搬运至新哈希表
+    if (!migrateParallel(hashMap, oldBuckets, oldCapacity)) {
+        for (size_t i = 0; i < oldCapacity; i++) {
+            migrateChain(hashMap, oldBuckets[i], i, oldCapacity);
+        }
+    }
+
+    freeBuckets(oldBuckets);
+    return true;
+}
+
+/*
+ * 渐进式扩容：迁移最多 steps 个非空旧桶
+ *
+ * 为了限制单次操作的耗时，连续跳过的空桶数量也有上限。
+ * 旧桶全部迁移完后释放旧桶数组。
+ */
+static void rehashStep(HashMapChaining *hashMap, size_t steps)
+{
+    size_t emptyVisits = steps * 10;
+    while (steps > 0 && hashMap->rehashIndex < hashMap->oldCapacity) {
+        size_t i = hashMap->rehashIndex;
+        HashNode *chain = hashMap->oldBuckets[i];
+        if (chain == NULL) {
+            hashMap->rehashIndex++;
+            if (--emptyVisits == 0) {
+                break;
+            }
+            continue;
+        }
+        hashMap->oldBuckets[i] = NULL;
+        migrateChain(hashMap, chain, i, hashMap->oldCapacity);
+        hashMap->rehashIndex++;
+        steps--;
+    }
+
+    if (hashMap->rehashIndex >= hashMap->oldCapacity) {
+        freeBuckets(hashMap->oldBuckets);
+        hashMap->oldBuckets = NULL;
+        hashMap->oldCapacity = 0;
+        hashMap->rehashIndex = 0;
+    }
+}
+
+/* put/removeItem 中推进渐进式扩容 */
+static void advanceRehash(HashMapChaining *hashMap)
+{
+#ifdef HASH_TABLE_STATS
+    uint64_t start = statsNowNs();
+    rehashStep(hashMap, HASH_TABLE_REHASH_STEP);
+    hashMap->stats.extendNs += statsNowNs() - start;
+#else
+    rehashStep(hashMap, HASH_TABLE_REHASH_STEP);
+#endif
+}
+
+/* 一次性完成正在进行的渐进式扩容 */
+static void finishRehash(HashMapChaining *hashMap)
+{
+    if (hashMap->oldBuckets != NULL) {
+        rehashStep(hashMap, hashMap->oldCapacity);
+    }
+}
+
+/* 扩容哈希表 */
+static void growBuckets(HashMapChaining *hashMap)
+{
+    size_t newCapacity = hashMap->capacity * (size_t)hashMap->extendRatio;
+    if (!hashMap->incrementalRehash) {
+        // 扩容失败时保持原容量，后续插入仍然可以进行
+        rehash(hashMap, newCapacity);
+        return;
+    }
+
+    // 渐进式扩容：只切换桶数组，节点在之后的 put/removeItem 中逐步迁移
+    if (hashMap->oldBuckets != NULL) {
+        return;
+    }
+    size_t oldCapacity = hashMap->capacity;
+    HashNode **oldBuckets = swapBuckets(hashMap, newCapacity);
+    if (oldBuckets != NULL) {
+        hashMap->oldBuckets = oldBuckets;
+        hashMap->oldCapacity = oldCapacity;
+        hashMap->rehashIndex = 0;
+    }
+}
+
+/* 扩容哈希表，开启统计时记录次数和耗时 */
+static void extend(HashMapChaining *hashMap)
+{
+    if (hashMap == NULL) {
+        return;
+    }
+#ifdef HASH_TABLE_STATS
+    uint64_t start = statsNowNs();
+    growBuckets(hashMap);
+    hashMap->stats.extendCount++;
+    hashMap->stats.extendNs += statsNowNs() - start;
+#else
+    growBuckets(hashMap);
+#endif
+}
+
+/* 预留容量 */
+void reserve(HashMapChaining *hashMap, size_t n) {
+    if (hashMap == NULL) {
+        return;
+    }
+    size_t capacity = capacityFor(hashMap, n);
+    if (capacity > hashMap->capacity) {
+        rehash(hashMap, capacity);
+    }
+}
+
+/* 收缩桶数组 */
+void shrinkToFit(HashMapChaining *hashMap) {
+    if (hashMap == NULL) {
+        return;
+    }
+    size_t capacity = capacityFor(hashMap, hashMap->size);
+    if (capacity < hashMap->capacity) {
+        rehash(hashMap, capacity);
+    }
+}
+
+#ifdef HASH_TABLE_AUTO_EXPAND
+/* 自动缩容：缩到负载因子约为阈值一半的大小，不低于创建时的容量 */
+static void shrink(HashMapChaining *hashMap)
+{
+    size_t capacity = capacityFor(hashMap, hashMap->size * 2);
+    if (capacity < hashMap->minCapacity) {
+        capacity = hashMap->minCapacity;
+    }
+    if (capacity < hashMap->capacity) {
+        rehash(hashMap, capacity);
+    }
+}
+#endif // HASH_TABLE_AUTO_EXPAND
+
+/* 设置节点的值：内联模式拷贝 valSize 字节（val 为 NULL 时清零），否则保存指针 */
+static void storeValue(HashMapChaining *hashMap, HashNode *node, const void *val) {
+    if (hashMap->valSize == 0) {
+        node->pair.val = (void*)val;
+    } else if (val != NULL) {
+        memcpy(node->pair.val, val, hashMap->valSize);
+    } else {
+        memset(node->pair.val, 0, hashMap->valSize);
+    }
+}
+
+/*
+ * 缓存模式下写入后按上限淘汰，再按剩余数量缩容
+ *
+ * 淘汰指针逐个桶扫描，缩容保证负载因子不低于 HASH_TABLE_LOAD_FACTOR / HASH_TABLE_SHRINK_DIVISOR
+ * （桶数量为 HASH_TABLE_CACHE_MIN_CAPACITY 时除外），扫描过的空桶才能摊到节点上。
+ * 迭代器的 removeCurrent 不缩容，留到下一次 put 处理。
+ */
+static void cacheTrim(HashMapChaining *hashMap, const HashNode *keep) {
+    cacheEvict(hashMap, keep);
+#ifdef HASH_TABLE_AUTO_EXPAND
+    if (hashMap->size < hashMap->shrinkAt) {
+        shrink(hashMap);
+    }
+#endif
+}
+
+/* 插入或更新键值对，返回键所在的节点，内存分配失败时返回 NULL */
+static HashNode *upsert(HashMapChaining *hashMap, int key, const void *val) {
+    if (hashMap->oldBuckets != NULL) {
+        advanceRehash(hashMap);
+    }
     
 #ifdef HASH_TABLE_AUTO_EXPAND
     // 当负载因子超过阈值时，执行扩容
-    if (loadFactor(hashMap) > hashMap->loadThres) {
+    if (hashMap->size > hashMap->growAt) {
         extend(hashMap);
     }
 #endif
     
-    size_t index = hashFunc(hashMap, key);
-    // 遍历桶，若遇到指定 key ，则更新对应 val 并返回
-    HashNode *cur = hashMap->buckets[index];
-    while (cur) {
-        if (cur->pair.key == key) {
-            // 注意：这里假设调用者已经正确管理了val指向的内存
-            // 如果需要深拷贝，调用者应该在传入前处理
-            cur->pair.val = (void*)val;
-            return;
+    // 若遇到指定 key ，则更新对应 val 并返回
+    size_t probes = 0;
+    HashNode **link = findLink(hashMap, key, &probes);
+    HASH_STATS_PROBE(hashMap, put, link != NULL, probes);
+    if (link != NULL) {
+        // 注意：这里假设调用者已经正确管理了val指向的内存
+        // 如果需要深拷贝，调用者应该在传入前处理
+        HashNode *node = *link;
+        if (hashMap->cacheMode) {
+            // 新值的大小可能不同，更新后同样可能超过字节数上限
+            hashMap->cache.bytes -= cacheCharge(hashMap, node->pair.val);
+            storeValue(hashMap, node, val);
+            hashMap->cache.bytes += cacheCharge(hashMap, node->pair.val);
+            node->pair.referenced = true;
+            cacheTrim(hashMap, node);
+            return node;
         }
-        cur = cur->next;
+        storeValue(hashMap, node, val);
+        return node;
     }
     
-    HashNode *newNode = (HashNode *)malloc(sizeof(HashNode));
+    // 新键总是插入当前桶数组
+    size_t index = hashFunc(hashMap, key);
+    HashNode *newNode = (HashNode *)nodePoolAlloc(&hashMap->nodePool);
     if (newNode == NULL) {
-        return; // 内存分配失败
+        return NULL; // 内存分配失败
     }
     newNode->pair.key = key;
-    newNode->pair.val = (void*)val;
+    newNode->pair.referenced = false;
+    // 内联值紧跟在节点之后，节点只在桶之间移动，不会被复制，指针始终有效
+    newNode->pair.val = hashMap->valSize > 0 ? (void *)(newNode + 1) : NULL;
+    storeValue(hashMap, newNode, val);
     newNode->next = hashMap->buckets[index];
     hashMap->buckets[index] = newNode;
     hashMap->size++;
+    if (hashMap->cacheMode) {
+        hashMap->cache.bytes += cacheCharge(hashMap, newNode->pair.val);
+        cacheTrim(hashMap, newNode);
+    }
+    return newNode;
 }
 
-/* 扩容哈希表 */
-static void extend(HashMapChaining *hashMap)
-{
+/* 添加操作 */
+void put(HashMapChaining *hashMap, int key, const void *val) {
+    if (hashMap == NULL || val == NULL) {
+        return;
+    }
+    upsert(hashMap, key, val);
+}
+
+/* 按值拷贝添加 */
+void *putCopy(HashMapChaining *hashMap, int key, const void *val) {
+    if (hashMap == NULL || (val == NULL && hashMap->valSize == 0)) {
+        return NULL;
+    }
+    HashNode *node = upsert(hashMap, key, val);
+    return node != NULL ? node->pair.val : NULL;
+}
+
+/* 获取值的地址 */
+void *getPtr(HashMapChaining *hashMap, int key) {
+    return get(hashMap, key);
+}
+
+/* 删除操作 */
+void removeItem(HashMapChaining *hashMap, int key) {
     if (hashMap == NULL) {
         return;
     }
+
+    if (hashMap->oldBuckets != NULL) {
+        advanceRehash(hashMap);
+    }
     
-    // 暂存原哈希表
-    size_t oldCapacity = (size_t)hashMap->capacity;
-    HashNode **oldBuckets = hashMap->buckets;
-    
-    // 初始化扩容后的新哈希表
-    hashMap->capacity *= (size_t)hashMap->extendRatio;
-    hashMap->buckets = (HashNode **)malloc((size_t)hashMap->capacity * sizeof(HashNode *));
-    if (hashMap->buckets == NULL) {
-        // 恢复原始容量，扩容失败
-        hashMap->capacity = (size_t)oldCapacity;
-        hashMap->buckets = oldBuckets;
+    size_t probes = 0;
+    HashNode **link = findLink(hashMap, key, &probes);
+    HASH_STATS_PROBE(hashMap, remove, link != NULL, probes);
+    if (link == NULL) {
         return;
     }
-    
-    for (size_t i = 0; i < hashMap->capacity; i++) {
-        hashMap->buckets[i] = NULL;
+
+    // 从中删除键值对
+    HashNode *cur = *link;
+    *link = cur->next;
+    if (hashMap->cacheMode) {
+        hashMap->cache.bytes -= cacheCharge(hashMap, cur->pair.val);
     }
-    hashMap->size = 0;
-    
-    // 将键值对从原哈希表搬运至新哈希表
-    for (size_t i = 0; i < oldCapacity; i++) {
-        HashNode *cur = oldBuckets[i];
+    // 如果设置了释放回调函数，则释放val指向的内存
+    if (hashMap->freeVal != NULL && cur->pair.val != NULL) {
+        hashMap->freeVal(cur->pair.val);
+    }
+
+    nodePoolFree(&hashMap->nodePool, cur);
+    hashMap->size--;
+
+#ifdef HASH_TABLE_AUTO_EXPAND
+    if (hashMap->autoShrink && hashMap->size < hashMap->shrinkAt) {
+        shrink(hashMap);
+    }
+#endif
+}
+
+/* 打印一个桶数组 */
+static void printBuckets(HashNode **buckets, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        HashNode *cur = buckets[i];
+        printf("[");
         while (cur) {
-            put(hashMap, cur->pair.key, cur->pair.val);
-            HashNode *temp = cur;
+            printf("%d -> %p, ", cur->pair.key, cur->pair.val);
             cur = cur->next;
-            // 只释放节点内存，不释放val指向的内存
-            free(temp);
         }
+        printf("]\n");
     }
-
-    free(oldBuckets);
 }
 
-/* 删除操作 */
-void removeItem(HashMapChaining *hashMap, int key) {
+/* 打印哈希表 */
+void print(HashMapChaining *hashMap) {
     if (hashMap == NULL) {
         return;
     }
     
-    size_t index = hashFunc(hashMap, key);
-    HashNode *cur = hashMap->buckets[index];
-    HashNode *pre = NULL;
-    while (cur) {
-        if (cur->pair.key == key) {
-            // 从中删除键值对
-            if (pre) {
-                pre->next = cur->next;
-            } else {
-                hashMap->buckets[index] = cur->next;
-            }
-            // 如果设置了释放回调函数，则释放val指向的内存
-            if (hashMap->freeVal != NULL && cur->pair.val != NULL) {
-                hashMap->freeVal(cur->pair.val);
-            }
+    printBuckets(hashMap->buckets, 0, hashMap->capacity);
+    if (hashMap->oldBuckets != NULL) {
+        printf("(渐进式扩容中，尚未迁移的旧桶)\n");
+        printBuckets(hashMap->oldBuckets, hashMap->rehashIndex, hashMap->oldCapacity);
+    }
+}
 
-            free(cur);
-            hashMap->size--;
-            return;
+/* 统计一个桶数组的链长分布 */
+static void countChains(HashNode **buckets, size_t begin, size_t end, size_t *histogram, size_t bins) {
+    for (size_t i = begin; i < end; i++) {
+        size_t length = 0;
+        for (HashNode *cur = buckets[i]; cur; cur = cur->next) {
+            length++;
         }
-        pre = cur;
-        cur = cur->next;
+        histogram[length < bins ? length : bins - 1]++;
     }
 }
 
-/* 打印哈希表 */
-void print(HashMapChaining *hashMap) {
-    if (hashMap == NULL) {
+/* 统计链长分布 */
+void chainLengthHistogram(HashMapChaining *hashMap, size_t *histogram, size_t bins) {
+    if (hashMap == NULL || histogram == NULL || bins == 0) {
         return;
     }
-    
-    for (size_t i = 0; i < hashMap->capacity; i++) {
-        HashNode *cur = hashMap->buckets[i];
-        printf("[");
-        while (cur) {
-            printf("%d -> %p, ", cur->pair.key, cur->pair.val);
-            cur = cur->next;
+
+    for (size_t i = 0; i < bins; i++) {
+        histogram[i] = 0;
+    }
+    countChains(hashMap->buckets, 0, hashMap->capacity, histogram, bins);
+    if (hashMap->oldBuckets != NULL) {
+        countChains(hashMap->oldBuckets, hashMap->rehashIndex, hashMap->oldCapacity, histogram, bins);
+    }
+}
+
+/* 迭代器当前所在的桶数组 */
+static HashNode **iteratorBuckets(HashMapIterator *iterator) {
+    return iterator->inOldBuckets ? iterator->hashMap->oldBuckets : iterator->hashMap->buckets;
+}
+
+/*
+ * 从迭代器当前桶数组的 start 号桶开始查找下一个非空桶
+ *
+ * 渐进式扩容期间先遍历尚未迁移的旧桶，再遍历新桶数组。
+ * 找到时更新迭代器位置并返回true。
+ */
+static bool seekBucket(HashMapIterator *iterator, size_t start) {
+    HashMapChaining *hashMap = iterator->hashMap;
+    iterator->prevNode = NULL; // 新桶的第一个节点没有前驱
+
+    if (iterator->inOldBuckets) {
+        for (size_t i = start; i < hashMap->oldCapacity; i++) {
+            if (hashMap->oldBuckets[i] != NULL) {
+                iterator->bucketIndex = i;
+                iterator->currentNode = hashMap->oldBuckets[i];
+                return true;
+            }
+        }
+        iterator->inOldBuckets = false;
+        start = 0;
+    }
+
+    for (size_t i = start; i < hashMap->capacity; i++) {
+        if (hashMap->buckets[i] != NULL) {
+            iterator->bucketIndex = i;
+            iterator->currentNode = hashMap->buckets[i];
+            return true;
         }
-        printf("]\n");
     }
+
+    // 所有桶都已经遍历完
+    iterator->currentNode = NULL;
+    iterator->hasNext = false;
+    return false;
 }
 
 /* 初始化哈希表迭代器 */
@@ -287,17 +807,13 @@ HashMapIterator initIterator(HashMapChaining *hashMap) {
     iterator.currentNode = NULL;
     iterator.prevNode = NULL;
     iterator.hasNext = false;
+    iterator.inOldBuckets = false;
     
     if (hashMap != NULL && hashMap->size > 0) {
         // 找到第一个非空桶
-        for (size_t i = 0; i < hashMap->capacity; i++) {
-            if (hashMap->buckets[i] != NULL) {
-                iterator.bucketIndex = i;
-                iterator.currentNode = hashMap->buckets[i];
-                iterator.hasNext = true;
-                break;
-            }
-        }
+        iterator.hasNext = true;
+        iterator.inOldBuckets = hashMap->oldBuckets != NULL;
+        seekBucket(&iterator, hashMap->oldBuckets != NULL ? hashMap->rehashIndex : 0);
     }
     
     return iterator;
@@ -349,19 +865,23 @@ void removeCurrent(HashMapIterator *iterator) {
     // 从链表中删除当前节点
     if (prevNode == NULL) {
         // 当前节点是桶的第一个节点
-        hashMap->buckets[bucketIndex] = nextNode;
+        iteratorBuckets(iterator)[bucketIndex] = nextNode;
     } else {
         // 当前节点不是桶的第一个节点
         ((HashNode *)prevNode)->next = nextNode;
     }
     
+    if (hashMap->cacheMode) {
+        hashMap->cache.bytes -= cacheCharge(hashMap, currentNode->pair.val);
+    }
+
     // 如果设置了释放回调函数，则释放val指向的内存
     if (hashMap->freeVal != NULL && currentNode->pair.val != NULL) {
         hashMap->freeVal(currentNode->pair.val);
     }
     
     // 释放当前节点
-    free(currentNode);
+    nodePoolFree(&hashMap->nodePool, currentNode);
     hashMap->size--;
     
     // 更新迭代器状态
@@ -371,21 +891,7 @@ void removeCurrent(HashMapIterator *iterator) {
         // prevNode保持不变，因为我们删除了currentNode
     } else {
         // 当前桶已经遍历完，需要找下一个非空桶
-        iterator->currentNode = NULL;
-        iterator->prevNode = NULL;
-        
-        // 查找下一个非空桶
-        for (size_t i = bucketIndex + 1; i < hashMap->capacity; i++) {
-            if (hashMap->buckets[i] != NULL) {
-                iterator->bucketIndex = i;
-                iterator->currentNode = hashMap->buckets[i];
-                iterator->hasNext = true;
-                return;
-            }
-        }
-        
-        // 所有桶都已经遍历完
-        iterator->hasNext = false;
+        seekBucket(iterator, bucketIndex + 1);
     }
 }
 
@@ -407,18 +913,5 @@ void next(HashMapIterator *iterator) {
     }
     
     // 当前链表已经遍历完，需要找下一个非空桶
-    for (size_t i = iterator->bucketIndex + 1; i < iterator->hashMap->capacity; i++) {
-        if (iterator->hashMap->buckets[i] != NULL) {
-            iterator->bucketIndex = i;
-            iterator->currentNode = iterator->hashMap->buckets[i];
-            iterator->prevNode = NULL; // 新桶的第一个节点没有前驱
-            return;
-        }
-    }
-    
-    // 所有桶都已经遍历完
-    iterator->hasNext = false;
-    iterator->currentNode = NULL;
-    iterator->prevNode = NULL;
+    seekBucket(iterator, iterator->bucketIndex + 1);
 }
-
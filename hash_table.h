@@ -3,16 +3,90 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include "hash_func.h"
+#include "thread_pool.h"
 
 #define HASH_TABLE_AUTO_EXPAND  // 哈希表自动扩容
 #ifdef HASH_TABLE_AUTO_EXPAND
 #define HASH_TABLE_LOAD_FACTOR 0.75  // 负载因子
 #define HASH_TABLE_EXPAND_RATIO 2 // 扩容倍数
+#define HASH_TABLE_REHASH_STEP 4  // 渐进式扩容时每次 put/removeItem 迁移的非空桶数量
+#define HASH_TABLE_SHRINK_DIVISOR 4 // 开启自动缩容时，负载因子低于 LOAD_FACTOR / 4 触发缩容
+#define HASH_TABLE_CACHE_MIN_CAPACITY 16 // 缓存模式自动缩容的下限
 #endif
 
+#define HASH_TABLE_BATCH_GROUP 16  // 批量操作每组处理的键数量，组内的内存访问相互重叠
+
+#define HASH_TABLE_PARALLEL_REHASH_MIN 65536  // 旧桶数量不少于该值时才多线程扩容，更小的表创建线程得不偿失
+#define HASH_TABLE_PARALLEL_REHASH_GRAIN 4096 // 多线程扩容时每个线程每次领取的旧桶数量
+#define HASH_TABLE_PARALLEL_BLOCK 512         // 并行遍历时每块的桶数量（桶数组中的 64 个缓存行），块是领取和窃取的单位
+
+#define HASH_TABLE_STATS_BINS 16  // 统计信息中链长分布的组数
+
+// 开启热路径统计：get/put/removeItem 记录探测长度，扩容记录次数和耗时，默认不编译。
+// 改变了哈希表的内部结构，必须对所有源文件统一定义（在这里或通过编译选项）
+// #define HASH_TABLE_STATS
+
+// 在编译期固定哈希策略，此时创建参数中的 hashKind 被忽略，哈希计算可以完全内联
+// #define HASH_TABLE_PINNED_HASH HASH_KIND_MURMUR
+
 /* 链式地址哈希表 */
 typedef struct HashMapChaining HashMapChaining;
 
+/* 哈希表创建参数 */
+typedef struct {
+    size_t capacity;          // 初始桶数量，必须大于0
+    void (*freeVal)(void*);   // val 值释放函数，不需要释放时为 NULL
+    bool pow2Capacity;        // 桶数量取 2 的幂，定位桶时用掩码代替取模
+    bool incrementalRehash;   // 渐进式扩容：新旧桶数组并存，每次 put/removeItem 迁移少量桶
+    HashKind hashKind;        // 哈希策略，默认 HASH_KIND_MURMUR
+    uint64_t hashSeed;        // HASH_KIND_MURMUR 和 HASH_KIND_WYHASH 使用的种子，为 0 时随机生成
+    bool autoShrink;          // removeItem 后负载因子过低时自动缩容，不会缩到 capacity 以下
+    size_t valSize;           // 大于0时值按该字节数拷贝到节点中（内联存放），freeVal 被忽略
+    size_t rehashThreads;     // 大于1时一次性扩容（含 reserve）使用的线程数，要求 pow2Capacity，默认 0 即单线程
+    size_t cacheMaxEntries;   // 大于0时为缓存模式：键值对数量超过该值时淘汰，见 hashMapCacheStats
+    size_t cacheMaxBytes;     // 大于0时为缓存模式：占用字节数（节点加 cacheValBytes）超过该值时淘汰
+    size_t (*cacheValBytes)(const void *val); // 缓存模式下非内联值占用的字节数，为 NULL 时只计节点大小
+} HashMapChainingConfig;
+
+/* 一类操作的探测长度统计，探测长度为比较过的节点数 */
+typedef struct {
+    size_t hits;          // 找到键的次数
+    size_t misses;        // 未找到键的次数
+    size_t hitProbes;     // 找到键时的探测长度之和
+    size_t missProbes;    // 未找到键时的探测长度之和
+    size_t maxHitProbe;   // 找到键时的最大探测长度
+    size_t maxMissProbe;  // 未找到键时的最大探测长度
+} HashProbeStats;
+
+/* 哈希表统计信息 */
+typedef struct {
+    bool enabled;           // 是否定义了 HASH_TABLE_STATS，为false时探测和扩容计数都为0
+    size_t size;            // 键值对数量
+    size_t capacity;        // 桶数量
+    float loadFactor;       // 负载因子
+    HashProbeStats get;     // get 和 getBatch
+    HashProbeStats put;     // put，找到键表示更新已有键，未找到表示插入新键
+    HashProbeStats remove;  // removeItem
+    size_t extendCount;     // 扩容次数
+    uint64_t extendNs;      // 扩容耗时（纳秒），渐进式扩容包括之后逐步迁移的耗时
+    size_t maxChain;        // 最长链表的长度
+    size_t chainHistogram[HASH_TABLE_STATS_BINS]; // 链长分布，与 chainLengthHistogram 相同
+} HashMapStats;
+
+/* 缓存模式计数器 */
+typedef struct {
+    bool enabled;       // 是否为缓存模式，为false时其它字段都为0
+    size_t hits;        // get 和 getBatch 找到键的次数
+    size_t misses;      // get 和 getBatch 未找到键的次数
+    size_t evictions;   // 被淘汰的键值对数量
+    size_t entries;     // 当前键值对数量
+    size_t bytes;       // 当前占用的字节数
+    size_t maxEntries;  // 键值对数量上限，0 表示不限制
+    size_t maxBytes;    // 字节数上限，0 表示不限制
+} HashCacheStats;
+
 /* 哈希表迭代器 */
 typedef struct {
     HashMapChaining *hashMap;  // 迭代器所属的哈希表
@@ -20,6 +94,7 @@ typedef struct {
     void *currentNode;         // 当前节点指针
     void *prevNode;           // 前驱节点指针，用于删除当前节点
     bool hasNext;              // 是否有下一个元素
+    bool inOldBuckets;         // 是否正在遍历渐进式扩容中尚未迁移的旧桶
 } HashMapIterator;
 
 /**
@@ -34,6 +109,29 @@ typedef struct {
  */
  HashMapChaining *newHashMapChaining(size_t capacity, void (*freeVal)(void*));
 
+/**
+ * @brief 获取默认的哈希表创建参数
+ *
+ * 返回的参数与 newHashMapChaining 使用的参数相同，调用者可以在此基础上修改个别字段。
+ *
+ * @param capacity 哈希表的容量，即桶的数量。
+ * @param freeVal val 值释放函数指针，如果不需要释放，可以传递 NULL。
+ *
+ * @return 返回默认创建参数
+ */
+HashMapChainingConfig defaultHashMapConfig(size_t capacity, void (*freeVal)(void*));
+
+/**
+ * @brief 按指定参数创建一个新的 HashMapChaining 对象
+ *
+ * 开启 pow2Capacity 时，初始容量会向上取整为 2 的幂，扩容倍数也必须是 2 的幂。
+ *
+ * @param config 创建参数，不能为 NULL
+ *
+ * @return 成功时返回新创建的 HashMapChaining 对象指针，失败时返回 NULL。
+ */
+HashMapChaining *newHashMapChainingWithConfig(const HashMapChainingConfig *config);
+
 /**
  * @brief 删除哈希表（链表法）
  *
@@ -46,7 +144,7 @@ void delHashMapChaining(HashMapChaining *hashMap);
 /**
  * @brief 哈希函数，计算给定键的哈希值
  *
- * 根据给定的哈希表（使用链表法处理冲突）和键，计算该键的哈希值。
+ * 根据给定的哈希表（使用链表法处理冲突）和键，按哈希表的哈希策略计算该键所在的桶索引。
  *
  * @param hashMap 哈希表指针，类型为HashMapChaining*
  * @param key 需要计算哈希值的键，类型为int
@@ -65,6 +163,43 @@ void delHashMapChaining(HashMapChaining *hashMap);
  */
 float loadFactor(HashMapChaining *hashMap);
 
+/**
+ * @brief 获取哈希表中的键值对数量
+ *
+ * @param hashMap 哈希表的指针
+ * @return 返回键值对数量，hashMap 为 NULL 时返回0
+ */
+size_t size(HashMapChaining *hashMap);
+
+/**
+ * @brief 判断哈希表是否为空
+ *
+ * @param hashMap 哈希表的指针
+ * @return 没有键值对时返回true，否则返回false
+ */
+bool isEmpty(HashMapChaining *hashMap);
+
+/**
+ * @brief 预留容量
+ *
+ * 一次性把桶数组扩大到插入 n 个键值对都不会触发扩容的大小，之后的插入不再经历中间各次扩容。
+ * 当前容量已经足够时不做任何操作；分配失败时哈希表保持不变。
+ *
+ * @param hashMap 哈希表的指针
+ * @param n 预计的键值对数量
+ */
+void reserve(HashMapChaining *hashMap, size_t n);
+
+/**
+ * @brief 收缩桶数组
+ *
+ * 把桶数组缩小到能容纳当前键值对而不触发扩容的最小大小，释放多余的桶并缩短迭代时扫描的空桶。
+ * 节点直接移动到新桶，不重新分配；分配失败时哈希表保持不变。
+ *
+ * @param hashMap 哈希表的指针
+ */
+void shrinkToFit(HashMapChaining *hashMap);
+
 /**
  * @brief 根据键从哈希表中获取值
  *
@@ -88,16 +223,154 @@ void *get(HashMapChaining *hashMap, int key);
  */
 void put(HashMapChaining *hashMap, int key, const void *val);
 
+/**
+ * @brief 按值拷贝添加键值对
+ *
+ * 用于以 valSize 创建的哈希表：把 val 指向的 valSize 字节拷贝到节点中，节点和值在同一块内存里，
+ * 不需要为值单独分配，也不需要 freeVal。val 为 NULL 时值被清零。键已存在时覆盖原值。
+ * 内联模式下 put 的行为与 putCopy 相同；非内联模式下与 put 相同。
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要添加的键
+ * @param val 值的来源地址
+ * @return 返回节点中值的地址，可以直接原地修改；内存分配失败时返回NULL
+ */
+void *putCopy(HashMapChaining *hashMap, int key, const void *val);
+
+/**
+ * @brief 获取值的地址
+ *
+ * 内联模式下返回节点中值的地址，可以原地读写，直到该键被删除或哈希表被删除；
+ * 非内联模式下与 get 相同。
+ *
+ * @param hashMap 哈希表的指针
+ * @param key 要查找的键
+ * @return 返回值的地址，键不存在时返回NULL
+ */
+void *getPtr(HashMapChaining *hashMap, int key);
+
 /**
  * @brief 从哈希表中删除键值对
  *
- * 从哈希表中删除指定键的键值对。
+ * 从哈希表中删除指定键的键值对。开启 autoShrink 时，负载因子低于
+ * HASH_TABLE_LOAD_FACTOR / HASH_TABLE_SHRINK_DIVISOR 会把桶数组缩小到负载因子约为
+ * HASH_TABLE_LOAD_FACTOR / 2 的大小：缩容后需要键值对数量翻倍才会再次扩容，减半才会再次缩容，
+ * 避免在阈值附近反复扩容缩容。迭代器的 removeCurrent 不会触发缩容。
  *
  * @param hashMap 哈希表的指针
  * @param key 要删除的键
  */
 void removeItem(HashMapChaining *hashMap, int key);
 
+/**
+ * @brief 批量查找
+ *
+ * 按 HASH_TABLE_BATCH_GROUP 个键一组，先计算整组键的桶位置并预取桶头和首个节点，
+ * 再交错遍历各条链表，使多个键的缓存未命中相互重叠。表远大于末级缓存时明显快于逐个调用 get。
+ *
+ * @param hashMap 哈希表的指针
+ * @param keys 要查找的键数组
+ * @param n 键的数量
+ * @param outVals 输出数组，长度为 n，outVals[i] 为 keys[i] 对应的值，不存在时为NULL
+ *
+ * @return 返回找到的键数量
+ */
+size_t getBatch(HashMapChaining *hashMap, const int *keys, size_t n, void **outVals);
+
+/**
+ * @brief 批量添加键值对
+ *
+ * 等价于按顺序对每个键调用 put，插入前按组预取桶头和首个节点。
+ *
+ * @param hashMap 哈希表的指针
+ * @param keys 要添加的键数组
+ * @param vals 要添加的值数组，长度为 n
+ * @param n 键值对的数量
+ */
+void putBatch(HashMapChaining *hashMap, const int *keys, void *const *vals, size_t n);
+
+/**
+ * @brief 批量删除键值对
+ *
+ * 等价于按顺序对每个键调用 removeItem，删除前按组预取桶头和首个节点。
+ *
+ * @param hashMap 哈希表的指针
+ * @param keys 要删除的键数组
+ * @param n 键的数量
+ */
+void removeBatch(HashMapChaining *hashMap, const int *keys, size_t n);
+
+/**
+ * @brief 多线程遍历所有键值对
+ *
+ * 桶数组按 HASH_TABLE_PARALLEL_BLOCK 个桶分块，块的边界落在缓存行边界上，由 nthreads 个线程
+ * （含调用线程）领取；链长不均时先完成的线程窃取其它线程剩余的块。渐进式扩容尚未完成时，
+ * 旧桶数组中未迁移的桶同样参与分块。所有键值对访问完后返回。
+ * visit 会在多个线程中并发调用，必须是线程安全的；遍历期间不能修改哈希表。
+ *
+ * @param hashMap 哈希表的指针
+ * @param visit 对每个键值对调用的函数
+ * @param ctx 传给 visit 的参数
+ * @param nthreads 线程数，不大于1或线程创建失败时在调用线程中顺序遍历
+ */
+void hashMapForEachParallel(HashMapChaining *hashMap, void (*visit)(int key, void *val, void *ctx), void *ctx, size_t nthreads);
+
+/**
+ * @brief 多线程归约所有键值对
+ *
+ * 每个线程拥有一份独占缓存行的累加器，初值为 acc 中的内容（归约的单位元），遍历时只调用
+ * accumulate 修改自己的累加器，不需要任何同步；遍历结束后在调用线程中按线程编号依次
+ * combine 到 acc。分块方式同 hashMapForEachParallel：线程会窃取其它线程的块，每个累加器覆盖的
+ * 是一组不连续、顺序不定的块，合并顺序也与键值对的遍历顺序无关。因此 accumulate 和 combine
+ * 必须同时满足结合律和交换律（例如求和、计数、最大值），结果才与顺序遍历相同；
+ * 浮点数求和等只近似满足的运算，结果可能随线程数和调度略有不同。
+ *
+ * @param hashMap 哈希表的指针
+ * @param acc 输入为单位元，输出为归约结果
+ * @param accSize 累加器的字节数
+ * @param accumulate 把一个键值对累加到 acc
+ * @param combine 把累加器 other 合并到 acc
+ * @param ctx 传给 accumulate 和 combine 的参数
+ * @param nthreads 线程数，不大于1或线程创建失败时在调用线程中顺序遍历
+ * @return 参数错误或内存不足时返回false，此时 acc 不变
+ */
+bool hashMapReduceParallel(HashMapChaining *hashMap, void *acc, size_t accSize,
+                           void (*accumulate)(void *acc, int key, void *val, void *ctx),
+                           void (*combine)(void *acc, const void *other, void *ctx),
+                           void *ctx, size_t nthreads);
+
+/**
+ * @brief 使用调用者的线程池多线程遍历所有键值对
+ *
+ * 同 hashMapForEachParallel，但不创建和回收线程，频繁遍历时由调用者复用同一个线程池。
+ * 线程池在遍历期间不能执行其它任务。
+ *
+ * @param hashMap 哈希表的指针
+ * @param visit 对每个键值对调用的函数
+ * @param ctx 传给 visit 的参数
+ * @param pool 线程池，为NULL时在调用线程中顺序遍历
+ */
+void hashMapForEachParallelPool(HashMapChaining *hashMap, void (*visit)(int key, void *val, void *ctx), void *ctx, ThreadPool *pool);
+
+/**
+ * @brief 使用调用者的线程池多线程归约所有键值对
+ *
+ * 同 hashMapReduceParallel，累加器的份数等于 threadPoolSize(pool)。
+ *
+ * @param hashMap 哈希表的指针
+ * @param acc 输入为单位元，输出为归约结果
+ * @param accSize 累加器的字节数
+ * @param accumulate 把一个键值对累加到 acc
+ * @param combine 把累加器 other 合并到 acc
+ * @param ctx 传给 accumulate 和 combine 的参数
+ * @param pool 线程池，为NULL时在调用线程中顺序遍历
+ * @return 参数错误或内存不足时返回false，此时 acc 不变
+ */
+bool hashMapReduceParallelPool(HashMapChaining *hashMap, void *acc, size_t accSize,
+                               void (*accumulate)(void *acc, int key, void *val, void *ctx),
+                               void (*combine)(void *acc, const void *other, void *ctx),
+                               void *ctx, ThreadPool *pool);
+
 /**
  * @brief 打印哈希表
  *
@@ -107,6 +380,68 @@ void removeItem(HashMapChaining *hashMap, int key);
  */
 void print(HashMapChaining *hashMap);
 
+/**
+ * @brief 统计链长分布
+ *
+ * histogram[i] 为链长等于 i 的桶数量，链长大于等于 bins - 1 的桶都计入最后一项。
+ *
+ * @param hashMap 哈希表的指针
+ * @param histogram 输出数组，长度为 bins
+ * @param bins 输出数组长度，必须大于0
+ */
+void chainLengthHistogram(HashMapChaining *hashMap, size_t *histogram, size_t bins);
+
+/**
+ * @brief 获取哈希表统计信息
+ *
+ * 容量、负载因子和链长分布总是可用；探测长度和扩容计数只在定义 HASH_TABLE_STATS 时记录。
+ * 开启统计后 get 也会写计数器，不能再在多个线程中并发调用 get。
+ *
+ * @param hashMap 哈希表的指针
+ * @param out 输出统计信息
+ */
+void hashMapStats(HashMapChaining *hashMap, HashMapStats *out);
+
+/**
+ * @brief 清零探测长度和扩容计数
+ *
+ * @param hashMap 哈希表的指针
+ */
+void hashMapStatsReset(HashMapChaining *hashMap);
+
+/**
+ * @brief 打印哈希表统计信息
+ *
+ * 输出容量、负载因子、各操作的平均和最大探测长度、扩容次数和耗时以及链长分布，
+ * 用于调整负载因子和选择哈希策略。需要查看每个键值对时使用 print。
+ *
+ * @param hashMap 哈希表的指针
+ */
+void hashMapStatsPrint(HashMapChaining *hashMap);
+
+/**
+ * @brief 获取缓存模式计数器
+ *
+ * 创建参数中设置了 cacheMaxEntries 或 cacheMaxBytes 时哈希表为缓存模式：put 写入新键后，
+ * 如果数量或字节数超过上限，按 CLOCK 近似 LRU 淘汰最近未被访问的键值对并调用 freeVal。
+ * 每个节点有一个访问位，get 命中和 put 更新时置位；淘汰指针按桶顺序循环扫描，
+ * 遇到置位的节点清除访问位继续，遇到未置位的节点淘汰。
+ * 访问位放在节点的填充字节中，不增加内存占用。缓存模式下桶数量不超过容纳 cacheMaxEntries 所需，
+ * 并且总是自动缩容（下限为 HASH_TABLE_CACHE_MIN_CAPACITY），负载因子有下界，扫描空桶的开销同样摊到每次淘汰上。
+ * 缓存模式下 get 会写访问位和计数器，不能在多个线程中并发调用 get；渐进式扩容总是被关闭。
+ *
+ * @param hashMap 哈希表的指针
+ * @param out 输出计数器
+ */
+void hashMapCacheStats(HashMapChaining *hashMap, HashCacheStats *out);
+
+/**
+ * @brief 清零缓存命中、未命中和淘汰计数
+ *
+ * @param hashMap 哈希表的指针
+ */
+void hashMapCacheStatsReset(HashMapChaining *hashMap);
+
 /**
  * @brief 初始化哈希表迭代器
  *
@@ -0,0 +1,149 @@
+#include "hash_table.h"
+#include "hash_table_internal.h"
+
+/*
+ * 批量操作
+ *
+ * 逐个调用 get/put 时，每次沿链表解引用都要等待一次缓存未命中，且前后调用之间无法重叠。
+ * 批量接口按 HASH_TABLE_BATCH_GROUP 个键一组处理：先计算整组键的桶索引并预取桶头，
+ * 再读取桶头并预取第一个节点，最后交错推进各个键的链表遍历，
+ * 使多个键的内存访问在时间上重叠（group prefetching / AMAC）。
+ */
+
+/* 计算一组键的桶索引并预取桶头 */
+static void prefetchBuckets(HashMapChaining *hashMap, const int *keys, size_t count, size_t *indexes, bool forWrite) {
+    for (size_t j = 0; j < count; j++) {
+        indexes[j] = indexFor(hashMap, keyHash(hashMap, keys[j]), hashMap->capacity);
+        if (forWrite) {
+            HASH_PREFETCH_WRITE(&hashMap->buckets[indexes[j]]);
+        } else {
+            HASH_PREFETCH(&hashMap->buckets[indexes[j]]);
+        }
+    }
+}
+
+/* 读取一组桶头并预取第一个节点 */
+static void prefetchHeads(HashMapChaining *hashMap, const size_t *indexes, size_t count, HashNode **heads) {
+    for (size_t j = 0; j < count; j++) {
+        heads[j] = hashMap->buckets[indexes[j]];
+        if (heads[j] != NULL) {
+            HASH_PREFETCH(heads[j]);
+        }
+    }
+}
+
+/* 批量查找 */
+size_t getBatch(HashMapChaining *hashMap, const int *keys, size_t n, void **outVals) {
+    if (hashMap == NULL || keys == NULL || outVals == NULL) {
+        return 0;
+    }
+
+    size_t indexes[HASH_TABLE_BATCH_GROUP];
+    HashNode *cursors[HASH_TABLE_BATCH_GROUP];
+    size_t probes[HASH_TABLE_BATCH_GROUP];  // 只用于统计，未开启统计时被优化掉
+    size_t found = 0;
+
+    for (size_t base = 0; base < n; base += HASH_TABLE_BATCH_GROUP) {
+        size_t count = n - base < HASH_TABLE_BATCH_GROUP ? n - base : HASH_TABLE_BATCH_GROUP;
+        const int *groupKeys = keys + base;
+        void **groupVals = outVals + base;
+
+        prefetchBuckets(hashMap, groupKeys, count, indexes, false);
+        prefetchHeads(hashMap, indexes, count, cursors);
+
+        // 交错推进：每轮每个未完成的键前进一个节点，并预取它的下一个节点
+        size_t active = count;
+        for (size_t j = 0; j < count; j++) {
+            groupVals[j] = NULL;
+            probes[j] = 0;
+            if (cursors[j] == NULL && hashMap->oldBuckets == NULL) {
+                HASH_STATS_PROBE(hashMap, get, false, probes[j]);
+                if (hashMap->cacheMode) {
+                    cacheRecord(hashMap, NULL);
+                }
+            }
+        }
+        while (active > 0) {
+            active = 0;
+            for (size_t j = 0; j < count; j++) {
+                HashNode *cur = cursors[j];
+                if (cur == NULL) {
+                    continue;
+                }
+                probes[j]++;
+                if (cur->pair.key == groupKeys[j]) {
+                    HASH_STATS_PROBE(hashMap, get, true, probes[j]);
+                    if (hashMap->cacheMode) {
+                        cacheRecord(hashMap, cur);
+                    }
+                    groupVals[j] = cur->pair.val;
+                    cursors[j] = NULL;
+                    found++;
+                    continue;
+                }
+                cursors[j] = cur->next;
+                if (cur->next != NULL) {
+                    HASH_PREFETCH(cur->next);
+                    active++;
+                } else if (hashMap->oldBuckets == NULL) {
+                    HASH_STATS_PROBE(hashMap, get, false, probes[j]);
+                    if (hashMap->cacheMode) {
+                        cacheRecord(hashMap, NULL);
+                    }
+                }
+            }
+        }
+
+        // 渐进式扩容期间，未命中的键还可能位于尚未迁移的旧桶，由 get 重新查找并统计
+        if (hashMap->oldBuckets != NULL) {
+            for (size_t j = 0; j < count; j++) {
+                if (groupVals[j] == NULL) {
+                    groupVals[j] = get(hashMap, groupKeys[j]);
+                    found += groupVals[j] != NULL;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+/* 批量添加 */
+void putBatch(HashMapChaining *hashMap, const int *keys, void *const *vals, size_t n) {
+    if (hashMap == NULL || keys == NULL || vals == NULL) {
+        return;
+    }
+
+    size_t indexes[HASH_TABLE_BATCH_GROUP];
+    HashNode *heads[HASH_TABLE_BATCH_GROUP];
+
+    for (size_t base = 0; base < n; base += HASH_TABLE_BATCH_GROUP) {
+        size_t count = n - base < HASH_TABLE_BATCH_GROUP ? n - base : HASH_TABLE_BATCH_GROUP;
+
+        // 预取之后逐个插入；组内触发扩容时预取失效，只影响性能不影响正确性
+        prefetchBuckets(hashMap, keys + base, count, indexes, true);
+        prefetchHeads(hashMap, indexes, count, heads);
+        for (size_t j = 0; j < count; j++) {
+            put(hashMap, keys[base + j], vals[base + j]);
+        }
+    }
+}
+
+/* 批量删除 */
+void removeBatch(HashMapChaining *hashMap, const int *keys, size_t n) {
+    if (hashMap == NULL || keys == NULL) {
+        return;
+    }
+
+    size_t indexes[HASH_TABLE_BATCH_GROUP];
+    HashNode *heads[HASH_TABLE_BATCH_GROUP];
+
+    for (size_t base = 0; base < n; base += HASH_TABLE_BATCH_GROUP) {
+        size_t count = n - base < HASH_TABLE_BATCH_GROUP ? n - base : HASH_TABLE_BATCH_GROUP;
+
+        prefetchBuckets(hashMap, keys + base, count, indexes, true);
+        prefetchHeads(hashMap, indexes, count, heads);
+        for (size_t j = 0; j < count; j++) {
+            removeItem(hashMap, keys[base + j]);
+        }
+    }
+}
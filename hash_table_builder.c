@@ -0,0 +1,257 @@
+#include <string.h>
+#include "hash_table_builder.h"
+#include "hash_table_internal.h"
+#include "thread_pool.h"
+#include "utility.h"
+
+/* 多线程构建器 */
+struct HashMapBuilder {
+    HashMapChainingConfig config;   // 私有哈希表和合并结果的创建参数
+    size_t localCount;              // 私有哈希表数量
+    HashMapChaining **locals;       // 私有哈希表
+};
+
+#define MERGE_PREFETCH_DISTANCE 8   // 链入目标桶时提前预取的节点数量
+
+/* 一次合并的参数 */
+typedef struct {
+    HashMapBuilder *builder;
+    HashMapChaining *target;    // 合并结果
+    size_t partitions;          // 分区数量，2 的幂
+    unsigned shift;             // 目标桶下标右移 shift 位得到分区号
+    HashNode **nodes;           // 所有节点指针，每个私有哈希表占连续一段，段内按分区排列
+    size_t *bases;              // 第 i 个私有哈希表的节点在 nodes 中的起始下标
+    size_t *ends;               // 第 i 个私有哈希表中分区 p 的结束下标（相对 bases[i]）：ends[i * partitions + p]
+    HashNode **dropped;         // 每个分区中被合并掉的重复节点
+    size_t *counts;             // 每个分区链入目标桶的节点数量
+    HashMapCombine combine;
+    void *ctx;
+} MergeTask;
+
+static inline size_t targetIndex(const MergeTask *task, int key) {
+    return (size_t)keyHash(task->target, key) & task->target->mask;
+}
+
+/*
+ * 阶段1：把私有哈希表 [begin, end) 的节点指针按分区排列到 nodes 中，然后清空这些私有哈希表的桶数组。
+ * 第一遍统计每个分区的节点数量，第二遍按分区写入（计数排序），同一分区内保持遍历顺序。
+ */
+static void splitLocals(size_t begin, size_t end, size_t worker, void *ctx) {
+    (void)worker;
+    MergeTask *task = (MergeTask *)ctx;
+    for (size_t i = begin; i < end; i++) {
+        HashMapChaining *local = task->builder->locals[i];
+        HashNode **nodes = task->nodes + task->bases[i];
+        size_t *ends = task->ends + i * task->partitions;
+
+        for (size_t b = 0; b < local->capacity; b++) {
+            for (HashNode *node = local->buckets[b]; node != NULL; node = node->next) {
+                ends[targetIndex(task, node->pair.key) >> task->shift]++;
+            }
+        }
+        // 先把 ends[p] 设为分区 p 的起始下标，写入时作为游标递增，写完后正好是结束下标
+        size_t offset = 0;
+        for (size_t p = 0; p < task->partitions; p++) {
+            size_t count = ends[p];
+            ends[p] = offset;
+            offset += count;
+        }
+        for (size_t b = 0; b < local->capacity; b++) {
+            for (HashNode *node = local->buckets[b]; node != NULL; node = node->next) {
+                nodes[ends[targetIndex(task, node->pair.key) >> task->shift]++] = node;
+            }
+        }
+        memset(local->buckets, 0, local->capacity * sizeof(HashNode *));
+        local->size = 0;
+    }
+}
+
+/* 已合并的节点 existing 吸收重复节点 node 的值 */
+static void combineNode(MergeTask *task, HashNode *existing, HashNode *node) {
+    HashMapChaining *target = task->target;
+    if (task->combine == NULL) {
+        if (target->valSize == 0 && target->freeVal != NULL) {
+            target->freeVal(node->pair.val);
+        }
+        return;
+    }
+
+    void *val = task->combine(node->pair.key, existing->pair.val, node->pair.val, task->ctx);
+    if (target->valSize == 0) {
+        existing->pair.val = val;
+    } else if (val != existing->pair.val) {
+        memcpy(existing->pair.val, val, target->valSize);
+    }
+}
+
+/*
+ * 阶段2：把分区 [begin, end) 的节点链入目标桶，不同分区的目标桶互不相交。
+ * 节点指针连续存放，可以提前预取后面的节点，节点的缓存未命中互相重叠。
+ */
+static void mergePartitions(size_t begin, size_t end, size_t worker, void *ctx) {
+    (void)worker;
+    MergeTask *task = (MergeTask *)ctx;
+    HashNode **buckets = task->target->buckets;
+    for (size_t p = begin; p < end; p++) {
+        size_t count = 0;
+        // 按私有哈希表的下标顺序合并，重复键的合并顺序与线程数无关
+        for (size_t i = 0; i < task->builder->localCount; i++) {
+            const size_t *ends = task->ends + i * task->partitions;
+            HashNode **nodes = task->nodes + task->bases[i];
+            size_t last = ends[p];
+            for (size_t j = p == 0 ? 0 : ends[p - 1]; j < last; j++) {
+                if (j + MERGE_PREFETCH_DISTANCE < last) {
+                    HASH_PREFETCH_WRITE(nodes[j + MERGE_PREFETCH_DISTANCE]);
+                }
+                HashNode *node = nodes[j];
+                size_t index = targetIndex(task, node->pair.key);
+                HashNode *existing = buckets[index];
+                while (existing != NULL && existing->pair.key != node->pair.key) {
+                    existing = existing->next;
+                }
+                if (existing != NULL) {
+                    combineNode(task, existing, node);
+                    node->next = task->dropped[p];
+                    task->dropped[p] = node;
+                } else {
+                    node->next = buckets[index];
+                    buckets[index] = node;
+                    count++;
+                }
+            }
+        }
+        task->counts[p] = count;
+    }
+}
+
+static void freeMergeTask(MergeTask *task) {
+    free(task->nodes);
+    free(task->bases);
+    free(task->ends);
+    free(task->dropped);
+    free(task->counts);
+}
+
+/* 创建多线程构建器 */
+HashMapBuilder *newHashMapBuilder(const HashMapChainingConfig *config, size_t locals) {
+    if (config == NULL || locals == 0) {
+        return NULL;
+    }
+    HashMapBuilder *builder = (HashMapBuilder *)malloc(sizeof(HashMapBuilder));
+    if (builder == NULL) {
+        return NULL;
+    }
+    builder->locals = (HashMapChaining **)calloc(locals, sizeof(HashMapChaining *));
+    if (builder->locals == NULL) {
+        free(builder);
+        return NULL;
+    }
+
+    builder->config = *config;
+    builder->config.pow2Capacity = true;
+    builder->config.incrementalRehash = false;
+    builder->config.cacheMaxEntries = 0;
+    builder->config.cacheMaxBytes = 0;
+    builder->localCount = locals;
+    for (size_t i = 0; i < locals; i++) {
+        builder->locals[i] = newHashMapChainingWithConfig(&builder->config);
+        if (builder->locals[i] == NULL) {
+            delHashMapBuilder(builder);
+            return NULL;
+        }
+    }
+    return builder;
+}
+
+/* 删除多线程构建器 */
+void delHashMapBuilder(HashMapBuilder *builder) {
+    if (builder == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < builder->localCount; i++) {
+        delHashMapChaining(builder->locals[i]);
+    }
+    free(builder->locals);
+    free(builder);
+}
+
+/* 获取私有哈希表 */
+HashMapChaining *builderLocal(HashMapBuilder *builder, size_t index) {
+    if (builder == NULL || index >= builder->localCount) {
+        return NULL;
+    }
+    return builder->locals[index];
+}
+
+/* 合并所有私有哈希表 */
+HashMapChaining *builderMerge(HashMapBuilder *builder, HashMapCombine combine, void *ctx, size_t nthreads) {
+    if (builder == NULL) {
+        return NULL;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < builder->localCount; i++) {
+        total += builder->locals[i]->size;
+    }
+    HashMapChaining *target = newHashMapChainingWithConfig(&builder->config);
+    if (target == NULL) {
+        return NULL;
+    }
+    reserve(target, total);
+
+    ThreadPool *pool = nthreads > 1 ? newThreadPool(nthreads) : NULL;
+    MergeTask task;
+    task.builder = builder;
+    task.target = target;
+    task.combine = combine;
+    task.ctx = ctx;
+    task.partitions = 1;
+    task.shift = 0;
+    // 分区足够多才能在线程之间均衡，分区足够小则链入节点时目标桶都在缓存中
+    while ((task.partitions < threadPoolSize(pool) * HASH_TABLE_BUILDER_PARTITIONS_PER_THREAD ||
+            task.partitions * HASH_TABLE_BUILDER_PARTITION_BUCKETS < target->capacity) &&
+           task.partitions < target->capacity) {
+        task.partitions *= 2;
+    }
+    while (((size_t)1 << task.shift) * task.partitions < target->capacity) {
+        task.shift++;
+    }
+
+    task.nodes = (HashNode **)malloc((total > 0 ? total : 1) * sizeof(HashNode *));
+    task.bases = (size_t *)malloc(builder->localCount * sizeof(size_t));
+    task.ends = (size_t *)calloc(builder->localCount * task.partitions, sizeof(size_t));
+    task.dropped = (HashNode **)calloc(task.partitions, sizeof(HashNode *));
+    task.counts = (size_t *)calloc(task.partitions, sizeof(size_t));
+    if (task.nodes == NULL || task.bases == NULL || task.ends == NULL || task.dropped == NULL || task.counts == NULL) {
+        freeMergeTask(&task);
+        delThreadPool(pool);
+        delHashMapChaining(target);
+        return NULL;
+    }
+    for (size_t i = 0, base = 0; i < builder->localCount; i++) {
+        task.bases[i] = base;
+        base += builder->locals[i]->size;
+    }
+
+    if (total > 0) {
+        threadPoolParallelFor(pool, builder->localCount, 1, splitLocals, &task);
+        threadPoolParallelFor(pool, task.partitions, 1, mergePartitions, &task);
+    }
+    delThreadPool(pool);
+
+    // 节点仍在私有哈希表的内存池中，整体移交给合并结果，重复节点归还到合并结果的内存池
+    for (size_t i = 0; i < builder->localCount; i++) {
+        nodePoolAdopt(&target->nodePool, &builder->locals[i]->nodePool);
+    }
+    for (size_t p = 0; p < task.partitions; p++) {
+        target->size += task.counts[p];
+        for (HashNode *node = task.dropped[p]; node != NULL;) {
+            HashNode *next = node->next;
+            nodePoolFree(&target->nodePool, node);
+            node = next;
+        }
+    }
+
+    freeMergeTask(&task);
+    return target;
+}
@@ -0,0 +1,85 @@
+#ifndef HASH_TABLE_BUILDER_H
+#define HASH_TABLE_BUILDER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "hash_table.h"
+
+/*
+ * 多线程构建哈希表
+ *
+ * 每个写入线程拿到一个私有的 HashMapChaining，用普通的 put 写入，不需要加锁。
+ * 写完后 builderMerge 把所有私有哈希表合并成一个新的哈希表：
+ *   1. 每个工作线程负责若干私有哈希表，按目标桶下标的高位把节点指针分到 P 个分区（计数排序）；
+ *   2. 每个工作线程负责若干分区，分区对应目标桶数组中互不相交的连续区间，直接把节点链入目标桶，
+ *      两个阶段都不需要同步。重复的键调用 combine 合并。
+ * 节点不拷贝，私有哈希表的节点内存池整体移交给合并结果，合并期间每个键值对只临时占用一个指针。
+ * 合并后私有哈希表变为空，可以继续写入下一批。
+ */
+
+#define HASH_TABLE_BUILDER_PARTITIONS_PER_THREAD 8  // 每个合并线程至少对应的分区数量，分区是领取和窃取的单位
+#define HASH_TABLE_BUILDER_PARTITION_BUCKETS 4096   // 每个分区的目标桶数量上限，一个分区的桶数组（32KB）留在缓存中
+
+/* 多线程构建器 */
+typedef struct HashMapBuilder HashMapBuilder;
+
+/**
+ * @brief 重复键的合并函数
+ *
+ * 同一个键出现在多个私有哈希表中时，按私有哈希表的下标顺序依次合并：
+ * existing 为已合并的值，incoming 为下标更大的私有哈希表中的值，返回合并后的值。
+ * 值为调用者管理的指针时返回值直接保存，未保存的指针由 combine 负责释放；
+ * 值内联存放时 existing 和 incoming 指向节点中的值，返回值所指的 valSize 字节被拷贝到已合并的节点。
+ * 分区由不同线程并行合并，combine 只能修改与当前键有关的数据。
+ */
+typedef void *(*HashMapCombine)(int key, void *existing, void *incoming, void *ctx);
+
+/**
+ * @brief 创建多线程构建器
+ *
+ * 所有私有哈希表和合并结果都使用 config 创建，其中 pow2Capacity 总是被打开（按哈希值的位分区），
+ * incrementalRehash 和缓存模式总是被关闭。
+ *
+ * @param config 哈希表创建参数，capacity 为每个私有哈希表的初始桶数量
+ * @param locals 私有哈希表的数量，通常等于写入线程数，必须大于0
+ *
+ * @return 成功时返回构建器指针，失败时返回 NULL
+ */
+HashMapBuilder *newHashMapBuilder(const HashMapChainingConfig *config, size_t locals);
+
+/**
+ * @brief 删除构建器及其中所有私有哈希表
+ *
+ * @param builder 构建器指针
+ */
+void delHashMapBuilder(HashMapBuilder *builder);
+
+/**
+ * @brief 获取第 index 个私有哈希表
+ *
+ * 每个私有哈希表同一时刻只能由一个线程使用，builderMerge 期间不能使用。
+ *
+ * @param builder 构建器指针
+ * @param index 私有哈希表下标，小于 locals
+ *
+ * @return 私有哈希表指针，下标越界时返回 NULL
+ */
+HashMapChaining *builderLocal(HashMapBuilder *builder, size_t index);
+
+/**
+ * @brief 合并所有私有哈希表
+ *
+ * 合并结果按所有私有哈希表的键值对数量之和预先分配桶数组，合并过程中不扩容。
+ * 合并成功后私有哈希表全部变为空，值的所有权转移给合并结果（freeVal 由合并结果调用）。
+ *
+ * @param builder 构建器指针
+ * @param combine 重复键的合并函数，为 NULL 时保留下标最小的私有哈希表中的值，
+ *                其余的值按 freeVal 释放
+ * @param ctx 传给 combine 的上下文
+ * @param nthreads 合并使用的线程数，不大于1时在调用线程中执行
+ *
+ * @return 成功时返回新的哈希表，内存分配失败时返回 NULL 且私有哈希表保持不变
+ */
+HashMapChaining *builderMerge(HashMapBuilder *builder, HashMapCombine combine, void *ctx, size_t nthreads);
+
+#endif // HASH_TABLE_BUILDER_H
@@ -0,0 +1,100 @@
+#include <string.h>
+#include "hash_table.h"
+#include "hash_table_internal.h"
+#include "utility.h"
+
+/*
+ * 缓存模式
+ *
+ * CLOCK 近似 LRU：淘汰指针按桶顺序循环扫描，节点的访问位置位时清除并跳过（给它第二次机会），
+ * 未置位时淘汰。一个节点在两次经过淘汰指针之间没有被访问才会被淘汰，效果接近 LRU，
+ * 但命中时只写一个字节，不需要维护链表。
+ *
+ * 单次淘汰最坏要扫描两圈桶数组，均摊开销依赖负载因子的下界：缓存模式总是自动缩容，
+ * 桶数量大于 HASH_TABLE_CACHE_MIN_CAPACITY 时每个桶平均至少有
+ * HASH_TABLE_LOAD_FACTOR / HASH_TABLE_SHRINK_DIVISOR 个节点，扫描的空桶数与扫描的节点数成正比。
+ * 扫描的节点要么被淘汰（摊到对应的 put），要么被清除访问位（摊到置位它的 get），因此均摊是常数。
+ */
+
+/* 从 link 所在的链表中淘汰节点 */
+static void evictNode(HashMapChaining *hashMap, HashNode **link) {
+    HashNode *node = *link;
+    *link = node->next;
+    hashMap->cache.bytes -= cacheCharge(hashMap, node->pair.val);
+    if (hashMap->freeVal != NULL && node->pair.val != NULL) {
+        hashMap->freeVal(node->pair.val);
+    }
+    nodePoolFree(&hashMap->nodePool, node);
+    hashMap->size--;
+    hashMap->cache.evictions++;
+}
+
+/*
+ * 淘汰一个键值对，成功返回true
+ *
+ * 淘汰后指针移到下一个桶：链表中刚被清除访问位的节点不能在同一圈里再被检查，
+ * 同一条链表中淘汰节点之后的节点留到下一圈。扫描两圈仍找不到（第一圈已清除所有访问位）说明只剩 keep。
+ */
+static bool evictOne(HashMapChaining *hashMap, const HashNode *keep) {
+    for (size_t scanned = 0; scanned <= 2 * hashMap->capacity; scanned++) {
+        // 扩容或收缩后桶数量可能变小
+        if (hashMap->cache.hand >= hashMap->capacity) {
+            hashMap->cache.hand = 0;
+        }
+        for (HashNode **link = &hashMap->buckets[hashMap->cache.hand]; *link != NULL; link = &(*link)->next) {
+            HashNode *node = *link;
+            if (node == keep) {
+                continue;
+            }
+            if (!node->pair.referenced) {
+                evictNode(hashMap, link);
+                hashMap->cache.hand++;
+                return true;
+            }
+            node->pair.referenced = false;
+        }
+        hashMap->cache.hand++;
+    }
+    return false;
+}
+
+/* 淘汰键值对直到不超过上限 */
+void cacheEvict(HashMapChaining *hashMap, const HashNode *keep) {
+    const HashMapCache *cache = &hashMap->cache;
+    while ((cache->maxEntries > 0 && hashMap->size > cache->maxEntries) ||
+           (cache->maxBytes > 0 && cache->bytes > cache->maxBytes)) {
+        if (!evictOne(hashMap, keep)) {
+            break;
+        }
+    }
+}
+
+/* 获取缓存模式计数器 */
+void hashMapCacheStats(HashMapChaining *hashMap, HashCacheStats *out) {
+    if (out == NULL) {
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+    if (hashMap == NULL || !hashMap->cacheMode) {
+        return;
+    }
+
+    out->enabled = true;
+    out->hits = hashMap->cache.hits;
+    out->misses = hashMap->cache.misses;
+    out->evictions = hashMap->cache.evictions;
+    out->entries = hashMap->size;
+    out->bytes = hashMap->cache.bytes;
+    out->maxEntries = hashMap->cache.maxEntries;
+    out->maxBytes = hashMap->cache.maxBytes;
+}
+
+/* 清零缓存命中、未命中和淘汰计数 */
+void hashMapCacheStatsReset(HashMapChaining *hashMap) {
+    if (hashMap == NULL) {
+        return;
+    }
+    hashMap->cache.hits = 0;
+    hashMap->cache.misses = 0;
+    hashMap->cache.evictions = 0;
+}
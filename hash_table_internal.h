@@ -0,0 +1,186 @@
+#ifndef HASH_TABLE_INTERNAL_H
+#define HASH_TABLE_INTERNAL_H
+
+/*
+ * HashMapChaining 的内部数据结构
+ *
+ * 仅供哈希表自身的各个实现文件使用（批量操作、统计、快照等），不属于公开API。
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hash_table.h"
+#include "hash_func.h"
+#include "node_pool.h"
+#ifdef HASH_TABLE_STATS
+#include <time.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define HASH_PREFETCH(addr) __builtin_prefetch((addr), 0, 3)        // 为读取预取
+#define HASH_PREFETCH_WRITE(addr) __builtin_prefetch((addr), 1, 3)  // 为写入预取
+#else
+#define HASH_PREFETCH(addr) ((void)(addr))
+#define HASH_PREFETCH_WRITE(addr) ((void)(addr))
+#endif
+
+#define HASH_BUCKET_ALIGN 64  // 桶数组起始地址的对齐字节数（缓存行大小）
+
+#ifdef HASH_TABLE_STATS
+/* 热路径计数器 */
+typedef struct {
+    HashProbeStats get;
+    HashProbeStats put;
+    HashProbeStats remove;
+    size_t extendCount;
+    uint64_t extendNs;
+} HashMapCounters;
+#endif
+
+/* 键值对 int->void */
+typedef struct {
+    int key;
+    bool referenced;  // 缓存模式下 CLOCK 的访问位，放在 key 之后的填充字节中，不增加节点大小
+    void *val;
+} Pair;
+
+/* 链表节点 */
+typedef struct HashNode {
+    Pair pair;
+    struct HashNode *next;
+} HashNode;
+
+/* 缓存模式的容量限制、CLOCK 指针和计数器 */
+typedef struct {
+    size_t maxEntries;                    // 键值对数量上限，0 表示不限制
+    size_t maxBytes;                      // 占用字节数上限，0 表示不限制
+    size_t (*valBytes)(const void *val);  // 非内联值占用的字节数，为 NULL 时只计节点
+    size_t bytes;                         // 当前占用的字节数
+    size_t hand;                          // CLOCK 指针：下一次淘汰从这个桶开始检查
+    size_t hits;                          // get 找到键的次数
+    size_t misses;                        // get 未找到键的次数
+    size_t evictions;                     // 淘汰的键值对数量
+} HashMapCache;
+
+/* 链式地址哈希表 */
+struct HashMapChaining {
+    size_t size;         // 键值对数量
+    size_t capacity;     // 哈希表容量
+    size_t mask;         // 容量为 2 的幂时等于 capacity - 1
+    bool pow2Capacity;   // 是否用掩码代替取模定位桶
+    HashKind hashKind;   // 哈希策略
+    uint64_t hashSeed;   // 带种子哈希策略使用的种子
+
+#ifdef HASH_TABLE_AUTO_EXPAND
+    float loadThres; // 触发扩容的负载因子阈值
+    int extendRatio;  // 扩容倍数
+    size_t growAt;    // 键值对数量超过该值时扩容，避免每次插入都做浮点除法
+    size_t shrinkAt;  // 开启自动缩容时，键值对数量低于该值时缩容
+#endif // HASH_TABLE_AUTO_EXPAND
+
+    HashNode **buckets;   // 桶数组
+    void (*freeVal)(void*); // 释放val的回调函数，如果为NULL则不释放
+    size_t valSize;       // 内联值的字节数，为 0 时 val 为调用者管理的指针
+    NodePool nodePool;    // 链表节点内存池
+
+    bool autoShrink;        // 是否在 removeItem 后自动缩容
+    size_t minCapacity;     // 自动缩容的下限，即创建时的容量
+    bool incrementalRehash; // 是否渐进式扩容
+    HashNode **oldBuckets;  // 渐进式扩容中尚未迁移完的旧桶数组，不在扩容中时为 NULL
+    size_t oldCapacity;     // 旧桶数组容量
+    size_t rehashIndex;     // 旧桶数组中下一个待迁移的桶
+    size_t rehashThreads;   // 一次性扩容使用的线程数，不大于1时单线程
+
+    void *image;            // 从快照加载且值直接指向快照时持有的快照映像，否则为 NULL
+
+    bool cacheMode;         // 是否为缓存模式（设置了数量或字节数上限）
+    HashMapCache cache;     // 缓存模式的状态，非缓存模式下不使用
+
+#ifdef HASH_TABLE_STATS
+    HashMapCounters stats;  // 热路径统计
+#endif
+};
+
+/*
+ * 计算键的哈希值
+ *
+ * 定义 HASH_TABLE_PINNED_HASH 时在编译期固定哈希策略，hashInt 中的分支被消除，
+ * 整个哈希计算可以内联到查找路径中。
+ */
+static inline uint64_t keyHash(const HashMapChaining *hashMap, int key) {
+#ifdef HASH_TABLE_PINNED_HASH
+    return hashInt(HASH_TABLE_PINNED_HASH, key, hashMap->hashSeed);
+#else
+    return hashInt(hashMap->hashKind, key, hashMap->hashSeed);
+#endif
+}
+
+/* 计算哈希值在指定容量的桶数组中的索引 */
+static inline size_t indexFor(const HashMapChaining *hashMap, uint64_t hash, size_t capacity) {
+    if (hashMap->pow2Capacity) {
+        return (size_t)hash & (capacity - 1);
+    }
+    return (size_t)(hash % capacity);
+}
+
+/* 缓存模式下一个键值对占用的字节数：节点（含内联值）加上 valBytes 计算的值大小 */
+static inline size_t cacheCharge(const HashMapChaining *hashMap, const void *val) {
+    size_t bytes = hashMap->nodePool.nodeSize;
+    if (hashMap->valSize == 0 && hashMap->cache.valBytes != NULL && val != NULL) {
+        bytes += hashMap->cache.valBytes(val);
+    }
+    return bytes;
+}
+
+/* 缓存模式下记录一次查找：命中时设置访问位 */
+static inline void cacheRecord(HashMapChaining *hashMap, HashNode *node) {
+    if (node != NULL) {
+        node->pair.referenced = true;
+        hashMap->cache.hits++;
+    } else {
+        hashMap->cache.misses++;
+    }
+}
+
+/*
+ * 缓存模式下淘汰键值对，直到数量和字节数都不超过上限
+ *
+ * keep 为刚写入的节点，不会被淘汰；只剩 keep 时即使超过字节数上限也停止。
+ */
+void cacheEvict(HashMapChaining *hashMap, const HashNode *keep);
+
+/*
+ * 热路径统计
+ *
+ * 未定义 HASH_TABLE_STATS 时宏展开为空表达式，统计探测长度的局部变量随之被优化掉。
+ */
+#ifdef HASH_TABLE_STATS
+static inline void statsProbe(HashProbeStats *stats, bool hit, size_t probes) {
+    if (hit) {
+        stats->hits++;
+        stats->hitProbes += probes;
+        if (probes > stats->maxHitProbe) {
+            stats->maxHitProbe = probes;
+        }
+    } else {
+        stats->misses++;
+        stats->missProbes += probes;
+        if (probes > stats->maxMissProbe) {
+            stats->maxMissProbe = probes;
+        }
+    }
+}
+
+static inline uint64_t statsNowNs(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#define HASH_STATS_PROBE(hashMap, op, hit, probes) statsProbe(&(hashMap)->stats.op, (hit), (probes))
+#else
+#define HASH_STATS_PROBE(hashMap, op, hit, probes) ((void)(hit), (void)(probes))
+#endif
+
+#endif // HASH_TABLE_INTERNAL_H
@@ -0,0 +1,163 @@
+#include <stdint.h>
+#include <string.h>
+#include "hash_table.h"
+#include "hash_table_internal.h"
+#include "thread_pool.h"
+#include "utility.h"
+
+/*
+ * 并行遍历与归约
+ *
+ * 当前桶数组按 HASH_TABLE_PARALLEL_BLOCK 个桶分块，渐进式扩容中旧桶数组里尚未迁移的部分接在后面继续分块，
+ * 块编号交给线程池：每个线程先处理自己的连续区间，再窃取其它线程剩余的块，长链集中的区间也能被分担。
+ * 桶数组按缓存行对齐，块的大小是缓存行的整数倍，旧桶数组的块同样从 0 号桶起算，
+ * 因此相邻的块不会共享缓存行。
+ */
+
+#define ACC_CACHE_LINE THREAD_POOL_CACHE_LINE
+
+/* 一次并行扫描的参数 */
+typedef struct {
+    HashMapChaining *hashMap;
+    size_t newBlocks;       // 当前桶数组的块数
+    size_t oldFirstBlock;   // 旧桶数组中第一个含未迁移桶的块
+    void (*visit)(int key, void *val, void *ctx);
+    void (*accumulate)(void *acc, int key, void *val, void *ctx);
+    char *accs;             // 每个工作线程的累加器，间隔 accStride 字节
+    size_t accStride;
+    void *ctx;
+} ScanTask;
+
+static size_t blockCount(size_t buckets) {
+    return (buckets + HASH_TABLE_PARALLEL_BLOCK - 1) / HASH_TABLE_PARALLEL_BLOCK;
+}
+
+/* 第 block 块的桶区间，返回起始桶并输出桶数量 */
+static HashNode **blockBuckets(const ScanTask *task, size_t block, size_t *count) {
+    HashMapChaining *hashMap = task->hashMap;
+    HashNode **buckets = hashMap->buckets;
+    size_t begin = block * HASH_TABLE_PARALLEL_BLOCK;
+    size_t end = hashMap->capacity;
+    if (block >= task->newBlocks) {
+        buckets = hashMap->oldBuckets;
+        begin = (task->oldFirstBlock + block - task->newBlocks) * HASH_TABLE_PARALLEL_BLOCK;
+        end = hashMap->oldCapacity;
+    }
+    size_t last = end - begin < HASH_TABLE_PARALLEL_BLOCK ? end : begin + HASH_TABLE_PARALLEL_BLOCK;
+    // 旧桶数组的第一个块只扫描尚未迁移的部分
+    if (block >= task->newBlocks && begin < hashMap->rehashIndex) {
+        begin = hashMap->rehashIndex;
+    }
+    *count = last - begin;
+    return buckets + begin;
+}
+
+/* 扫描块 [begin, end) */
+static void scanBlocks(size_t begin, size_t end, size_t worker, void *ctx) {
+    ScanTask *task = (ScanTask *)ctx;
+    void *acc = task->accs != NULL ? task->accs + worker * task->accStride : NULL;
+    for (size_t block = begin; block < end; block++) {
+        size_t count;
+        HashNode **buckets = blockBuckets(task, block, &count);
+        for (size_t i = 0; i < count; i++) {
+            for (HashNode *node = buckets[i]; node != NULL; node = node->next) {
+                if (acc != NULL) {
+                    task->accumulate(acc, node->pair.key, node->pair.val, task->ctx);
+                } else {
+                    task->visit(node->pair.key, node->pair.val, task->ctx);
+                }
+            }
+        }
+    }
+}
+
+/* 创建线程池，nthreads 不大于1或创建失败时返回NULL，由调用线程顺序执行 */
+static ThreadPool *scanPool(size_t nthreads) {
+    return nthreads > 1 ? newThreadPool(nthreads) : NULL;
+}
+
+static void runScan(ScanTask *task, ThreadPool *pool) {
+    HashMapChaining *hashMap = task->hashMap;
+    task->newBlocks = blockCount(hashMap->capacity);
+    task->oldFirstBlock = 0;
+    size_t blocks = task->newBlocks;
+    if (hashMap->oldBuckets != NULL) {
+        task->oldFirstBlock = hashMap->rehashIndex / HASH_TABLE_PARALLEL_BLOCK;
+        blocks += blockCount(hashMap->oldCapacity) - task->oldFirstBlock;
+    }
+    threadPoolParallelFor(pool, blocks, 1, scanBlocks, task);
+}
+
+/* 多线程遍历 */
+void hashMapForEachParallel(HashMapChaining *hashMap, void (*visit)(int key, void *val, void *ctx), void *ctx, size_t nthreads) {
+    if (hashMap == NULL || visit == NULL || hashMap->size == 0) {
+        return;
+    }
+
+    ThreadPool *pool = scanPool(nthreads);
+    hashMapForEachParallelPool(hashMap, visit, ctx, pool);
+    delThreadPool(pool);
+}
+
+/* 使用调用者的线程池多线程遍历 */
+void hashMapForEachParallelPool(HashMapChaining *hashMap, void (*visit)(int key, void *val, void *ctx), void *ctx, ThreadPool *pool) {
+    if (hashMap == NULL || visit == NULL || hashMap->size == 0) {
+        return;
+    }
+
+    ScanTask task = {hashMap, 0, 0, visit, NULL, NULL, 0, ctx};
+    runScan(&task, pool);
+}
+
+/* 多线程归约 */
+bool hashMapReduceParallel(HashMapChaining *hashMap, void *acc, size_t accSize,
+                           void (*accumulate)(void *acc, int key, void *val, void *ctx),
+                           void (*combine)(void *acc, const void *other, void *ctx),
+                           void *ctx, size_t nthreads) {
+    if (hashMap == NULL || acc == NULL || accSize == 0 || accumulate == NULL || combine == NULL) {
+        return false;
+    }
+    if (hashMap->size == 0) {
+        return true;
+    }
+
+    ThreadPool *pool = scanPool(nthreads);
+    bool ok = hashMapReduceParallelPool(hashMap, acc, accSize, accumulate, combine, ctx, pool);
+    delThreadPool(pool);
+    return ok;
+}
+
+/* 使用调用者的线程池多线程归约 */
+bool hashMapReduceParallelPool(HashMapChaining *hashMap, void *acc, size_t accSize,
+                               void (*accumulate)(void *acc, int key, void *val, void *ctx),
+                               void (*combine)(void *acc, const void *other, void *ctx),
+                               void *ctx, ThreadPool *pool) {
+    if (hashMap == NULL || acc == NULL || accSize == 0 || accumulate == NULL || combine == NULL) {
+        return false;
+    }
+    if (hashMap->size == 0) {
+        return true;
+    }
+
+    size_t workers = threadPoolSize(pool);
+    // 每个累加器占整数个缓存行，线程之间不会伪共享
+    size_t stride = (accSize + ACC_CACHE_LINE - 1) / ACC_CACHE_LINE * ACC_CACHE_LINE;
+    char *raw = (char *)malloc(workers * stride + ACC_CACHE_LINE - 1);
+    if (raw == NULL) {
+        return false;
+    }
+    uintptr_t aligned = ((uintptr_t)raw + ACC_CACHE_LINE - 1) & ~(uintptr_t)(ACC_CACHE_LINE - 1);
+    char *accs = raw + (aligned - (uintptr_t)raw);
+    for (size_t i = 0; i < workers; i++) {
+        memcpy(accs + i * stride, acc, accSize);
+    }
+
+    ScanTask task = {hashMap, 0, 0, NULL, accumulate, accs, stride, ctx};
+    runScan(&task, pool);
+
+    for (size_t i = 0; i < workers; i++) {
+        combine(acc, accs + i * stride, ctx);
+    }
+    free(raw);
+    return true;
+}
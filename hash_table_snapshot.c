@@ -0,0 +1,418 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "hash_table_snapshot.h"
+#include "hash_table_internal.h"
+#include "utility.h"
+
+/* 校验后的快照内容，指向映射或读入的映像 */
+typedef struct {
+    const HashSnapshotHeader *header;
+    const unsigned char *values;      // 值区域
+    const uint64_t *starts;           // 桶起始下标，bucketCount + 1 项
+    const HashSnapshotEntry *entries; // 条目
+} SnapshotView;
+
+/* 只读映射的快照 */
+struct HashSnapshot {
+    void *base;         // 映射起始地址
+    size_t length;      // 映射长度
+    SnapshotView view;
+};
+
+/* 带校验和的分块写入缓冲区 */
+typedef struct {
+    int fd;
+    unsigned char *buf;     // HASH_SNAPSHOT_BLOCK 字节
+    size_t len;             // 缓冲区中的字节数
+    uint64_t block;         // 已写出的块数
+    uint64_t written;       // 已写出的字节数
+    uint64_t checksum;
+    bool ok;
+} SnapshotWriter;
+
+/* 把一块内容计入校验和，块序号参与计算，块的顺序改变也能被发现 */
+static uint64_t checksumBlock(uint64_t checksum, const void *data, size_t len, uint64_t block) {
+    return hashMum(checksum ^ hashBytes(data, len, block), HASH_WYP1);
+}
+
+/* 按 HASH_SNAPSHOT_BLOCK 分块计算一段内容的校验和 */
+static uint64_t checksumRange(const unsigned char *data, uint64_t size) {
+    uint64_t checksum = 0;
+    for (uint64_t offset = 0, block = 0; offset < size; offset += HASH_SNAPSHOT_BLOCK, block++) {
+        uint64_t len = size - offset < HASH_SNAPSHOT_BLOCK ? size - offset : HASH_SNAPSHOT_BLOCK;
+        checksum = checksumBlock(checksum, data + offset, (size_t)len, block);
+    }
+    return checksum;
+}
+
+/* 写入全部字节，处理部分写入 */
+static bool writeAll(int fd, const void *data, size_t len) {
+    const unsigned char *p = (const unsigned char *)data;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return true;
+}
+
+static void writerFlush(SnapshotWriter *writer) {
+    if (writer->len == 0 || !writer->ok) {
+        return;
+    }
+    writer->checksum = checksumBlock(writer->checksum, writer->buf, writer->len, writer->block);
+    writer->ok = writeAll(writer->fd, writer->buf, writer->len);
+    writer->written += writer->len;
+    writer->block++;
+    writer->len = 0;
+}
+
+static void writerPut(SnapshotWriter *writer, const void *data, size_t len) {
+    const unsigned char *p = (const unsigned char *)data;
+    while (len > 0 && writer->ok) {
+        size_t room = HASH_SNAPSHOT_BLOCK - writer->len;
+        size_t chunk = len < room ? len : room;
+        memcpy(writer->buf + writer->len, p, chunk);
+        writer->len += chunk;
+        p += chunk;
+        len -= chunk;
+        if (writer->len == HASH_SNAPSHOT_BLOCK) {
+            writerFlush(writer);
+        }
+    }
+}
+
+/* 快照桶数量：2 的幂，且按默认负载因子加载后不需要扩容 */
+static uint64_t snapshotBuckets(size_t count) {
+    uint64_t buckets = 16;
+    while (buckets / 4 * 3 < count) {
+        buckets *= 2;
+    }
+    return buckets;
+}
+
+static inline uint64_t snapshotBucket(HashKind kind, uint64_t seed, uint64_t bucketCount, int key) {
+    return hashInt(kind, key, seed) & (bucketCount - 1);
+}
+
+/* 保存哈希表 */
+bool hashMapSave(HashMapChaining *hashMap, int fd, HashSnapshotSerializer serialize, void *ctx) {
+    if (hashMap == NULL || fd < 0) {
+        return false;
+    }
+    off_t base = lseek(fd, 0, SEEK_CUR);
+    if (base < 0) {
+        return false;
+    }
+
+    size_t count = hashMap->size;
+    uint64_t bucketCount = snapshotBuckets(count);
+    uint64_t *starts = (uint64_t *)calloc((size_t)bucketCount + 1, sizeof(uint64_t));
+    uint64_t *cursors = (uint64_t *)malloc((size_t)bucketCount * sizeof(uint64_t));
+    HashSnapshotEntry *entries = (HashSnapshotEntry *)malloc((count > 0 ? count : 1) * sizeof(HashSnapshotEntry));
+    void **vals = (void **)malloc((count > 0 ? count : 1) * sizeof(void *));
+    unsigned char *buf = (unsigned char *)malloc(HASH_SNAPSHOT_BLOCK);
+    bool ok = starts != NULL && cursors != NULL && entries != NULL && vals != NULL && buf != NULL;
+
+    if (ok) {
+        // 按快照桶统计条目数量，再按桶排列条目
+        for (HashMapIterator it = initIterator(hashMap); hasNext(&it); next(&it)) {
+            starts[snapshotBucket(hashMap->hashKind, hashMap->hashSeed, bucketCount, getKey(&it)) + 1]++;
+        }
+        for (uint64_t b = 0; b < bucketCount; b++) {
+            starts[b + 1] += starts[b];
+            cursors[b] = starts[b];
+        }
+        for (HashMapIterator it = initIterator(hashMap); hasNext(&it); next(&it)) {
+            uint64_t i = cursors[snapshotBucket(hashMap->hashKind, hashMap->hashSeed, bucketCount, getKey(&it))]++;
+            entries[i].key = getKey(&it);
+            vals[i] = getValue(&it);
+        }
+    }
+
+    HashSnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    SnapshotWriter writer = {fd, buf, 0, 0, 0, 0, ok};
+    if (ok) {
+        // 先写占位文件头，内容写完后再补写
+        writer.ok = writeAll(fd, &header, sizeof(header));
+    }
+
+    // 值区域按条目顺序存放，每个值补齐到 HASH_SNAPSHOT_VALUE_ALIGN 字节，按结构体读取时不会未对齐
+    static const unsigned char padding[HASH_SNAPSHOT_VALUE_ALIGN] = {0};
+    uint64_t valuesSize = 0;
+    for (size_t i = 0; i < count && writer.ok; i++) {
+        size_t length = 0;
+        const void *bytes = serialize != NULL ? serialize(vals[i], &length, ctx) : "";
+        if (bytes == NULL || length > UINT32_MAX) {
+            writer.ok = false;
+            break;
+        }
+        entries[i].length = (uint32_t)length;
+        entries[i].offset = valuesSize;
+        writerPut(&writer, bytes, length);
+        size_t pad = (HASH_SNAPSHOT_VALUE_ALIGN - length % HASH_SNAPSHOT_VALUE_ALIGN) % HASH_SNAPSHOT_VALUE_ALIGN;
+        writerPut(&writer, padding, pad);
+        valuesSize += length + pad;
+    }
+    writerPut(&writer, starts, (size_t)(bucketCount + 1) * sizeof(uint64_t));
+    writerPut(&writer, entries, count * sizeof(HashSnapshotEntry));
+    writerFlush(&writer);
+
+    if (writer.ok) {
+        header.magic = HASH_SNAPSHOT_MAGIC;
+        header.version = HASH_SNAPSHOT_VERSION;
+        header.endian = HASH_SNAPSHOT_ENDIAN;
+        header.hashKind = (uint32_t)hashMap->hashKind;
+        header.hashSeed = hashMap->hashSeed;
+        header.count = count;
+        header.bucketCount = bucketCount;
+        header.valuesSize = valuesSize;
+        header.payloadSize = writer.written;
+        header.checksum = writer.checksum;
+        writer.ok = lseek(fd, base, SEEK_SET) == base && writeAll(fd, &header, sizeof(header)) &&
+                    lseek(fd, base + (off_t)sizeof(header) + (off_t)writer.written, SEEK_SET) >= 0;
+    }
+
+    if (starts != NULL) {
+        free(starts);
+    }
+    if (cursors != NULL) {
+        free(cursors);
+    }
+    if (entries != NULL) {
+        free(entries);
+    }
+    if (vals != NULL) {
+        free(vals);
+    }
+    if (buf != NULL) {
+        free(buf);
+    }
+    return writer.ok;
+}
+
+/* 检查映像的文件头和各区域大小，verify 为 true 时再校验校验和 */
+static bool parseImage(const unsigned char *image, size_t length, bool verify, SnapshotView *view) {
+    if (length < sizeof(HashSnapshotHeader)) {
+        return false;
+    }
+    const HashSnapshotHeader *header = (const HashSnapshotHeader *)(const void *)image;
+    if (header->magic != HASH_SNAPSHOT_MAGIC || header->version != HASH_SNAPSHOT_VERSION ||
+        header->endian != HASH_SNAPSHOT_ENDIAN || header->hashKind >= HASH_KIND_COUNT ||
+        header->payloadSize != length - sizeof(HashSnapshotHeader) || header->valuesSize % HASH_SNAPSHOT_VALUE_ALIGN != 0 ||
+        header->bucketCount == 0 || (header->bucketCount & (header->bucketCount - 1)) != 0) {
+        return false;
+    }
+    // 逐项检查区域大小，避免乘法溢出
+    uint64_t remaining = header->payloadSize;
+    if (header->valuesSize > remaining) {
+        return false;
+    }
+    remaining -= header->valuesSize;
+    if (header->bucketCount >= remaining / sizeof(uint64_t)) {
+        return false;
+    }
+    remaining -= (header->bucketCount + 1) * sizeof(uint64_t);
+    if (header->count != remaining / sizeof(HashSnapshotEntry) || remaining % sizeof(HashSnapshotEntry) != 0) {
+        return false;
+    }
+    if (verify && checksumRange(image + sizeof(HashSnapshotHeader), header->payloadSize) != header->checksum) {
+        return false;
+    }
+
+    view->header = header;
+    view->values = image + sizeof(HashSnapshotHeader);
+    view->starts = (const uint64_t *)(const void *)(view->values + header->valuesSize);
+    view->entries = (const HashSnapshotEntry *)(const void *)(view->starts + header->bucketCount + 1);
+    return view->starts[header->bucketCount] == header->count;
+}
+
+/* 条目的值是否位于值区域内且对齐 */
+static inline bool entryInRange(const SnapshotView *view, const HashSnapshotEntry *entry) {
+    return entry->offset % HASH_SNAPSHOT_VALUE_ALIGN == 0 && entry->offset <= view->header->valuesSize &&
+           entry->length <= view->header->valuesSize - entry->offset;
+}
+
+/* 读入整个文件，失败时返回NULL */
+static unsigned char *readImage(const char *path, size_t *length) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    unsigned char *image = NULL;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        image = (unsigned char *)malloc((size_t)st.st_size);
+    }
+    size_t got = 0;
+    while (image != NULL && got < (size_t)st.st_size) {
+        ssize_t n = read(fd, image + got, (size_t)st.st_size - got);
+        if (n <= 0) {
+            free(image);
+            image = NULL;
+            break;
+        }
+        got += (size_t)n;
+    }
+    close(fd);
+    *length = got;
+    return image;
+}
+
+/* 从快照文件加载哈希表 */
+HashMapChaining *hashMapLoad(const char *path, HashSnapshotDeserializer deserialize, void *ctx, void (*freeVal)(void*)) {
+    // 零拷贝加载的值指向映像内部，不能逐个释放
+    if (path == NULL || (deserialize == NULL && freeVal != NULL)) {
+        return NULL;
+    }
+    size_t length = 0;
+    unsigned char *image = readImage(path, &length);
+    if (image == NULL) {
+        return NULL;
+    }
+    SnapshotView view;
+    if (!parseImage(image, length, true, &view)) {
+        free(image);
+        return NULL;
+    }
+
+    const HashSnapshotHeader *header = view.header;
+    HashMapChainingConfig config = defaultHashMapConfig((size_t)header->bucketCount, freeVal);
+    config.pow2Capacity = true;
+    config.hashKind = (HashKind)header->hashKind;
+    config.hashSeed = header->hashSeed;
+    HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+    if (hashMap == NULL) {
+        free(image);
+        return NULL;
+    }
+
+    // 哈希策略、种子和桶数量都与快照一致时，快照的桶就是哈希表的桶，直接链接节点；
+    // 否则（例如编译期固定了不同的哈希策略）逐个 put
+    bool sameLayout = hashMap->hashKind == config.hashKind && hashMap->hashSeed == config.hashSeed &&
+                      hashMap->capacity == header->bucketCount;
+    bool ok = true;
+    for (uint64_t b = 0; b < header->bucketCount && ok; b++) {
+        for (uint64_t i = view.starts[b]; i < view.starts[b + 1] && ok; i++) {
+            const HashSnapshotEntry *entry = &view.entries[i];
+            if (i >= header->count || !entryInRange(&view, entry)) {
+                ok = false;
+                break;
+            }
+            const unsigned char *bytes = view.values + entry->offset;
+            void *val = deserialize != NULL ? deserialize(bytes, entry->length, ctx) : (void *)(uintptr_t)bytes;
+            if (val == NULL) {
+                ok = false;
+                break;
+            }
+            if (!sameLayout) {
+                put(hashMap, entry->key, val);
+                continue;
+            }
+            HashNode *node = (HashNode *)nodePoolAlloc(&hashMap->nodePool);
+            if (node == NULL) {
+                if (freeVal != NULL) {
+                    freeVal(val);
+                }
+                ok = false;
+                break;
+            }
+            node->pair.key = entry->key;
+            node->pair.val = val;
+            node->next = hashMap->buckets[b];
+            hashMap->buckets[b] = node;
+            hashMap->size++;
+        }
+    }
+
+    if (deserialize == NULL) {
+        // 值直接指向映像，映像随哈希表一起释放
+        hashMap->image = image;
+    } else {
+        free(image);
+    }
+    if (!ok) {
+        delHashMapChaining(hashMap);
+        return NULL;
+    }
+    return hashMap;
+}
+
+/* 以只读方式映射快照文件 */
+HashSnapshot *hashSnapshotOpen(const char *path, bool verify) {
+    if (path == NULL) {
+        return NULL;
+    }
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+    void *base = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+
+    HashSnapshot *snapshot = (HashSnapshot *)malloc(sizeof(HashSnapshot));
+    if (snapshot == NULL || !parseImage((const unsigned char *)base, (size_t)st.st_size, verify, &snapshot->view)) {
+        if (snapshot != NULL) {
+            free(snapshot);
+        }
+        munmap(base, (size_t)st.st_size);
+        return NULL;
+    }
+    snapshot->base = base;
+    snapshot->length = (size_t)st.st_size;
+    return snapshot;
+}
+
+/* 关闭快照 */
+void hashSnapshotClose(HashSnapshot *snapshot) {
+    if (snapshot == NULL) {
+        return;
+    }
+    munmap(snapshot->base, snapshot->length);
+    free(snapshot);
+}
+
+/* 在映射的快照中查找键 */
+const void *hashSnapshotGet(HashSnapshot *snapshot, int key, size_t *length) {
+    if (snapshot == NULL) {
+        return NULL;
+    }
+    const SnapshotView *view = &snapshot->view;
+    const HashSnapshotHeader *header = view->header;
+    uint64_t b = snapshotBucket((HashKind)header->hashKind, header->hashSeed, header->bucketCount, key);
+    uint64_t end = view->starts[b + 1] < header->count ? view->starts[b + 1] : header->count;
+    for (uint64_t i = view->starts[b]; i < end; i++) {
+        const HashSnapshotEntry *entry = &view->entries[i];
+        if (entry->key == key) {
+            if (!entryInRange(view, entry)) {
+                return NULL;
+            }
+            if (length != NULL) {
+                *length = entry->length;
+            }
+            return view->values + entry->offset;
+        }
+    }
+    return NULL;
+}
+
+/* 获取快照中的键值对数量 */
+size_t hashSnapshotSize(HashSnapshot *snapshot) {
+    return snapshot == NULL ? 0 : (size_t)snapshot->view.header->count;
+}
@@ -0,0 +1,134 @@
+#ifndef HASH_TABLE_SNAPSHOT_H
+#define HASH_TABLE_SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hash_table.h"
+
+/*
+ * 哈希表快照
+ *
+ * 把 HashMapChaining 写成与位置无关的二进制映像，重启时不必逐个 put 重建：
+ *   - hashMapLoad 一次读入整个文件，按快照中的桶布局直接链接节点（节点来自 slab，不逐个分配），
+ *     不提供反序列化函数时值直接指向读入的映像，整个加载过程只有一次大块分配；
+ *   - hashSnapshotOpen 以只读方式 mmap 文件，不加载也可以直接查询。
+ *
+ * 文件布局（按本机字节序，所有位置都是相对偏移）：
+ *   HashSnapshotHeader | 值区域 | 桶起始下标 uint64_t[bucketCount + 1] | 条目 HashSnapshotEntry[count]
+ * 条目按桶排列，桶 b 的条目为 entries[starts[b]] ~ entries[starts[b + 1] - 1]。
+ * 每个值都补齐到 HASH_SNAPSHOT_VALUE_ALIGN 字节，文件头的大小也是它的倍数，映像按它对齐时
+ * 值可以直接按 8 字节对齐的结构体读取。
+ * 校验和覆盖文件头之后的全部内容，按 HASH_SNAPSHOT_BLOCK 字节分块计算。
+ */
+
+#define HASH_SNAPSHOT_MAGIC 0x50414E53u     // 快照文件魔数 "SNAP"
+#define HASH_SNAPSHOT_VERSION 3u            // 快照格式版本，2 起每个值按 HASH_SNAPSHOT_VALUE_ALIGN 对齐，3 起 murmur 策略使用种子
+#define HASH_SNAPSHOT_ENDIAN 0x01020304u    // 字节序标记，读取时不相等说明字节序不同
+#define HASH_SNAPSHOT_BLOCK 65536           // 写入缓冲区大小，也是校验和的分块大小
+#define HASH_SNAPSHOT_VALUE_ALIGN 8         // 值在值区域中的对齐字节数
+
+/* 快照文件头 */
+typedef struct {
+    uint32_t magic;         // HASH_SNAPSHOT_MAGIC
+    uint32_t version;       // HASH_SNAPSHOT_VERSION
+    uint32_t endian;        // HASH_SNAPSHOT_ENDIAN
+    uint32_t hashKind;      // 哈希策略
+    uint64_t hashSeed;      // 哈希种子
+    uint64_t count;         // 键值对数量
+    uint64_t bucketCount;   // 桶数量，2 的幂
+    uint64_t valuesSize;    // 值区域字节数，8 的倍数
+    uint64_t payloadSize;   // 文件头之后的字节数
+    uint64_t checksum;      // 文件头之后全部内容的校验和
+} HashSnapshotHeader;
+
+/* 快照条目 */
+typedef struct {
+    int32_t key;            // 键
+    uint32_t length;        // 值的字节数
+    uint64_t offset;        // 值在值区域中的偏移，HASH_SNAPSHOT_VALUE_ALIGN 的倍数
+} HashSnapshotEntry;
+
+/**
+ * @brief 值序列化函数
+ *
+ * 返回表示 val 的字节及其长度，返回的内存在下一次调用前必须保持有效（可以是 ctx 中的缓冲区）。
+ * 返回 NULL 表示序列化失败，保存随之失败。
+ */
+typedef const void *(*HashSnapshotSerializer)(const void *val, size_t *length, void *ctx);
+
+/**
+ * @brief 值反序列化函数
+ *
+ * 根据快照中的字节创建值，返回的值归哈希表所有（由 freeVal 释放）。返回 NULL 时加载失败。
+ */
+typedef void *(*HashSnapshotDeserializer)(const void *bytes, size_t length, void *ctx);
+
+/* 只读映射的快照 */
+typedef struct HashSnapshot HashSnapshot;
+
+/**
+ * @brief 把哈希表保存到文件描述符
+ *
+ * 从 fd 的当前位置开始写入，完成后回到起始位置补写文件头，因此 fd 必须可以定位（普通文件）。
+ * 以 mmap 方式打开时要求快照位于文件开头。
+ *
+ * @param hashMap 哈希表的指针
+ * @param fd 以写方式打开的文件描述符
+ * @param serialize 值序列化函数，为 NULL 时只保存键（值的长度为0）
+ * @param ctx 传给序列化函数的参数
+ * @return 成功时返回true
+ */
+bool hashMapSave(HashMapChaining *hashMap, int fd, HashSnapshotSerializer serialize, void *ctx);
+
+/**
+ * @brief 从快照文件加载哈希表
+ *
+ * 一次读入整个文件并校验，返回的哈希表使用 2 的幂容量以及快照中的哈希策略和种子，
+ * 桶数组大小已足够容纳全部键值对。
+ *
+ * @param path 快照文件路径
+ * @param deserialize 值反序列化函数；为 NULL 时值直接指向哈希表持有的快照映像，此时 freeVal 必须为 NULL，
+ *                    值在哈希表删除前一直有效，不能修改，按 HASH_SNAPSHOT_VALUE_ALIGN 字节对齐
+ * @param ctx 传给反序列化函数的参数
+ * @param freeVal val 值释放函数，不需要释放时为 NULL
+ * @return 成功时返回哈希表，文件无法读取、格式或校验和错误、内存不足、deserialize 为 NULL 而 freeVal 不为 NULL
+ *         时返回NULL
+ */
+HashMapChaining *hashMapLoad(const char *path, HashSnapshotDeserializer deserialize, void *ctx, void (*freeVal)(void*));
+
+/**
+ * @brief 以只读方式映射快照文件
+ *
+ * @param path 快照文件路径
+ * @param verify 是否校验校验和（需要读取整个文件）
+ * @return 成功时返回快照，失败时返回NULL
+ */
+HashSnapshot *hashSnapshotOpen(const char *path, bool verify);
+
+/**
+ * @brief 关闭快照并解除映射
+ *
+ * @param snapshot 快照的指针
+ */
+void hashSnapshotClose(HashSnapshot *snapshot);
+
+/**
+ * @brief 在映射的快照中查找键
+ *
+ * @param snapshot 快照的指针
+ * @param key 要查找的键
+ * @param length 不为 NULL 时输出值的字节数
+ * @return 返回指向映射中值字节的指针（按 HASH_SNAPSHOT_VALUE_ALIGN 字节对齐），键不存在时返回NULL
+ */
+const void *hashSnapshotGet(HashSnapshot *snapshot, int key, size_t *length);
+
+/**
+ * @brief 获取快照中的键值对数量
+ *
+ * @param snapshot 快照的指针
+ * @return 返回键值对数量
+ */
+size_t hashSnapshotSize(HashSnapshot *snapshot);
+
+#endif // HASH_TABLE_SNAPSHOT_H
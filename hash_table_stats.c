@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <string.h>
+#include "hash_table.h"
+#include "hash_table_internal.h"
+
+/*
+ * 哈希表统计信息
+ *
+ * 链长分布每次调用时遍历桶数组计算；探测长度和扩容计数由热路径在定义 HASH_TABLE_STATS 时累加。
+ */
+
+/* 获取哈希表统计信息 */
+void hashMapStats(HashMapChaining *hashMap, HashMapStats *out) {
+    if (out == NULL) {
+        return;
+    }
+    memset(out, 0, sizeof(*out));
+    if (hashMap == NULL) {
+        return;
+    }
+
+    out->size = hashMap->size;
+    out->capacity = hashMap->capacity;
+    out->loadFactor = loadFactor(hashMap);
+    chainLengthHistogram(hashMap, out->chainHistogram, HASH_TABLE_STATS_BINS);
+    for (size_t i = 0; i < HASH_TABLE_STATS_BINS; i++) {
+        if (out->chainHistogram[i] > 0) {
+            out->maxChain = i;
+        }
+    }
+#ifdef HASH_TABLE_STATS
+    out->enabled = true;
+    out->get = hashMap->stats.get;
+    out->put = hashMap->stats.put;
+    out->remove = hashMap->stats.remove;
+    out->extendCount = hashMap->stats.extendCount;
+    out->extendNs = hashMap->stats.extendNs;
+#endif
+}
+
+/* 清零探测长度和扩容计数 */
+void hashMapStatsReset(HashMapChaining *hashMap) {
+#ifdef HASH_TABLE_STATS
+    if (hashMap != NULL) {
+        memset(&hashMap->stats, 0, sizeof(hashMap->stats));
+    }
+#else
+    (void)hashMap;
+#endif
+}
+
+/* 打印一类操作的探测长度 */
+static void printProbes(const char *name, const HashProbeStats *stats) {
+    printf("  %-6s 命中 %zu 次, 平均探测 %.2f, 最大 %zu; 未命中 %zu 次, 平均探测 %.2f, 最大 %zu\n", name,
+           stats->hits, stats->hits ? (double)stats->hitProbes / (double)stats->hits : 0.0, stats->maxHitProbe,
+           stats->misses, stats->misses ? (double)stats->missProbes / (double)stats->misses : 0.0, stats->maxMissProbe);
+}
+
+/* 打印哈希表统计信息 */
+void hashMapStatsPrint(HashMapChaining *hashMap) {
+    if (hashMap == NULL) {
+        return;
+    }
+
+    HashMapStats stats;
+    hashMapStats(hashMap, &stats);
+    printf("键值对: %zu, 桶: %zu, 负载因子: %.3f, 哈希策略: %s\n",
+           stats.size, stats.capacity, (double)stats.loadFactor, hashKindName(hashMap->hashKind));
+    if (stats.enabled) {
+        printProbes("get", &stats.get);
+        printProbes("put", &stats.put);
+        printProbes("remove", &stats.remove);
+        printf("  扩容 %zu 次, 耗时 %.3f 毫秒\n", stats.extendCount, (double)stats.extendNs / 1e6);
+    } else {
+        printf("  (未定义 HASH_TABLE_STATS，不记录探测长度和扩容耗时)\n");
+    }
+
+    HashCacheStats cache;
+    hashMapCacheStats(hashMap, &cache);
+    if (cache.enabled) {
+        size_t lookups = cache.hits + cache.misses;
+        printf("  缓存: 命中 %zu 次, 未命中 %zu 次, 命中率 %.3f, 淘汰 %zu 次, 占用 %zu 字节\n", cache.hits,
+               cache.misses, lookups ? (double)cache.hits / (double)lookups : 0.0, cache.evictions, cache.bytes);
+    }
+
+    // 链长分布：最后一组包含更长的链表
+    printf("  链长分布:");
+    for (size_t i = 0; i <= stats.maxChain; i++) {
+        printf(" %zu%s:%zu", i, i == HASH_TABLE_STATS_BINS - 1 ? "+" : "", stats.chainHistogram[i]);
+    }
+    printf("\n");
+}
@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <string.h>
+#include "hash_table.h"
+#include "memcheck.h"
+#include "utility.h"
+
+#define TEST_KEYS 10000
+
+/* 24 字节的值，按值存放在节点中 */
+typedef struct {
+    double x;
+    double y;
+    int id;
+} Point;
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    HashMapChainingConfig config = defaultHashMapConfig(16, NULL);
+    config.valSize = sizeof(Point);
+    HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+    if (hashMap == NULL) {
+        printf("创建哈希表失败\n");
+        return 1;
+    }
+
+    // 插入时拷贝值，之后修改局部变量不影响表中的值；插入期间多次扩容
+    size_t allocationsBefore = memcheck_get_allocation_count();
+    for (int i = 0; i < TEST_KEYS; i++) {
+        Point p = {i * 0.5, i * 2.0, i};
+        putCopy(hashMap, i, &p);
+        p.id = -1;
+    }
+    printf("插入 %d 个内联值, 内存分配次数: %zu\n", TEST_KEYS, memcheck_get_allocation_count() - allocationsBefore);
+
+    bool ok = size(hashMap) == TEST_KEYS;
+    for (int i = 0; i < TEST_KEYS && ok; i++) {
+        const Point *p = (const Point *)getPtr(hashMap, i);
+        ok = p != NULL && p->id == i && (int)p->y == i * 2 && ((uintptr_t)p % sizeof(double)) == 0;
+    }
+    printf("查找内联值: %s\n", ok ? "正确" : "错误");
+
+    // 通过返回的地址原地修改
+    Point *p = (Point *)getPtr(hashMap, 42);
+    if (p != NULL) {
+        p->x = -1.0;
+    }
+    const Point *again = (const Point *)get(hashMap, 42);
+    ok = ok && again != NULL && (int)again->x == -1;
+
+    // 覆盖已有键、清零插入和 put 的拷贝语义
+    Point replacement = {0.0, 0.0, 4242};
+    ok = ok && ((Point *)putCopy(hashMap, 42, &replacement))->id == 4242 && size(hashMap) == TEST_KEYS;
+    ok = ok && ((Point *)putCopy(hashMap, -1, NULL))->id == 0;
+    Point viaPut = {1.0, 1.0, 7};
+    put(hashMap, -2, &viaPut);
+    viaPut.id = 8;
+    ok = ok && ((Point *)getPtr(hashMap, -2))->id == 7;
+
+    // 删除和迭代
+    for (int i = 0; i < TEST_KEYS; i += 2) {
+        removeItem(hashMap, i);
+    }
+    size_t visited = 0;
+    for (HashMapIterator it = initIterator(hashMap); hasNext(&it); next(&it)) {
+        const Point *value = (const Point *)getValue(&it);
+        ok = ok && (getKey(&it) < 0 || value->id == getKey(&it));
+        visited++;
+    }
+    printf("删除偶数键后遍历 %zu 个键值对: %s\n", visited, ok ? "正确" : "错误");
+    ok = ok && visited == TEST_KEYS / 2 + 2;
+
+    delHashMapChaining(hashMap);
+    printf("%s\n", ok ? "所有测试通过" : "测试失败");
+
+    // 内存检测报告
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return ok ? 0 : 1;
+}
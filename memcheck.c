@@ -1,152 +1,708 @@
 #include "memcheck.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <time.h>
 
-// 统计信息
-static size_t total_allocations = 0;    // 总分配次数
-static size_t total_frees = 0;         // 总释放次数
-static bool is_initialized = false;    // 是否已初始化
+// 统计信息，多线程下使用原子计数
+static atomic_size_t total_allocations;     // 总分配次数
+static atomic_size_t total_frees;           // 总释放次数
+static atomic_bool is_initialized;          // 是否已初始化
+static atomic_bool verbose_output;          // 是否逐条打印内存操作
+static pthread_mutex_t init_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * 二进制追踪
+ *
+ * 每个线程把事件写入自己的缓冲区，缓冲区满时才获取锁批量写入文件，
+ * 记录一条事件的开销只是一次内存拷贝。缓冲区在线程退出后保留，停止追踪时统一写出。
+ */
+typedef struct TraceBuffer {
+    struct TraceBuffer *next;   // 所有线程缓冲区组成的链表
+    uint32_t thread;            // 线程编号
+    size_t count;               // 已缓冲的事件数量
+    MemcheckTraceEvent events[MEMCHECK_TRACE_BUFFER];
+} TraceBuffer;
+
+static _Thread_local TraceBuffer *local_buffer;      // 当前线程的缓冲区
+static TraceBuffer *all_buffers;                     // 所有缓冲区，由 trace_lock 保护
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static FILE *trace_file;                             // 追踪文件，由 trace_lock 保护
+static atomic_bool trace_active;                     // 是否正在追踪
+static atomic_uint trace_sample_every;               // 采样间隔
+static atomic_uint next_thread;                      // 下一个线程编号
 
 // 初始化内存检测系统
 void memcheck_init(void) {
-    if (!is_initialized) {
-        total_allocations = 0;
-        total_frees = 0;
-        is_initialized = true;
+    if (atomic_load_explicit(&is_initialized, memory_order_acquire)) {
+        return;
+    }
+    pthread_mutex_lock(&init_lock);
+    if (!atomic_load(&is_initialized)) {
+        atomic_store(&total_allocations, 0);
+        atomic_store(&total_frees, 0);
+        const char *env = getenv("MEMCHECK_VERBOSE");
+        if (env != NULL && env[0] != '\0' && env[0] != '0') {
+            atomic_store(&verbose_output, true);
+        }
+        atomic_store_explicit(&is_initialized, true, memory_order_release);
         printf("[MemCheck] 内存检测系统已初始化\n");
     }
+    pthread_mutex_unlock(&init_lock);
 }
 
 // 清理内存检测系统
 void memcheck_cleanup(void) {
-    if (is_initialized) {
+    if (atomic_load(&is_initialized)) {
+        memcheck_trace_stop();
         memcheck_report();
-        is_initialized = false;
+        atomic_store(&is_initialized, false);
         printf("[MemCheck] 内存检测系统已清理\n");
     }
 }
 
-// 分配内存并打印地址
-void *memcheck_malloc(size_t size, const char *file, int line) {
-    if (!is_initialized) {
-        memcheck_init();
+// 设置是否逐条打印内存操作
+void memcheck_set_verbose(bool verbose) {
+    atomic_store(&verbose_output, verbose);
+}
+
+static inline bool is_verbose(void) {
+    return atomic_load_explicit(&verbose_output, memory_order_relaxed);
+}
+
+// 按地址采样，同一地址的分配和释放采样结果相同
+static inline bool trace_sampled(uintptr_t addr) {
+    unsigned every = atomic_load_explicit(&trace_sample_every, memory_order_relaxed);
+    if (every <= 1) {
+        return true;
+    }
+    uint64_t h = ((uint64_t)addr >> 4) * 0x9E3779B97F4A7C15ULL;
+    return (h >> 32) % every == 0;
+}
+
+static uint64_t trace_now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+// 把缓冲区写入文件，调用者需持有 trace_lock
+static void flush_buffer_locked(TraceBuffer *buffer) {
+    if (trace_file != NULL && buffer->count > 0) {
+        fwrite(buffer->events, sizeof(MemcheckTraceEvent), buffer->count, trace_file);
+    }
+    buffer->count = 0;
+}
+
+// 获取当前线程的缓冲区，第一次使用时分配
+static TraceBuffer *thread_buffer(void) {
+    if (local_buffer != NULL) {
+        return local_buffer;
+    }
+    TraceBuffer *buffer = (TraceBuffer *)malloc(sizeof(TraceBuffer));
+    if (buffer == NULL) {
+        return NULL;
+    }
+    buffer->count = 0;
+    buffer->thread = atomic_fetch_add(&next_thread, 1);
+    pthread_mutex_lock(&trace_lock);
+    buffer->next = all_buffers;
+    all_buffers = buffer;
+    pthread_mutex_unlock(&trace_lock);
+    local_buffer = buffer;
+    return buffer;
+}
+
+// 记录一条追踪事件
+static void trace_event(MemcheckEventKind kind, uintptr_t addr, uintptr_t old_addr, size_t size,
+                        const char *file, int line) {
+    TraceBuffer *buffer = thread_buffer();
+    if (buffer == NULL) {
+        return;
+    }
+
+    MemcheckTraceEvent *event = &buffer->events[buffer->count++];
+    event->timeNs = trace_now_ns();
+    event->ptr = (uint64_t)addr;
+    event->oldPtr = (uint64_t)old_addr;
+    event->size = size;
+    event->thread = buffer->thread;
+    event->kind = (uint32_t)kind;
+    event->line = (uint32_t)line;
+    event->reserved = 0;
+    size_t len = strlen(file);
+    const char *tail = len >= MEMCHECK_TRACE_FILE_LEN ? file + len - (MEMCHECK_TRACE_FILE_LEN - 1) : file;
+    size_t copy = strlen(tail);
+    memcpy(event->file, tail, copy);
+    memset(event->file + copy, 0, MEMCHECK_TRACE_FILE_LEN - copy);
+
+    if (buffer->count == MEMCHECK_TRACE_BUFFER) {
+        pthread_mutex_lock(&trace_lock);
+        flush_buffer_locked(buffer);
+        pthread_mutex_unlock(&trace_lock);
+    }
+}
+
+/*
+ * 分配头
+ *
+ * 每块内存前面放一个分配头，记录请求的字节数和分配位置，用于统计当前占用和峰值占用。
+ * 头部的魔数与用户地址异或保存，释放时改写，因此判断指针是否有效只需读一次头部。
+ * 分配头的大小为 max_align_t 的整数倍，用户地址的对齐与直接调用 malloc 相同。
+ */
+typedef union {
+    struct {
+        uint64_t magic;     // MEMCHECK_HEADER_MAGIC ^ 用户地址，释放后为 MEMCHECK_FREED_MAGIC
+        size_t size;        // 请求的字节数
+        uint32_t site;      // 分配位置编号，位置表已满时为 MEMCHECK_NO_SITE
+    } info;
+    max_align_t align;
+} MemcheckHeader;
+
+#define MEMCHECK_HEADER_MAGIC 0x4D454D434B484452ULL  // "MEMCKHDR"
+#define MEMCHECK_FREED_MAGIC 0x4D454D434B465245ULL   // "MEMCKFRE"
+#define MEMCHECK_NO_SITE UINT32_MAX
+
+static atomic_size_t live_bytes;    // 当前占用的字节数
+static atomic_size_t peak_bytes;    // 峰值占用的字节数
+
+/*
+ * 分配位置表
+ *
+ * 以 (文件, 行号) 为键的开放寻址表。查找不加锁，只有第一次出现新位置时才获取锁插入。
+ * 每个位置记录分配次数、当前占用和按 2 的幂分组的大小分布。
+ */
+typedef struct {
+    atomic_bool ready;                  // 位置信息是否已经写好
+    const char *file;                   // 源文件名
+    int line;                           // 行号
+    atomic_size_t allocations;          // 分配次数
+    atomic_size_t live_blocks;          // 未释放的块数
+    atomic_size_t live_bytes;           // 未释放的字节数
+    atomic_size_t bins[MEMCHECK_SIZE_BINS]; // bins[k] 为大小在 [2^(k-1), 2^k) 之间的分配次数，bins[0] 为 0 字节
+} MemcheckSite;
+
+static MemcheckSite sites[MEMCHECK_MAX_SITES];
+static pthread_mutex_t site_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static inline size_t site_slot(const char *file, int line) {
+    uint64_t h = ((uint64_t)(uintptr_t)file >> 3) ^ ((uint64_t)(uint32_t)line * 0x9E3779B97F4A7C15ULL);
+    return (size_t)((h ^ (h >> 29)) % MEMCHECK_MAX_SITES);
+}
+
+// 查找或插入分配位置，返回位置编号
+static uint32_t site_index(const char *file, int line) {
+    size_t start = site_slot(file, line);
+    for (size_t i = 0; i < MEMCHECK_MAX_SITES; i++) {
+        MemcheckSite *site = &sites[(start + i) % MEMCHECK_MAX_SITES];
+        if (!atomic_load_explicit(&site->ready, memory_order_acquire)) {
+            break;
+        }
+        if (site->file == file && site->line == line) {
+            return (uint32_t)((start + i) % MEMCHECK_MAX_SITES);
+        }
+    }
+
+    uint32_t index = MEMCHECK_NO_SITE;
+    pthread_mutex_lock(&site_lock);
+    for (size_t i = 0; i < MEMCHECK_MAX_SITES; i++) {
+        size_t slot = (start + i) % MEMCHECK_MAX_SITES;
+        MemcheckSite *site = &sites[slot];
+        if (!atomic_load(&site->ready)) {
+            site->file = file;
+            site->line = line;
+            atomic_store_explicit(&site->ready, true, memory_order_release);
+            index = (uint32_t)slot;
+            break;
+        }
+        if (site->file == file && site->line == line) {
+            index = (uint32_t)slot;
+            break;
+        }
     }
-    
+    pthread_mutex_unlock(&site_lock);
+    return index;
+}
+
+// 大小所在的分组
+static inline size_t size_bin(size_t size) {
+    size_t bin = 0;
+    while (size > 0 && bin < MEMCHECK_SIZE_BINS - 1) {
+        size >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+// 写好分配头，更新占用统计，返回用户地址
+static void *attach_header(void *raw, size_t size, const char *file, int line) {
+    MemcheckHeader *header = (MemcheckHeader *)raw;
+    void *ptr = header + 1;
+    header->info.magic = MEMCHECK_HEADER_MAGIC ^ (uint64_t)(uintptr_t)ptr;
+    header->info.size = size;
+    header->info.site = site_index(file, line);
+
+    size_t live = atomic_fetch_add_explicit(&live_bytes, size, memory_order_relaxed) + size;
+    size_t peak = atomic_load_explicit(&peak_bytes, memory_order_relaxed);
+    while (live > peak && !atomic_compare_exchange_weak(&peak_bytes, &peak, live)) {
+    }
+
+    if (header->info.site != MEMCHECK_NO_SITE) {
+        MemcheckSite *site = &sites[header->info.site];
+        atomic_fetch_add_explicit(&site->allocations, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&site->live_blocks, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&site->live_bytes, size, memory_order_relaxed);
+        atomic_fetch_add_explicit(&site->bins[size_bin(size)], 1, memory_order_relaxed);
+    }
+    return ptr;
+}
+
+// 校验分配头，无效时返回 NULL
+static MemcheckHeader *valid_header(void *ptr) {
+    MemcheckHeader *header = (MemcheckHeader *)ptr - 1;
+    if (header->info.magic != (MEMCHECK_HEADER_MAGIC ^ (uint64_t)(uintptr_t)ptr)) {
+        return NULL;
+    }
+    return header;
+}
+
+// 从占用统计中减去一块内存，并把头部标记为已释放
+static void detach_header(MemcheckHeader *header) {
+    size_t size = header->info.size;
+    atomic_fetch_sub_explicit(&live_bytes, size, memory_order_relaxed);
+    if (header->info.site != MEMCHECK_NO_SITE) {
+        MemcheckSite *site = &sites[header->info.site];
+        atomic_fetch_sub_explicit(&site->live_blocks, 1, memory_order_relaxed);
+        atomic_fetch_sub_explicit(&site->live_bytes, size, memory_order_relaxed);
+    }
+    header->info.magic = MEMCHECK_FREED_MAGIC;
+}
+
+// 分配成功后的计数与记录
+static void record_allocation(MemcheckEventKind kind, void *ptr, size_t size, const char *file, int line) {
+    atomic_fetch_add_explicit(&total_allocations, 1, memory_order_relaxed);
+    if (atomic_load_explicit(&trace_active, memory_order_relaxed) && trace_sampled((uintptr_t)ptr)) {
+        trace_event(kind, (uintptr_t)ptr, 0, size, file, line);
+    }
+}
+
+// 释放前的计数与记录
+static void record_free(void *ptr, const char *file, int line) {
+    atomic_fetch_add_explicit(&total_frees, 1, memory_order_relaxed);
+    if (atomic_load_explicit(&trace_active, memory_order_relaxed) && trace_sampled((uintptr_t)ptr)) {
+        trace_event(MEMCHECK_EVENT_FREE, (uintptr_t)ptr, 0, 0, file, line);
+    }
+}
+
+// 分配内存并计数
+void *memcheck_malloc(size_t size, const char *file, int line) {
+    memcheck_init();
+
     // 直接调用标准库函数，避免递归
-    void *ptr = (void *)malloc(size);
-    
+    void *raw = size <= SIZE_MAX - sizeof(MemcheckHeader) ? malloc(sizeof(MemcheckHeader) + size) : NULL;
+    void *ptr = raw != NULL ? attach_header(raw, size, file, line) : NULL;
+
     if (ptr != NULL) {
-        total_allocations++;
-        printf("[MemCheck] 分配内存: 地址 %p, 大小 %zu 字节, 位置 %s:%d\n", 
-               ptr, size, file, line);
+        record_allocation(MEMCHECK_EVENT_MALLOC, ptr, size, file, line);
+        if (is_verbose()) {
+            printf("[MemCheck] 分配内存: 地址 %p, 大小 %zu 字节, 位置 %s:%d\n",
+                   ptr, size, file, line);
+        }
     } else {
-        fprintf(stderr, "[MemCheck] 错误: 内存分配失败, 大小 %zu 字节, 位置 %s:%d\n", 
+        fprintf(stderr, "[MemCheck] 错误: 内存分配失败, 大小 %zu 字节, 位置 %s:%d\n",
                 size, file, line);
     }
-    
+
     return ptr;
 }
 
-// 重新分配内存并打印地址
+// 重新分配内存并计数
 void *memcheck_realloc(void *ptr, size_t size, const char *file, int line) {
-    if (!is_initialized) {
-        memcheck_init();
-    }
-    
+    memcheck_init();
+
     // 如果ptr为NULL，相当于malloc
     if (ptr == NULL) {
         return memcheck_malloc(size, file, line);
     }
-    
+
     // 如果size为0，相当于free
     if (size == 0) {
         memcheck_free(ptr, file, line);
         return NULL;
     }
-    
-    printf("[MemCheck] 重新分配内存: 原地址 %p, 新大小 %zu 字节, 位置 %s:%d\n", 
-           ptr, size, file, line);
-    
-    // 重新分配内存
-    void *new_ptr = realloc(ptr, size);
-    
-    if (new_ptr != NULL) {
-        printf("[MemCheck] 重新分配完成: 新地址 %p\n", new_ptr);
-    } else {
-        fprintf(stderr, "[MemCheck] 错误: 内存重新分配失败, 大小 %zu 字节, 位置 %s:%d\n", 
+
+    MemcheckHeader *header = valid_header(ptr);
+    if (header == NULL) {
+        fprintf(stderr, "[MemCheck] 错误: 重新分配无效指针 %p, 位置 %s:%d\n", ptr, file, line);
+        return NULL;
+    }
+    if (is_verbose()) {
+        printf("[MemCheck] 重新分配内存: 原地址 %p, 新大小 %zu 字节, 位置 %s:%d\n",
+               ptr, size, file, line);
+    }
+
+    // 重新分配内存，调用前记录原地址是否被采样，调用后原地址可能已经被复用
+    uintptr_t old_addr = (uintptr_t)ptr;
+    bool old_sampled = atomic_load_explicit(&trace_active, memory_order_relaxed) && trace_sampled(old_addr);
+    MemcheckHeader saved = *header;
+    detach_header(header);
+    void *raw = size <= SIZE_MAX - sizeof(MemcheckHeader) ? realloc(header, sizeof(MemcheckHeader) + size) : NULL;
+    if (raw == NULL) {
+        // 原内存块保持不变，恢复分配头和统计
+        *header = saved;
+        atomic_fetch_add_explicit(&live_bytes, saved.info.size, memory_order_relaxed);
+        if (saved.info.site != MEMCHECK_NO_SITE) {
+            atomic_fetch_add_explicit(&sites[saved.info.site].live_blocks, 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&sites[saved.info.site].live_bytes, saved.info.size, memory_order_relaxed);
+        }
+        fprintf(stderr, "[MemCheck] 错误: 内存重新分配失败, 大小 %zu 字节, 位置 %s:%d\n",
                 size, file, line);
+        return NULL;
+    }
+    void *new_ptr = attach_header(raw, size, file, line);
+
+    // 原地址的释放和新地址的分配分别按各自的地址采样
+    if (old_sampled) {
+        trace_event(MEMCHECK_EVENT_FREE, old_addr, 0, 0, file, line);
+    }
+    if (atomic_load_explicit(&trace_active, memory_order_relaxed) && trace_sampled((uintptr_t)new_ptr)) {
+        trace_event(MEMCHECK_EVENT_REALLOC, (uintptr_t)new_ptr, old_addr, size, file, line);
     }
-    
+    if (is_verbose()) {
+        printf("[MemCheck] 重新分配完成: 新地址 %p\n", new_ptr);
+    }
+
     return new_ptr;
 }
 
 // 分配内存并初始化为0
 void *memcheck_calloc(size_t nmemb, size_t size, const char *file, int line) {
-    if (!is_initialized) {
-        memcheck_init();
+    memcheck_init();
+
+    void *ptr = NULL;
+    if (size == 0 || nmemb <= (SIZE_MAX - sizeof(MemcheckHeader)) / size) {
+        void *raw = calloc(1, sizeof(MemcheckHeader) + nmemb * size);
+        if (raw != NULL) {
+            ptr = attach_header(raw, nmemb * size, file, line);
+        }
     }
-    
-    void *ptr = calloc(nmemb, size);
-    
+
     if (ptr != NULL) {
-        total_allocations++;
-        printf("[MemCheck] 分配内存(calloc): 地址 %p, 数量 %zu, 单元大小 %zu 字节, 总大小 %zu 字节, 位置 %s:%d\n", 
-               ptr, nmemb, size, nmemb * size, file, line);
+        record_allocation(MEMCHECK_EVENT_CALLOC, ptr, nmemb * size, file, line);
+        if (is_verbose()) {
+            printf("[MemCheck] 分配内存(calloc): 地址 %p, 数量 %zu, 单元大小 %zu 字节, 总大小 %zu 字节, 位置 %s:%d\n",
+                   ptr, nmemb, size, nmemb * size, file, line);
+        }
     } else {
-        fprintf(stderr, "[MemCheck] 错误: 内存分配(calloc)失败, 数量 %zu, 单元大小 %zu 字节, 位置 %s:%d\n", 
+        fprintf(stderr, "[MemCheck] 错误: 内存分配(calloc)失败, 数量 %zu, 单元大小 %zu 字节, 位置 %s:%d\n",
                 nmemb, size, file, line);
     }
-    
+
     return ptr;
 }
 
-// 释放内存并打印地址
+// 释放内存并计数，ptr 必须是 NULL 或尚未释放的 memcheck 分配块
 void memcheck_free(void *ptr, const char *file, int line) {
-    if (!is_initialized) {
-        memcheck_init();
-    }
-    
+    memcheck_init();
+
     if (ptr == NULL) {
-        printf("[MemCheck] 警告: 尝试释放NULL指针, 位置 %s:%d\n", file, line);
+        if (is_verbose()) {
+            printf("[MemCheck] 警告: 尝试释放NULL指针, 位置 %s:%d\n", file, line);
+        }
         return; // 释放NULL指针是合法的，不做任何操作
     }
-    
-    printf("[MemCheck] 释放内存: 地址 %p, 位置 %s:%d\n", ptr, file, line);
-    total_frees++;
-    
+
+    MemcheckHeader *header = valid_header(ptr);
+    if (header == NULL) {
+        // 分配头被越界写破坏，或者 ptr 不是分配块的起始地址，不交给 free 以免破坏堆。
+        // 重复释放无法在这里检测：已释放块的分配头已归还系统分配器，读取它本身就是释放后使用
+        fprintf(stderr, "[MemCheck] 错误: 释放无效指针 %p（分配头校验失败）, 位置 %s:%d\n",
+                ptr, file, line);
+        return;
+    }
+
+    if (is_verbose()) {
+        printf("[MemCheck] 释放内存: 地址 %p, 位置 %s:%d\n", ptr, file, line);
+    }
+    record_free(ptr, file, line);
+    detach_header(header);
+
     // 释放实际内存
-    free(ptr);
+    free(header);
+}
+
+// 开始记录二进制追踪文件
+bool memcheck_trace_start(const char *path, unsigned sampleEvery) {
+    if (path == NULL) {
+        return false;
+    }
+    memcheck_init();
+
+    pthread_mutex_lock(&trace_lock);
+    if (trace_file != NULL) {
+        pthread_mutex_unlock(&trace_lock);
+        return false;
+    }
+    trace_file = fopen(path, "wb");
+    if (trace_file == NULL) {
+        pthread_mutex_unlock(&trace_lock);
+        return false;
+    }
+    MemcheckTraceHeader header;
+    header.magic = MEMCHECK_TRACE_MAGIC;
+    header.version = MEMCHECK_TRACE_VERSION;
+    header.sampleEvery = sampleEvery > 1 ? sampleEvery : 1;
+    header.eventSize = (uint32_t)sizeof(MemcheckTraceEvent);
+    fwrite(&header, sizeof(header), 1, trace_file);
+    for (TraceBuffer *buffer = all_buffers; buffer != NULL; buffer = buffer->next) {
+        buffer->count = 0;
+    }
+    atomic_store(&trace_sample_every, header.sampleEvery);
+    atomic_store(&trace_active, true);
+    pthread_mutex_unlock(&trace_lock);
+    return true;
+}
+
+// 停止记录并写出所有缓冲区
+void memcheck_trace_stop(void) {
+    atomic_store(&trace_active, false);
+    pthread_mutex_lock(&trace_lock);
+    for (TraceBuffer *buffer = all_buffers; buffer != NULL; buffer = buffer->next) {
+        flush_buffer_locked(buffer);
+    }
+    if (trace_file != NULL) {
+        fclose(trace_file);
+        trace_file = NULL;
+    }
+    pthread_mutex_unlock(&trace_lock);
+}
+
+// 读取整个追踪文件，返回事件数组
+static MemcheckTraceEvent *read_trace(const char *path, MemcheckTraceHeader *header, size_t *count) {
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        return NULL;
+    }
+    if (fread(header, sizeof(*header), 1, fp) != 1 || header->magic != MEMCHECK_TRACE_MAGIC ||
+        header->version != MEMCHECK_TRACE_VERSION || header->eventSize != sizeof(MemcheckTraceEvent)) {
+        fclose(fp);
+        return NULL;
+    }
+
+    size_t capacity = 1024, n = 0;
+    MemcheckTraceEvent *events = (MemcheckTraceEvent *)malloc(capacity * sizeof(MemcheckTraceEvent));
+    while (events != NULL) {
+        if (n == capacity) {
+            capacity *= 2;
+            MemcheckTraceEvent *grown = (MemcheckTraceEvent *)realloc(events, capacity * sizeof(MemcheckTraceEvent));
+            if (grown == NULL) {
+                free(events);
+                events = NULL;
+                break;
+            }
+            events = grown;
+        }
+        size_t got = fread(events + n, sizeof(MemcheckTraceEvent), capacity - n, fp);
+        n += got;
+        if (got == 0) {
+            break;
+        }
+    }
+    fclose(fp);
+    *count = n;
+    return events;
+}
+
+/* 排序键：同一地址的事件按时间相邻，时间相同时保持文件中的顺序 */
+typedef struct {
+    uint64_t ptr;
+    uint64_t timeNs;
+    size_t index;
+} TraceOrder;
+
+static int compare_order(const void *a, const void *b) {
+    const TraceOrder *x = (const TraceOrder *)a;
+    const TraceOrder *y = (const TraceOrder *)b;
+    if (x->ptr != y->ptr) {
+        return x->ptr < y->ptr ? -1 : 1;
+    }
+    if (x->timeNs != y->timeNs) {
+        return x->timeNs < y->timeNs ? -1 : 1;
+    }
+    return x->index < y->index ? -1 : (x->index > y->index);
+}
+
+// 解码追踪文件
+bool memcheck_trace_decode(const char *path, MemcheckTraceSummary *summary,
+                           void (*visitEvent)(const MemcheckTraceEvent *event, void *ctx),
+                           void (*visitLive)(const MemcheckTraceEvent *event, void *ctx), void *ctx) {
+    if (path == NULL || summary == NULL) {
+        return false;
+    }
+    MemcheckTraceHeader header;
+    size_t n = 0;
+    MemcheckTraceEvent *events = read_trace(path, &header, &n);
+    if (events == NULL) {
+        return false;
+    }
+    TraceOrder *order = (TraceOrder *)malloc((n > 0 ? n : 1) * sizeof(TraceOrder));
+    if (order == NULL) {
+        free(events);
+        return false;
+    }
+
+    memset(summary, 0, sizeof(*summary));
+    summary->sampleEvery = header.sampleEvery;
+    summary->events = n;
+    for (size_t i = 0; i < n; i++) {
+        MemcheckTraceEvent *event = &events[i];
+        event->file[MEMCHECK_TRACE_FILE_LEN - 1] = '\0';
+        summary->mallocs += event->kind == MEMCHECK_EVENT_MALLOC;
+        summary->callocs += event->kind == MEMCHECK_EVENT_CALLOC;
+        summary->reallocs += event->kind == MEMCHECK_EVENT_REALLOC;
+        summary->frees += event->kind == MEMCHECK_EVENT_FREE;
+        if (event->thread >= summary->threads) {
+            summary->threads = event->thread + 1;
+        }
+        if (visitEvent != NULL) {
+            visitEvent(event, ctx);
+        }
+        order[i].ptr = event->ptr;
+        order[i].timeNs = event->timeNs;
+        order[i].index = i;
+    }
+
+    // 线程缓冲区分批写出，文件中的顺序不是全局顺序，按地址分组后按时间配对
+    qsort(order, n, sizeof(TraceOrder), compare_order);
+    for (size_t i = 0; i < n;) {
+        const MemcheckTraceEvent *live = NULL;
+        size_t j = i;
+        for (; j < n && order[j].ptr == order[i].ptr; j++) {
+            const MemcheckTraceEvent *event = &events[order[j].index];
+            live = event->kind == MEMCHECK_EVENT_FREE ? NULL : event;
+        }
+        if (live != NULL) {
+            summary->liveBlocks++;
+            summary->liveBytes += (size_t)live->size;
+            if (visitLive != NULL) {
+                visitLive(live, ctx);
+            }
+        }
+        i = j;
+    }
+
+    free(order);
+    free(events);
+    return true;
 }
 
 // 生成简单报告
 void memcheck_report(void) {
-    if (!is_initialized) {
+    if (!atomic_load(&is_initialized)) {
         printf("[MemCheck] 内存检测系统未初始化\n");
         return;
     }
-    
+
+    size_t allocations = atomic_load(&total_allocations);
+    size_t frees = atomic_load(&total_frees);
     printf("\n===== 内存操作统计 =====\n");
-    printf("总分配次数: %zu\n", total_allocations);
-    printf("总释放次数: %zu\n", total_frees);
-    
-    if (total_allocations > total_frees) {
-        printf("警告: 可能存在内存泄漏, 有 %zu 次分配未释放\n", 
-               total_allocations - total_frees);
-    } else if (total_allocations < total_frees) {
+    printf("总分配次数: %zu\n", allocations);
+    printf("总释放次数: %zu\n", frees);
+    printf("当前占用: %zu 字节, 峰值占用: %zu 字节\n", atomic_load(&live_bytes), atomic_load(&peak_bytes));
+
+    if (allocations > frees) {
+        printf("警告: 可能存在内存泄漏, 有 %zu 次分配未释放\n",
+               allocations - frees);
+    } else if (allocations < frees) {
         printf("警告: 释放次数多于分配次数, 可能存在释放未分配内存的情况\n");
     } else {
         printf("所有分配的内存都已释放\n");
     }
-    
+
     printf("===== 报告结束 =====\n\n");
 }
 
-// 这些函数在简化版中不再需要实际功能，但为了保持API兼容性，保留空实现
+// 获取总分配次数
+size_t memcheck_get_allocation_count(void) {
+    return atomic_load(&total_allocations);
+}
+
+// 获取总释放次数
+size_t memcheck_get_free_count(void) {
+    return atomic_load(&total_frees);
+}
+
+// 获取当前占用的字节数
 size_t memcheck_get_allocated_memory(void) {
-    return 0; // 简化版不再跟踪已分配内存总量
+    return atomic_load(&live_bytes);
 }
 
+// 获取峰值占用的字节数
+size_t memcheck_get_peak_memory(void) {
+    return atomic_load(&peak_bytes);
+}
+
+// 把峰值重置为当前占用
+void memcheck_reset_peak(void) {
+    atomic_store(&peak_bytes, atomic_load(&live_bytes));
+}
+
+// 判断指针是否为尚未释放的 memcheck 分配块起始地址
 bool memcheck_is_valid_pointer(void *ptr) {
-    (void)ptr; // 避免未使用变量的警告(
-    return false; // 简化版不再跟踪指针有效性
+    return ptr != NULL && valid_header(ptr) != NULL;
+}
+
+// 文件名只保留最后一个路径分隔符之后的部分
+static const char *base_name(const char *file) {
+    const char *name = strrchr(file, '/');
+    return name != NULL ? name + 1 : file;
+}
+
+// 查询分配位置的统计
+size_t memcheck_get_site_stats(const char *file, int line, MemcheckSiteStats *out) {
+    if (file == NULL || out == NULL) {
+        return 0;
+    }
+    memset(out, 0, sizeof(*out));
+    size_t matched = 0;
+    for (size_t i = 0; i < MEMCHECK_MAX_SITES; i++) {
+        MemcheckSite *site = &sites[i];
+        if (!atomic_load_explicit(&site->ready, memory_order_acquire) ||
+            (line != 0 && site->line != line) || strcmp(base_name(site->file), file) != 0) {
+            continue;
+        }
+        out->allocations += atomic_load(&site->allocations);
+        out->liveBlocks += atomic_load(&site->live_blocks);
+        out->liveBytes += atomic_load(&site->live_bytes);
+        matched++;
+    }
+    return matched;
+}
+
+// 按分配位置输出统计
+void memcheck_report_sites(void) {
+    printf("\n===== 分配位置统计 =====\n");
+    printf("%-40s %10s %10s %12s  大小分布\n", "位置", "分配次数", "未释放块", "未释放字节");
+    for (size_t i = 0; i < MEMCHECK_MAX_SITES; i++) {
+        MemcheckSite *site = &sites[i];
+        if (!atomic_load_explicit(&site->ready, memory_order_acquire)) {
+            continue;
+        }
+        char location[64];
+        snprintf(location, sizeof(location), "%s:%d", base_name(site->file), site->line);
+        printf("%-40s %10zu %10zu %12zu ", location, atomic_load(&site->allocations),
+               atomic_load(&site->live_blocks), atomic_load(&site->live_bytes));
+        for (size_t k = 0; k < MEMCHECK_SIZE_BINS; k++) {
+            size_t count = atomic_load(&site->bins[k]);
+            if (count > 0) {
+                // 第 k 组的大小范围为 [2^(k-1), 2^k)，用下界表示
+                printf(" %zu:%zu", k == 0 ? (size_t)0 : (size_t)1 << (k - 1), count);
+            }
+        }
+        printf("\n");
+    }
+    printf("当前占用: %zu 字节, 峰值占用: %zu 字节\n", atomic_load(&live_bytes), atomic_load(&peak_bytes));
+    printf("===== 报告结束 =====\n\n");
 }
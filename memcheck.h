@@ -3,6 +3,73 @@
 
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * 内存检测
+ *
+ * 默认只维护原子计数器，开销与一次原子加法相当，可以在压力测试中保持开启。
+ * 需要逐条查看分配记录时：
+ *   - memcheck_set_verbose(true) 或环境变量 MEMCHECK_VERBOSE=1 恢复每次调用都打印的模式；
+ *   - memcheck_trace_start() 把分配事件写入线程本地的环形缓冲区，缓冲区满时以二进制形式
+ *     批量写入文件，用 memcheck_decode 工具解码。
+ */
+
+#define MEMCHECK_TRACE_MAGIC 0x5254434Du   // 追踪文件魔数 "MCTR"
+#define MEMCHECK_TRACE_VERSION 1u          // 追踪文件格式版本
+#define MEMCHECK_TRACE_BUFFER 4096         // 每个线程缓冲的事件数量
+#define MEMCHECK_TRACE_FILE_LEN 32         // 事件中保存的源文件名长度（保留末尾部分）
+#define MEMCHECK_MAX_SITES 512             // 最多统计的分配位置（文件:行号）数量
+#define MEMCHECK_SIZE_BINS 40              // 分配大小按 2 的幂分组的组数
+
+/* 追踪事件类型 */
+typedef enum {
+    MEMCHECK_EVENT_MALLOC = 1,
+    MEMCHECK_EVENT_CALLOC = 2,
+    MEMCHECK_EVENT_REALLOC = 3,  // ptr 为新地址，oldPtr 为原地址
+    MEMCHECK_EVENT_FREE = 4
+} MemcheckEventKind;
+
+/* 追踪文件头 */
+typedef struct {
+    uint32_t magic;         // MEMCHECK_TRACE_MAGIC
+    uint32_t version;       // MEMCHECK_TRACE_VERSION
+    uint32_t sampleEvery;   // 采样间隔，1 表示记录全部事件
+    uint32_t eventSize;     // sizeof(MemcheckTraceEvent)，用于校验
+} MemcheckTraceHeader;
+
+/* 追踪事件，按本机字节序写入文件 */
+typedef struct {
+    uint64_t timeNs;        // 事件时间（纳秒）
+    uint64_t ptr;           // 分配或释放的地址
+    uint64_t oldPtr;        // realloc 的原地址，其他事件为0
+    uint64_t size;          // 请求的字节数，free 为0
+    uint32_t thread;        // 线程编号，按线程第一次记录事件的顺序分配
+    uint32_t kind;          // MemcheckEventKind
+    uint32_t line;          // 源代码行号
+    uint32_t reserved;
+    char file[MEMCHECK_TRACE_FILE_LEN]; // 源文件名，过长时保留末尾部分
+} MemcheckTraceEvent;
+
+/* 分配位置的统计 */
+typedef struct {
+    size_t allocations;     // 分配次数
+    size_t liveBlocks;      // 未释放的块数
+    size_t liveBytes;       // 未释放的字节数
+} MemcheckSiteStats;
+
+/* 追踪文件的解码结果 */
+typedef struct {
+    uint32_t sampleEvery;   // 采样间隔
+    uint32_t threads;       // 出现过的线程数量
+    size_t events;          // 事件总数
+    size_t mallocs;         // malloc 事件数
+    size_t callocs;         // calloc 事件数
+    size_t reallocs;        // realloc 事件数（新地址的分配）
+    size_t frees;           // free 事件数（含 realloc 释放的原地址）
+    size_t liveBlocks;      // 追踪结束时仍未释放的块数
+    size_t liveBytes;       // 追踪结束时仍未释放的字节数
+} MemcheckTraceSummary;
 
 // 初始化内存检测系统
 void memcheck_init(void);
@@ -10,24 +77,130 @@ void memcheck_init(void);
 // 清理内存检测系统
 void memcheck_cleanup(void);
 
-// 分配内存并打印地址
+// 分配内存并计数
 void *memcheck_malloc(size_t size, const char *file, int line);
 
-// 重新分配内存并打印地址
+// 重新分配内存并计数
 void *memcheck_realloc(void *ptr, size_t size, const char *file, int line);
 
 // 分配内存并初始化为0
 void *memcheck_calloc(size_t nmemb, size_t size, const char *file, int line);
 
-// 释放内存并打印地址
+/**
+ * @brief 释放内存并计数
+ *
+ * ptr 必须是 NULL 或者尚未释放的 memcheck 分配块，与 memcheck_is_valid_pointer 的前提相同。
+ * 释放前校验分配头，校验失败（分配头被越界写破坏）时报错并跳过释放。
+ * 不检测重复释放：已释放块的分配头已归还系统分配器，读取它属于释放后使用，结果也不可靠。
+ *
+ * @param ptr 要释放的指针
+ * @param file 调用位置的源文件名
+ * @param line 调用位置的行号
+ */
 void memcheck_free(void *ptr, const char *file, int line);
 
 // 生成简单报告
 void memcheck_report(void);
 
-// 为保持API兼容性而保留的函数
+/**
+ * @brief 设置是否逐条打印内存操作
+ *
+ * @param verbose 为true时每次分配和释放都打印一行，默认关闭
+ */
+void memcheck_set_verbose(bool verbose);
+
+/**
+ * @brief 开始记录二进制追踪文件
+ *
+ * 按地址采样：地址的哈希值能被 sampleEvery 整除时才记录，同一块内存的分配和释放
+ * 要么都被记录要么都不记录，因此解码工具可以从采样结果中找出未释放的内存。
+ * 已经在记录时返回false。
+ *
+ * @param path 追踪文件路径
+ * @param sampleEvery 采样间隔，0 和 1 都表示记录全部事件
+ * @return 成功时返回true
+ */
+bool memcheck_trace_start(const char *path, unsigned sampleEvery);
+
+/**
+ * @brief 停止记录并把所有线程缓冲区中的事件写入文件
+ *
+ * 调用时其他线程不能再分配或释放内存。
+ */
+void memcheck_trace_stop(void);
+
+/**
+ * @brief 解码追踪文件
+ *
+ * 按文件中的顺序对每条事件调用 visitEvent，再按地址和时间配对分配与释放，
+ * 对追踪结束时仍未释放的每块内存以其分配事件调用 visitLive。解码使用的内存不经过 memcheck 计数。
+ *
+ * @param path 追踪文件路径
+ * @param summary 输出事件统计和未释放内存，不能为 NULL
+ * @param visitEvent 对每条事件调用，可以为 NULL
+ * @param visitLive 对每块未释放的内存调用，可以为 NULL
+ * @param ctx 传给 visitEvent 和 visitLive 的参数
+ * @return 文件无法读取、格式不符或内存不足时返回false
+ */
+bool memcheck_trace_decode(const char *path, MemcheckTraceSummary *summary,
+                           void (*visitEvent)(const MemcheckTraceEvent *event, void *ctx),
+                           void (*visitLive)(const MemcheckTraceEvent *event, void *ctx), void *ctx);
+
+// 获取总分配次数
+size_t memcheck_get_allocation_count(void);
+
+// 获取总释放次数
+size_t memcheck_get_free_count(void);
+
+/**
+ * @brief 获取当前占用的字节数
+ *
+ * 每块内存都带有记录大小的分配头，这里返回所有未释放块请求字节数之和（不含分配头）。
+ *
+ * @return 返回当前占用的字节数
+ */
 size_t memcheck_get_allocated_memory(void);
+
+/**
+ * @brief 获取峰值占用的字节数
+ *
+ * @return 返回程序启动或上次调用 memcheck_reset_peak 以来的最大占用字节数
+ */
+size_t memcheck_get_peak_memory(void);
+
+// 把峰值重置为当前占用，用于测量某一段代码的峰值
+void memcheck_reset_peak(void);
+
+/**
+ * @brief 判断指针是否为尚未释放的 memcheck 分配块
+ *
+ * 只读取指针前面的分配头，开销为一次内存读取，用于在调试时确认指针仍是 memcheck 分配的块起始地址。
+ * ptr 必须是 NULL 或者尚未释放的 memcheck 分配块：已释放的块其分配头已归还系统分配器，
+ * 读取它属于释放后使用，不能用来判断指针是否已经被释放。
+ *
+ * @param ptr 要检查的指针
+ * @return 是未释放的块起始地址时返回true
+ */
 bool memcheck_is_valid_pointer(void *ptr);
 
+/**
+ * @brief 查询分配位置的统计
+ *
+ * 汇总源文件名（只比较最后一个路径分隔符之后的部分）为 file 的分配位置，line 为 0 时汇总该文件的所有行。
+ *
+ * @param file 源文件名，例如 "hash_set.c"
+ * @param line 行号，为 0 时不限
+ * @param out 输出汇总结果，不能为 NULL
+ * @return 返回匹配的分配位置数量
+ */
+size_t memcheck_get_site_stats(const char *file, int line, MemcheckSiteStats *out);
+
+/**
+ * @brief 按分配位置输出统计
+ *
+ * 对每个分配位置（文件:行号）输出分配次数、未释放的块数和字节数，以及按 2 的幂分组的大小分布。
+ */
+void memcheck_report_sites(void);
+
 
 #endif // MEMCHECK_H
@@ -0,0 +1,129 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "memcheck.h"
+#include "hash_map_bytes.h"
+
+/*
+ * 内存追踪文件解码工具
+ *
+ * 用法: memcheck_decode [--events] 追踪文件
+ * 默认输出事件统计和按分配位置汇总的未释放内存；--events 额外逐条输出事件。
+ * 采样记录时，未释放内存按采样间隔放大后给出估计值。
+ */
+
+/* 按分配位置汇总的未释放内存 */
+typedef struct {
+    char site[MEMCHECK_TRACE_FILE_LEN + 16];
+    size_t count;
+    size_t bytes;
+} SiteStat;
+
+static const char *kindName(uint32_t kind) {
+    switch (kind) {
+    case MEMCHECK_EVENT_MALLOC:
+        return "malloc";
+    case MEMCHECK_EVENT_CALLOC:
+        return "calloc";
+    case MEMCHECK_EVENT_REALLOC:
+        return "realloc";
+    case MEMCHECK_EVENT_FREE:
+        return "free";
+    default:
+        return "unknown";
+    }
+}
+
+static void freeSite(void *ptr) {
+    free(ptr);
+}
+
+/* 解码时的状态 */
+typedef struct {
+    bool printEvents;       // 是否逐条输出事件
+    bool haveStart;         // 是否已经记下第一条事件的时间
+    uint64_t startNs;       // 第一条事件的时间
+    HashMapBytes *sites;    // 分配位置 -> SiteStat
+} DecodeState;
+
+// 逐条输出事件，时间相对于第一条事件
+static void printEvent(const MemcheckTraceEvent *event, void *ctx) {
+    DecodeState *state = (DecodeState *)ctx;
+    if (!state->printEvents) {
+        return;
+    }
+    if (!state->haveStart) {
+        state->startNs = event->timeNs;
+        state->haveStart = true;
+    }
+    printf("%llu t%u %-7s %#llx size=%llu %s:%u\n", (unsigned long long)(event->timeNs - state->startNs),
+           event->thread, kindName(event->kind), (unsigned long long)event->ptr,
+           (unsigned long long)event->size, event->file, event->line);
+}
+
+// 把一块未释放的内存计入它的分配位置
+static void addLive(const MemcheckTraceEvent *event, void *ctx) {
+    DecodeState *state = (DecodeState *)ctx;
+    char site[MEMCHECK_TRACE_FILE_LEN + 16];
+    int len = snprintf(site, sizeof(site), "%s:%u", event->file, event->line);
+    SiteStat *stat = (SiteStat *)bytesGet(state->sites, site, (size_t)len);
+    if (stat == NULL) {
+        stat = (SiteStat *)calloc(1, sizeof(SiteStat));
+        if (stat == NULL) {
+            return;
+        }
+        memcpy(stat->site, site, (size_t)len + 1);
+        bytesPut(state->sites, site, (size_t)len, stat);
+    }
+    stat->count++;
+    stat->bytes += (size_t)event->size;
+}
+
+int main(int argc, char *argv[]) {
+    DecodeState state = {false, false, 0, NULL};
+    const char *path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--events") == 0) {
+            state.printEvents = true;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == NULL) {
+        fprintf(stderr, "用法: %s [--events] 追踪文件\n", argv[0]);
+        return 1;
+    }
+
+    state.sites = newHashMapBytes(64, freeSite);
+    if (state.sites == NULL) {
+        fprintf(stderr, "内存不足\n");
+        return 1;
+    }
+    MemcheckTraceSummary summary;
+    if (!memcheck_trace_decode(path, &summary, printEvent, addLive, &state)) {
+        fprintf(stderr, "%s 不是可识别的追踪文件\n", path);
+        delHashMapBytes(state.sites);
+        return 1;
+    }
+
+    printf("采样间隔: 1/%u, 事件: %zu, 线程: %u\n", summary.sampleEvery, summary.events, summary.threads);
+    printf("malloc: %zu, calloc: %zu, realloc: %zu, free: %zu\n",
+           summary.mallocs, summary.callocs, summary.reallocs, summary.frees);
+
+    // 按分配位置汇总未释放的内存
+    printf("未释放: %zu 块, %zu 字节", summary.liveBlocks, summary.liveBytes);
+    if (summary.sampleEvery > 1) {
+        printf("（估计全部: %zu 块, %zu 字节）", summary.liveBlocks * summary.sampleEvery,
+               summary.liveBytes * summary.sampleEvery);
+    }
+    printf("\n");
+    HashMapBytesIterator it = bytesInitIterator(state.sites);
+    while (bytesHasNext(&it)) {
+        const SiteStat *stat = (const SiteStat *)bytesGetValue(&it);
+        printf("  %-40s %8zu 块 %12zu 字节\n", stat->site, stat->count, stat->bytes);
+        bytesNext(&it);
+    }
+
+    delHashMapBytes(state.sites);
+    return 0;
+}
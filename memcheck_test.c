@@ -1,6 +1,16 @@
 #include <stdio.h>
 #include "memcheck.h"
 #include "utility.h"
+#include "hash_table.h"
+#include "hash_map_flat.h"
+#include "hash_map_robin.h"
+#include "hash_map_cuckoo.h"
+#include "hash_set.h"
+#include "hash_map_bytes.h"
+
+#define FOOTPRINT_KEYS 100000
+#define TRACE_BLOCKS 256     // 采样追踪测试分配的块数
+#define TRACE_KEPT 64        // 其中停止追踪时仍未释放的块数
 // 故意泄漏内存的函数
 void leak_memory(void) {
     int *ptr = malloc(sizeof(int) * 10);
@@ -57,6 +67,161 @@ void memory_out_of_bounds(void) {
     }
 }
 
+// 记录二进制追踪文件并解码，之后也可以用 memcheck_decode memcheck_trace.bin 查看
+bool trace_allocations(void) {
+    MemcheckTraceSummary summary;
+    if (!memcheck_trace_start("memcheck_trace.bin", 1)) {
+        printf("无法创建追踪文件\n");
+        return false;
+    }
+    void *blocks[TRACE_BLOCKS];
+    for (int i = 0; i < 8; i++) {
+        blocks[i] = malloc((size_t)16 << i);
+    }
+    for (int i = 0; i < 8; i++) {
+        free(blocks[i]);
+    }
+    memcheck_trace_stop();
+    bool ok = memcheck_trace_decode("memcheck_trace.bin", &summary, NULL, NULL, NULL) &&
+              summary.sampleEvery == 1 && summary.mallocs == 8 && summary.frees == 8 &&
+              summary.liveBlocks == 0 && summary.liveBytes == 0;
+    printf("全部记录: malloc %zu 次, free %zu 次, 未释放 %zu 块\n", summary.mallocs, summary.frees, summary.liveBlocks);
+
+    // 按地址 1/4 采样：同一块内存的分配和释放同时被记录或同时被跳过；
+    // 停止追踪前只释放一部分，未释放的块必须恰好是被记录了分配而没有记录释放的那些
+    if (!memcheck_trace_start("memcheck_trace.bin", 4)) {
+        printf("无法创建追踪文件\n");
+        return false;
+    }
+    for (int i = 0; i < TRACE_BLOCKS; i++) {
+        blocks[i] = malloc(32);
+    }
+    for (int i = 0; i < TRACE_BLOCKS - TRACE_KEPT; i++) {
+        free(blocks[i]);
+    }
+    memcheck_trace_stop();
+    for (int i = TRACE_BLOCKS - TRACE_KEPT; i < TRACE_BLOCKS; i++) {
+        free(blocks[i]);
+    }
+    ok = memcheck_trace_decode("memcheck_trace.bin", &summary, NULL, NULL, NULL) && ok &&
+         summary.sampleEvery == 4 && summary.mallocs > 0 && summary.mallocs < TRACE_BLOCKS &&
+         summary.frees <= summary.mallocs && summary.liveBlocks == summary.mallocs - summary.frees &&
+         summary.liveBlocks <= TRACE_KEPT && summary.liveBytes == summary.liveBlocks * 32;
+    printf("1/4 采样: malloc %zu 次, free %zu 次, 未释放 %zu 块（停止追踪时有 %d 块未释放）\n",
+           summary.mallocs, summary.frees, summary.liveBlocks, TRACE_KEPT);
+    return ok;
+}
+
+/*
+ * 写入后检查占用：占用和峰值都统计到了，峰值不小于当前占用，实现所在的源文件中有未释放的分配位置。
+ * 打印并返回每个键值对的字节数
+ */
+static bool footprint_filled(const char *name, const char *file, size_t before, double *perEntry) {
+    size_t live = memcheck_get_allocated_memory();
+    size_t peak = memcheck_get_peak_memory();
+    MemcheckSiteStats site;
+    bool ok = memcheck_get_site_stats(file, 0, &site) > 0 && site.allocations > 0 && site.liveBlocks > 0 &&
+              live > before && peak >= live;
+    *perEntry = (double)(live - before) / FOOTPRINT_KEYS;
+    printf("%-16s 每个键值对 %.1f 字节，峰值 %.1f 字节，%s 中未释放 %zu 块\n", name, *perEntry,
+           (double)(peak - before) / FOOTPRINT_KEYS, file, site.liveBlocks);
+    return ok;
+}
+
+// 删除后检查占用回到写入前，实现所在的源文件中没有未释放的块
+static bool footprint_released(const char *name, const char *file, size_t before) {
+    MemcheckSiteStats site;
+    memcheck_get_site_stats(file, 0, &site);
+    bool ok = memcheck_get_allocated_memory() == before && site.liveBlocks == 0 && site.liveBytes == 0;
+    if (!ok) {
+        printf("%s 删除后仍占用 %zu 字节，%s 中未释放 %zu 块\n", name,
+               memcheck_get_allocated_memory() - before, file, site.liveBlocks);
+    }
+    return ok;
+}
+
+// 用当前占用字节数的差值比较各哈希表每个键值对的内存开销
+bool measure_footprint(void) {
+    static int value = 1;
+    double chainingBytes = 0, setBytes = 0, perEntry = 0;
+
+    size_t before = memcheck_get_allocated_memory();
+    memcheck_reset_peak();
+    HashMapChaining *chaining = newHashMapChaining(16, NULL);
+    for (int key = 0; key < FOOTPRINT_KEYS; key++) {
+        put(chaining, key, &value);
+    }
+    // 节点从 node_pool.c 的内存块中分配
+    MemcheckSiteStats nodeSites;
+    bool ok = footprint_filled("HashMapChaining:", "hash_table.c", before, &chainingBytes) &&
+              memcheck_get_site_stats("node_pool.c", 0, &nodeSites) > 0 && nodeSites.liveBlocks > 0;
+    delHashMapChaining(chaining);
+    ok = footprint_released("HashMapChaining", "hash_table.c", before) &&
+         footprint_released("HashMapChaining", "node_pool.c", before) && ok;
+
+    before = memcheck_get_allocated_memory();
+    memcheck_reset_peak();
+    HashMapFlat *flat = newHashMapFlat(16, NULL);
+    for (int key = 0; key < FOOTPRINT_KEYS; key++) {
+        flatPut(flat, key, &value);
+    }
+    ok = footprint_filled("HashMapFlat:", "hash_map_flat.c", before, &perEntry) && ok;
+    delHashMapFlat(flat);
+    ok = footprint_released("HashMapFlat", "hash_map_flat.c", before) && ok;
+
+    before = memcheck_get_allocated_memory();
+    memcheck_reset_peak();
+    HashMapRobin *robin = newHashMapRobin(16, NULL);
+    for (int key = 0; key < FOOTPRINT_KEYS; key++) {
+        robinPut(robin, key, &value);
+    }
+    ok = footprint_filled("HashMapRobin:", "hash_map_robin.c", before, &perEntry) && ok;
+    delHashMapRobin(robin);
+    ok = footprint_released("HashMapRobin", "hash_map_robin.c", before) && ok;
+
+    before = memcheck_get_allocated_memory();
+    memcheck_reset_peak();
+    HashMapCuckoo *cuckoo = newHashMapCuckoo(16, NULL);
+    for (int key = 0; key < FOOTPRINT_KEYS; key++) {
+        cuckooPut(cuckoo, key, &value);
+    }
+    ok = footprint_filled("HashMapCuckoo:", "hash_map_cuckoo.c", before, &perEntry) && ok;
+    delHashMapCuckoo(cuckoo);
+    ok = footprint_released("HashMapCuckoo", "hash_map_cuckoo.c", before) && ok;
+
+    before = memcheck_get_allocated_memory();
+    memcheck_reset_peak();
+    HashMapBytes *bytes = newHashMapBytes(16, NULL);
+    for (int key = 0; key < FOOTPRINT_KEYS; key++) {
+        bytesPut(bytes, &key, sizeof(key), &value);
+    }
+    ok = footprint_filled("HashMapBytes:", "hash_map_bytes.c", before, &perEntry) && ok;
+    delHashMapBytes(bytes);
+    ok = footprint_released("HashMapBytes", "hash_map_bytes.c", before) && ok;
+
+    before = memcheck_get_allocated_memory();
+    memcheck_reset_peak();
+    HashSet *set = newHashSet(16);
+    for (int key = 0; key < FOOTPRINT_KEYS; key++) {
+        setInsert(set, key);
+    }
+    ok = footprint_filled("HashSet:", "hash_set.c", before, &setBytes) && ok;
+    delHashSet(set);
+    ok = footprint_released("HashSet", "hash_set.c", before) && ok;
+
+    // 只存放键的集合每个键的开销不超过链式哈希表每个键值对的一半
+    ok = ok && setBytes * 2 <= chainingBytes;
+    printf("HashSet 与 HashMapChaining 每个元素的字节数之比: %.2f\n", setBytes / chainingBytes);
+
+    // 分配头让有效性检查只需读一次内存；只能检查尚未释放的块
+    int *ptr = malloc(sizeof(int));
+    ok = ok && memcheck_is_valid_pointer(ptr) && !memcheck_is_valid_pointer(NULL);
+    printf("指针有效: %s, NULL 有效: %s\n", memcheck_is_valid_pointer(ptr) ? "是" : "否",
+           memcheck_is_valid_pointer(NULL) ? "是" : "否");
+    free(ptr);
+    return ok;
+}
+
 int main(void) {
     // 初始化内存检测系统
     memcheck_init();
@@ -73,15 +238,25 @@ int main(void) {
     printf("\n=== 测试4: 使用未初始化内存 ===\n");
     use_uninitialized_memory();
     
-    printf("\n=== 测试5: 内存越界访问 ===\n");
+    printf("\n=== 测试5: 二进制追踪 ===\n");
+    bool ok = trace_allocations();
+
+    printf("\n=== 测试6: 内存占用与分配位置统计 ===\n");
+    ok = measure_footprint() && ok;
+    memcheck_report_sites();
+
+    // 越界写在开启 AddressSanitizer 的 Debug 构建中会中止程序，放在有检查的测试之后，先输出已有结果
+    printf("\n=== 测试7: 内存越界访问 ===\n");
+    fflush(stdout);
     memory_out_of_bounds();
-    
+
     // 生成内存泄漏报告
     printf("\n=== 生成内存泄漏报告 ===\n");
     memcheck_report();
     
     // 清理内存检测系统
     memcheck_cleanup();
-    
-    return 0;
+
+    printf("%s\n", ok ? "所有测试通过" : "测试失败");
+    return ok ? 0 : 1;
 }
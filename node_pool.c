@@ -0,0 +1,119 @@
+#include <stdint.h>
+#include "node_pool.h"
+#include "utility.h"
+
+/* slab 头部占用的空间，向上取整为缓存行大小，保证第一个节点也按缓存行对齐 */
+#define SLAB_HEADER_SIZE \
+    ((sizeof(NodePoolSlab) + NODE_POOL_CACHE_LINE - 1) / NODE_POOL_CACHE_LINE * NODE_POOL_CACHE_LINE)
+
+/* 初始化节点内存池 */
+void nodePoolInit(NodePool *pool, size_t nodeSize) {
+    if (nodeSize < sizeof(void *)) {
+        nodeSize = sizeof(void *);
+    }
+    pool->nodeSize = (nodeSize + sizeof(void *) - 1) / sizeof(void *) * sizeof(void *);
+    pool->nextSlabNodes = NODE_POOL_MIN_SLAB_NODES;
+    pool->freeList = NULL;
+    pool->bumpCur = NULL;
+    pool->bumpEnd = NULL;
+    pool->slabs = NULL;
+}
+
+/* 释放内存池的所有 slab */
+void nodePoolDestroy(NodePool *pool) {
+    NodePoolSlab *slab = pool->slabs;
+    while (slab) {
+        NodePoolSlab *next = slab->next;
+        free(slab->raw);
+        slab = next;
+    }
+    pool->freeList = NULL;
+    pool->bumpCur = NULL;
+    pool->bumpEnd = NULL;
+    pool->slabs = NULL;
+    pool->nextSlabNodes = NODE_POOL_MIN_SLAB_NODES;
+}
+
+/* 分配一个新的 slab 作为切分区域 */
+static bool addSlab(NodePool *pool) {
+    size_t nodeCount = pool->nextSlabNodes;
+    size_t bytes = SLAB_HEADER_SIZE + nodeCount * pool->nodeSize;
+    char *raw = (char *)malloc(bytes + NODE_POOL_CACHE_LINE - 1);
+    if (raw == NULL) {
+        return false;
+    }
+
+    // 将 slab 起始地址对齐到缓存行
+    uintptr_t aligned = ((uintptr_t)raw + NODE_POOL_CACHE_LINE - 1) & ~(uintptr_t)(NODE_POOL_CACHE_LINE - 1);
+    char *base = raw + (aligned - (uintptr_t)raw);
+    NodePoolSlab *slab = (NodePoolSlab *)(void *)base;
+    slab->raw = raw;
+    slab->nodeCount = nodeCount;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+
+    pool->bumpCur = base + SLAB_HEADER_SIZE;
+    pool->bumpEnd = base + bytes;
+    if (pool->nextSlabNodes < NODE_POOL_MAX_SLAB_NODES) {
+        pool->nextSlabNodes *= 2;
+    }
+    return true;
+}
+
+/* 从内存池分配一个节点 */
+void *nodePoolAlloc(NodePool *pool) {
+    // 优先复用空闲链表中的节点
+    if (pool->freeList != NULL) {
+        void *node = pool->freeList;
+        pool->freeList = *(void **)node;
+        return node;
+    }
+
+    // 其次从当前 slab 的未切分区域中切分
+    if (pool->bumpCur == pool->bumpEnd && !addSlab(pool)) {
+        return NULL;
+    }
+    void *node = pool->bumpCur;
+    pool->bumpCur += pool->nodeSize;
+    return node;
+}
+
+/* 将节点归还内存池 */
+void nodePoolFree(NodePool *pool, void *node) {
+    if (node == NULL) {
+        return;
+    }
+    *(void **)node = pool->freeList;
+    pool->freeList = node;
+}
+
+/* 接管另一个内存池的全部 slab */
+void nodePoolAdopt(NodePool *pool, NodePool *other) {
+    if (pool == other || other->slabs == NULL) {
+        return;
+    }
+
+    // 未切分区域逐个节点挂到空闲链表，不浪费 slab 末尾的空间
+    for (char *node = other->bumpCur; node != NULL && node < other->bumpEnd; node += other->nodeSize) {
+        nodePoolFree(other, node);
+    }
+    if (other->freeList != NULL) {
+        void *tail = other->freeList;
+        while (*(void **)tail != NULL) {
+            tail = *(void **)tail;
+        }
+        *(void **)tail = pool->freeList;
+        pool->freeList = other->freeList;
+    }
+
+    NodePoolSlab *last = other->slabs;
+    while (last->next != NULL) {
+        last = last->next;
+    }
+    last->next = pool->slabs;
+    pool->slabs = other->slabs;
+    if (other->nextSlabNodes > pool->nextSlabNodes) {
+        pool->nextSlabNodes = other->nextSlabNodes;
+    }
+    nodePoolInit(other, other->nodeSize);
+}
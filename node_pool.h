@@ -0,0 +1,80 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define NODE_POOL_CACHE_LINE 64          // 缓存行大小，slab 按此对齐
+#define NODE_POOL_MIN_SLAB_NODES 32      // 第一个 slab 的节点数量
+#define NODE_POOL_MAX_SLAB_NODES 4096    // 单个 slab 的最大节点数量
+
+/* slab 头部，位于每个 slab 的起始位置 */
+typedef struct NodePoolSlab {
+    struct NodePoolSlab *next;  // 下一个 slab
+    void *raw;                  // malloc 返回的原始地址，用于释放
+    size_t nodeCount;           // 本 slab 可容纳的节点数量
+} NodePoolSlab;
+
+/*
+ * 定长节点内存池
+ *
+ * 节点从按缓存行对齐的 slab 中切分，释放的节点挂到侵入式空闲链表上，
+ * 稳定状态下分配和释放都不会调用系统分配器。内存池不是线程安全的。
+ */
+typedef struct {
+    size_t nodeSize;        // 节点大小（已按指针大小对齐）
+    size_t nextSlabNodes;   // 下一个 slab 的节点数量，逐次翻倍直到上限
+    void *freeList;         // 空闲节点链表，节点的前 sizeof(void*) 字节存放下一个空闲节点
+    char *bumpCur;          // 当前 slab 中尚未切分区域的起始地址
+    char *bumpEnd;          // 当前 slab 的结束地址
+    NodePoolSlab *slabs;    // 所有 slab 组成的链表
+} NodePool;
+
+/**
+ * @brief 初始化节点内存池
+ *
+ * 初始化时不分配内存，第一次分配节点时才创建 slab。
+ *
+ * @param pool 内存池指针
+ * @param nodeSize 节点大小，会向上取整为指针大小的倍数
+ */
+void nodePoolInit(NodePool *pool, size_t nodeSize);
+
+/**
+ * @brief 释放内存池的所有 slab
+ *
+ * 所有从该内存池分配的节点随之失效，不需要逐个释放。
+ *
+ * @param pool 内存池指针
+ */
+void nodePoolDestroy(NodePool *pool);
+
+/**
+ * @brief 从内存池分配一个节点
+ *
+ * @param pool 内存池指针
+ * @return 成功时返回节点指针（内容未初始化），失败时返回 NULL
+ */
+void *nodePoolAlloc(NodePool *pool);
+
+/**
+ * @brief 将节点归还内存池
+ *
+ * @param pool 内存池指针
+ * @param node 由同一内存池分配的节点指针
+ */
+void nodePoolFree(NodePool *pool, void *node);
+
+/**
+ * @brief 接管另一个内存池的全部 slab
+ *
+ * other 分配出去的节点从此归 pool 所有，可以用 nodePoolFree 归还给 pool，随 pool 一起释放。
+ * other 的空闲节点和未切分区域并入 pool 的空闲链表，other 重新变为空的内存池。
+ * 两个内存池的节点大小必须相同。
+ *
+ * @param pool 接管方内存池指针
+ * @param other 被接管的内存池指针
+ */
+void nodePoolAdopt(NodePool *pool, NodePool *other);
+
+#endif // NODE_POOL_H
@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "hash_map_ordered.h"
+#include "utility.h"
+
+#define TEST_KEYS 2000
+
+// 释放整数指针的回调函数
+void freeIntPtr(void *ptr) {
+    free(ptr);
+}
+
+// 创建整数指针
+int *createIntPtr(int value) {
+    int *ptr = (int *)malloc(sizeof(int));
+    if (ptr != NULL) {
+        *ptr = value;
+    }
+    return ptr;
+}
+
+// 插入第 i 个键，键的顺序与大小无关，用于验证遍历按插入顺序进行
+static int keyAt(int i) {
+    return (int)((unsigned)i * 7919u % 100003u) - 50000;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    HashMapOrdered *hashMap = newHashMapOrdered(4, freeIntPtr);
+    if (hashMap == NULL) {
+        printf("创建哈希表失败\n");
+        return 1;
+    }
+
+    // 插入足够多的键以触发多次扩容
+    printf("添加键值对到哈希表...\n");
+    for (int i = 0; i < TEST_KEYS; i++) {
+        orderedPut(hashMap, keyAt(i), createIntPtr(i));
+    }
+    // 更新已有键的值不改变顺序
+    int *old = (int *)orderedGet(hashMap, keyAt(0));
+    orderedPut(hashMap, keyAt(0), createIntPtr(0));
+    free(old);
+    printf("键值对数量: %zu, 已用条目: %zu\n", orderedSize(hashMap), orderedUsed(hashMap));
+
+    // 遍历顺序与插入顺序一致
+    int expected = 0;
+    HashMapOrderedIterator iterator = orderedInitIterator(hashMap);
+    while (orderedHasNext(&iterator)) {
+        int *value = (int *)orderedGetValue(&iterator);
+        if (orderedGetKey(&iterator) != keyAt(expected) || *value != expected) {
+            printf("遍历顺序错误: 第 %d 个\n", expected);
+            delHashMapOrdered(hashMap);
+            return 1;
+        }
+        expected++;
+        orderedNext(&iterator);
+    }
+    printf("按插入顺序遍历 %d 个键值对\n", expected);
+
+    // 删除所有序号为奇数的键，条目数组中留下墓碑
+    for (int i = 1; i < TEST_KEYS; i += 2) {
+        orderedRemoveItem(hashMap, keyAt(i));
+    }
+    printf("删除一半键后数量: %zu, 已用条目: %zu\n", orderedSize(hashMap), orderedUsed(hashMap));
+
+    // 遍历中删除序号为 4 的倍数的键，期间会触发压缩，遍历顺序保持不变
+    int visited = 0;
+    expected = 0;
+    iterator = orderedInitIterator(hashMap);
+    while (orderedHasNext(&iterator)) {
+        int *value = (int *)orderedGetValue(&iterator);
+        if (orderedGetKey(&iterator) != keyAt(expected) || *value != expected) {
+            printf("遍历中删除后顺序错误: 第 %d 个\n", expected);
+            delHashMapOrdered(hashMap);
+            return 1;
+        }
+        visited++;
+        expected += 2;
+        if (*value % 4 == 0) {
+            orderedRemoveCurrent(&iterator);
+        } else {
+            orderedNext(&iterator);
+        }
+    }
+    printf("遍历访问 %d 个, 删除后数量: %zu, 已用条目: %zu\n", visited, orderedSize(hashMap), orderedUsed(hashMap));
+    if (visited != TEST_KEYS / 2 || orderedSize(hashMap) != TEST_KEYS / 4 || orderedUsed(hashMap) >= (size_t)TEST_KEYS) {
+        printf("删除结果错误\n");
+        delHashMapOrdered(hashMap);
+        return 1;
+    }
+
+    // 压缩后查找结果不变，被删除的键可以重新插入到末尾
+    orderedCompact(hashMap);
+    for (int i = 0; i < TEST_KEYS; i++) {
+        int *value = (int *)orderedGet(hashMap, keyAt(i));
+        bool present = i % 4 == 2;
+        if ((value != NULL) != present || (present && *value != i)) {
+            printf("查找键 %d 失败\n", keyAt(i));
+            delHashMapOrdered(hashMap);
+            return 1;
+        }
+    }
+    orderedPut(hashMap, keyAt(0), createIntPtr(-1));
+    iterator = orderedInitIterator(hashMap);
+    int last = 0;
+    while (orderedHasNext(&iterator)) {
+        last = orderedGetKey(&iterator);
+        orderedNext(&iterator);
+    }
+    printf("压缩后已用条目: %zu, 重新插入的键位于末尾: %s\n", orderedUsed(hashMap), last == keyAt(0) ? "是" : "否");
+
+    bool ok = last == keyAt(0) && orderedUsed(hashMap) == orderedSize(hashMap);
+    delHashMapOrdered(hashMap);
+
+    // 内存检测报告
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,227 @@
+#include <stdio.h>
+#include <stdatomic.h>
+#include "hash_table.h"
+#include "thread_pool.h"
+#include "utility.h"
+
+#define TEST_KEYS 300000
+#define TEST_THREADS 4
+
+static int testValue = 1;  // 所有键共用的非NULL值
+
+/* 记录每个下标被处理的次数，验证线程池不遗漏也不重复 */
+typedef struct {
+    atomic_uchar *visits;
+} VisitTask;
+
+static void visitRange(size_t begin, size_t end, size_t worker, void *ctx) {
+    (void)worker;
+    VisitTask *task = (VisitTask *)ctx;
+    for (size_t i = begin; i < end; i++) {
+        atomic_fetch_add(&task->visits[i], 1);
+        // 前 1% 的下标工作量大得多，验证窃取后仍然全部完成
+        for (volatile size_t spin = 0; i < 1000 && spin < 2000; spin++) {
+        }
+    }
+}
+
+static bool testThreadPool(void) {
+    printf("\n=== 测试1: 线程池并行处理 ===\n");
+    ThreadPool *pool = newThreadPool(TEST_THREADS);
+    if (pool == NULL) {
+        return false;
+    }
+    size_t count = 100000;
+    atomic_uchar *visits = (atomic_uchar *)calloc(count, sizeof(atomic_uchar));
+    if (visits == NULL) {
+        delThreadPool(pool);
+        return false;
+    }
+
+    bool ok = true;
+    // 同一线程池连续执行多个任务
+    for (int round = 0; round < 3 && ok; round++) {
+        VisitTask task;
+        task.visits = visits;
+        threadPoolParallelFor(pool, count, 64, visitRange, &task);
+        for (size_t i = 0; i < count; i++) {
+            if (atomic_load(&visits[i]) != round + 1) {
+                printf("第 %d 轮下标 %zu 被处理了 %u 次\n", round, i, (unsigned)atomic_load(&visits[i]));
+                ok = false;
+                break;
+            }
+        }
+    }
+    printf("线程数: %zu，%s\n", threadPoolSize(pool), ok ? "每个下标恰好处理一次" : "结果错误");
+
+    free(visits);
+    delThreadPool(pool);
+    return ok;
+}
+
+// 按迭代顺序比较两个哈希表，顺序相同说明每个桶中的链表完全一致
+static bool sameLayout(HashMapChaining *a, HashMapChaining *b) {
+    HashMapIterator ia = initIterator(a);
+    HashMapIterator ib = initIterator(b);
+    while (hasNext(&ia) && hasNext(&ib)) {
+        if (getKey(&ia) != getKey(&ib)) {
+            return false;
+        }
+        next(&ia);
+        next(&ib);
+    }
+    return !hasNext(&ia) && !hasNext(&ib);
+}
+
+static HashMapChaining *newTestMap(size_t threads) {
+    HashMapChainingConfig config = defaultHashMapConfig(1024, NULL);
+    config.pow2Capacity = true;
+    config.hashSeed = 12345;
+    config.rehashThreads = threads;
+    return newHashMapChainingWithConfig(&config);
+}
+
+// 多线程扩容与单线程扩容得到完全相同的桶布局
+static bool testParallelRehash(void) {
+    printf("\n=== 测试2: 多线程扩容 ===\n");
+    HashMapChaining *serial = newTestMap(0);
+    HashMapChaining *parallel = newTestMap(TEST_THREADS);
+    if (serial == NULL || parallel == NULL) {
+        delHashMapChaining(serial);
+        delHashMapChaining(parallel);
+        return false;
+    }
+
+    for (int key = 0; key < TEST_KEYS; key++) {
+        put(serial, key * 7, &testValue);
+        put(parallel, key * 7, &testValue);
+    }
+    bool ok = size(parallel) == TEST_KEYS && sameLayout(serial, parallel);
+    printf("自动扩容后键值对数量: %zu，布局%s\n", size(parallel), ok ? "一致" : "不一致");
+
+    // reserve 一次扩大 8 倍，每个新桶仍然只来自一个旧桶
+    reserve(serial, (size_t)TEST_KEYS * 8);
+    reserve(parallel, (size_t)TEST_KEYS * 8);
+    bool reserved = sameLayout(serial, parallel);
+    printf("reserve 扩大 8 倍后布局%s\n", reserved ? "一致" : "不一致");
+    ok = ok && reserved;
+
+    for (int key = 0; key < TEST_KEYS && ok; key++) {
+        if (get(parallel, key * 7) != &testValue) {
+            printf("查找键 %d 失败\n", key * 7);
+            ok = false;
+        }
+    }
+    delHashMapChaining(serial);
+    delHashMapChaining(parallel);
+    return ok;
+}
+
+/* 归约结果：键值对数量、键之和与最大键 */
+typedef struct {
+    size_t count;
+    long long keySum;
+    int maxKey;
+} KeySummary;
+
+static void accumulateKey(void *acc, int key, void *val, void *ctx) {
+    (void)val;
+    (void)ctx;
+    KeySummary *summary = (KeySummary *)acc;
+    summary->count++;
+    summary->keySum += key;
+    if (key > summary->maxKey) {
+        summary->maxKey = key;
+    }
+}
+
+static void combineSummary(void *acc, const void *other, void *ctx) {
+    (void)ctx;
+    KeySummary *summary = (KeySummary *)acc;
+    const KeySummary *part = (const KeySummary *)other;
+    summary->count += part->count;
+    summary->keySum += part->keySum;
+    if (part->maxKey > summary->maxKey) {
+        summary->maxKey = part->maxKey;
+    }
+}
+
+static void countVisit(int key, void *val, void *ctx) {
+    (void)key;
+    if (val == &testValue) {
+        atomic_fetch_add((atomic_size_t *)ctx, 1);
+    }
+}
+
+// 并行遍历和归约与顺序遍历的结果相同，渐进式扩容进行中也不遗漏旧桶中的键
+static bool testParallelScan(bool incremental) {
+    printf("\n=== 测试3: 并行遍历与归约（渐进式扩容: %s） ===\n", incremental ? "是" : "否");
+    HashMapChainingConfig config = defaultHashMapConfig(64, NULL);
+    config.pow2Capacity = true;
+    config.incrementalRehash = incremental;
+    HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+    if (hashMap == NULL) {
+        return false;
+    }
+    // 渐进式扩容时刚越过扩容阈值就停止插入，旧桶数组中还留有大部分键
+    int keys = incremental ? 196608 + 100 : TEST_KEYS;
+    for (int key = 0; key < keys; key++) {
+        put(hashMap, key, &testValue);
+    }
+
+    KeySummary expected = {0, 0, -1};
+    for (HashMapIterator it = initIterator(hashMap); hasNext(&it); next(&it)) {
+        accumulateKey(&expected, getKey(&it), getValue(&it), NULL);
+    }
+
+    bool ok = expected.count == (size_t)keys;
+    for (size_t threads = 1; threads <= 8 && ok; threads *= 2) {
+        atomic_size_t visited;
+        atomic_init(&visited, 0);
+        hashMapForEachParallel(hashMap, countVisit, &visited, threads);
+
+        KeySummary summary = {0, 0, -1};
+        ok = hashMapReduceParallel(hashMap, &summary, sizeof(summary), accumulateKey, combineSummary, NULL, threads);
+        ok = ok && atomic_load(&visited) == expected.count && summary.count == expected.count &&
+             summary.keySum == expected.keySum && summary.maxKey == expected.maxKey;
+        printf("线程数 %zu: 遍历 %zu 个，归约 %zu 个，键之和 %lld，最大键 %d\n", threads,
+               atomic_load(&visited), summary.count, summary.keySum, summary.maxKey);
+    }
+
+    // 同一个线程池反复遍历，每轮之间继续插入，渐进式扩容时旧桶数组的迁移位置不在块边界上
+    ThreadPool *pool = newThreadPool(TEST_THREADS);
+    for (int round = 0; round < 3 && ok; round++) {
+        for (int i = 0; i < 37; i++, keys++) {
+            put(hashMap, keys, &testValue);
+            accumulateKey(&expected, keys, &testValue, NULL);
+        }
+        atomic_size_t visited;
+        atomic_init(&visited, 0);
+        hashMapForEachParallelPool(hashMap, countVisit, &visited, pool);
+
+        KeySummary summary = {0, 0, -1};
+        ok = hashMapReduceParallelPool(hashMap, &summary, sizeof(summary), accumulateKey, combineSummary, NULL, pool);
+        ok = ok && atomic_load(&visited) == expected.count && summary.count == expected.count &&
+             summary.keySum == expected.keySum && summary.maxKey == expected.maxKey;
+    }
+    printf("复用线程池 %zu 个线程遍历 3 轮: %s\n", threadPoolSize(pool), ok ? "结果正确" : "结果错误");
+    delThreadPool(pool);
+    delHashMapChaining(hashMap);
+    return ok;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    bool ok = testThreadPool();
+    ok = testParallelRehash() && ok;
+    ok = testParallelScan(false) && ok;
+    ok = testParallelScan(true) && ok;
+    printf("\n%s\n", ok ? "所有测试通过" : "测试失败");
+
+    // 报告内存使用情况
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include "hash_table.h"
+#include "utility.h"
+
+#define TEST_KEYS 100000
+
+static int testValue = 1;  // 所有键共用的非NULL值
+
+// 获取桶数量
+static size_t bucketCount(HashMapChaining *hashMap) {
+    HashMapStats stats;
+    hashMapStats(hashMap, &stats);
+    return stats.capacity;
+}
+
+// 遍历哈希表，返回键值对数量
+static size_t countByIterator(HashMapChaining *hashMap) {
+    size_t count = 0;
+    HashMapIterator it = initIterator(hashMap);
+    while (hasNext(&it)) {
+        count++;
+        next(&it);
+    }
+    return count;
+}
+
+// 检查键 [begin, end) 都能找到
+static bool checkKeys(HashMapChaining *hashMap, int begin, int end) {
+    for (int key = begin; key < end; key++) {
+        if (get(hashMap, key) != &testValue) {
+            printf("查找键 %d 失败\n", key);
+            return false;
+        }
+    }
+    return true;
+}
+
+// reserve 之后插入不再扩容，shrinkToFit 把桶数组缩小到刚好容纳剩余的键
+static bool testReserveAndShrink(void) {
+    printf("\n=== 测试1: reserve 和 shrinkToFit ===\n");
+    HashMapChaining *hashMap = newHashMapChaining(16, NULL);
+    if (hashMap == NULL) {
+        return false;
+    }
+
+    reserve(hashMap, TEST_KEYS);
+    size_t reserved = bucketCount(hashMap);
+    for (int key = 0; key < TEST_KEYS; key++) {
+        put(hashMap, key, &testValue);
+    }
+    printf("预留 %d 个键后的桶数量: %zu，插入后: %zu\n", TEST_KEYS, reserved, bucketCount(hashMap));
+    bool ok = reserved == bucketCount(hashMap);
+
+    for (int key = 100; key < TEST_KEYS; key++) {
+        removeItem(hashMap, key);
+    }
+    printf("删除到剩余 %zu 个键后的桶数量: %zu\n", size(hashMap), bucketCount(hashMap));
+    shrinkToFit(hashMap);
+    printf("shrinkToFit 之后的桶数量: %zu\n", bucketCount(hashMap));
+    ok = ok && bucketCount(hashMap) < 200 && (double)size(hashMap) / (double)bucketCount(hashMap) <= HASH_TABLE_LOAD_FACTOR &&
+         checkKeys(hashMap, 0, 100) && countByIterator(hashMap) == 100;
+
+    // 缩小后仍然可以正常扩容
+    for (int key = 100; key < 1000; key++) {
+        put(hashMap, key, &testValue);
+    }
+    ok = ok && checkKeys(hashMap, 0, 1000) && size(hashMap) == 1000;
+    delHashMapChaining(hashMap);
+    return ok;
+}
+
+// 开启自动缩容后，大量删除会缩小桶数组，在阈值附近插入删除不会反复扩容缩容
+static bool testAutoShrink(bool pow2, bool incremental) {
+    printf("\n=== 测试2: 自动缩容（2 的幂容量: %s，渐进式扩容: %s） ===\n", pow2 ? "是" : "否", incremental ? "是" : "否");
+    HashMapChainingConfig config = defaultHashMapConfig(64, NULL);
+    config.pow2Capacity = pow2;
+    config.incrementalRehash = incremental;
+    config.autoShrink = true;
+    HashMapChaining *hashMap = newHashMapChainingWithConfig(&config);
+    if (hashMap == NULL) {
+        return false;
+    }
+
+    for (int key = 0; key < TEST_KEYS; key++) {
+        put(hashMap, key, &testValue);
+    }
+    size_t grown = bucketCount(hashMap);
+    for (int key = 1000; key < TEST_KEYS; key++) {
+        removeItem(hashMap, key);
+    }
+    size_t shrunk = bucketCount(hashMap);
+    printf("插入 %d 个键后的桶数量: %zu，删除到 %zu 个键后: %zu\n", TEST_KEYS, grown, size(hashMap), shrunk);
+    bool ok = shrunk < grown / 16 && checkKeys(hashMap, 0, 1000) && countByIterator(hashMap) == 1000;
+
+    // 在缩容阈值附近来回插入删除，桶数量保持不变
+    for (int round = 0; round < 100; round++) {
+        for (int key = 1000; key < 1100; key++) {
+            put(hashMap, key, &testValue);
+        }
+        for (int key = 1000; key < 1100; key++) {
+            removeItem(hashMap, key);
+        }
+        if (bucketCount(hashMap) != shrunk) {
+            printf("第 %d 轮桶数量变为 %zu\n", round, bucketCount(hashMap));
+            ok = false;
+            break;
+        }
+    }
+
+    // 全部删除后不会缩到创建时的容量以下
+    for (int key = 0; key < 1000; key++) {
+        removeItem(hashMap, key);
+    }
+    printf("全部删除后的桶数量: %zu\n", bucketCount(hashMap));
+    ok = ok && bucketCount(hashMap) >= 64 && isEmpty(hashMap);
+    delHashMapChaining(hashMap);
+    return ok;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    bool ok = testReserveAndShrink();
+    ok = testAutoShrink(false, false) && ok;
+    ok = testAutoShrink(true, false) && ok;
+    ok = testAutoShrink(true, true) && ok;
+    printf("\n%s\n", ok ? "所有测试通过" : "测试失败");
+
+    // 报告内存使用情况
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "hash_map_robin.h"
+#include "utility.h"
+
+#define LOAD_TEST_SLOTS 65536
+
+// 释放整数指针的回调函数
+void freeIntPtr(void *ptr) {
+    free(ptr);
+}
+
+// 创建整数指针
+int *createIntPtr(int value) {
+    int *ptr = (int *)malloc(sizeof(int));
+    if (ptr != NULL) {
+        *ptr = value;
+    }
+    return ptr;
+}
+
+// 基本操作、遍历中删除（向后移位时不遗漏也不重复）
+static int testBasic(void) {
+    HashMapRobin *hashMap = newHashMapRobin(8, freeIntPtr);
+    if (hashMap == NULL) {
+        printf("创建哈希表失败\n");
+        return 1;
+    }
+
+    // 插入足够多的键以触发多次扩容，包含负数键
+    printf("添加键值对到哈希表...\n");
+    for (int i = -500; i < 1500; i++) {
+        robinPut(hashMap, i, createIntPtr(i * 10));
+    }
+    printf("键值对数量: %zu, 槽位数量: %zu\n", robinSize(hashMap), robinCapacity(hashMap));
+
+    for (int i = -500; i < 1500; i++) {
+        int *value = (int *)robinGet(hashMap, i);
+        if (value == NULL || *value != i * 10) {
+            printf("查找键 %d 失败\n", i);
+            delHashMapRobin(hashMap);
+            return 1;
+        }
+    }
+    printf("查找键 %d: %s\n", 2000, robinGet(hashMap, 2000) ? "找到" : "未找到");
+
+    // 删除所有偶数键，其余键经过向后移位后仍然可以找到
+    for (int i = -500; i < 1500; i += 2) {
+        robinRemoveItem(hashMap, i);
+    }
+    for (int i = -499; i < 1500; i += 2) {
+        if (robinGet(hashMap, i) == NULL || robinGet(hashMap, i - 1) != NULL) {
+            printf("删除后查找键 %d 错误\n", i);
+            delHashMapRobin(hashMap);
+            return 1;
+        }
+    }
+    printf("删除偶数键后数量: %zu\n", robinSize(hashMap));
+
+    // 遍历并在遍历中删除小于0的键，每个键恰好访问一次
+    size_t visited = 0;
+    long long keySum = 0;
+    HashMapRobinIterator iterator = robinInitIterator(hashMap);
+    while (robinHasNext(&iterator)) {
+        int key = robinGetKey(&iterator);
+        int *value = (int *)robinGetValue(&iterator);
+        if (key % 2 == 0 || *value != key * 10) {
+            printf("迭代结果错误: 键 %d\n", key);
+            delHashMapRobin(hashMap);
+            return 1;
+        }
+        visited++;
+        keySum += key;
+        if (key < 0) {
+            robinRemoveCurrent(&iterator);
+        } else {
+            robinNext(&iterator);
+        }
+    }
+    // 奇数键 -499 ~ 1499 之和
+    bool ok = visited == 1000 && keySum == 500000 && robinSize(hashMap) == 750;
+    printf("迭代访问 %zu 个元素, 删除负数键后数量: %zu\n", visited, robinSize(hashMap));
+
+    delHashMapRobin(hashMap);
+    return ok ? 0 : 1;
+}
+
+// 0.9 负载下的探测距离，以及大量删除插入之后不会积累墓碑
+static int testHighLoad(void) {
+    static int value = 1;
+    HashMapRobin *hashMap = newHashMapRobin(LOAD_TEST_SLOTS, NULL);
+    if (hashMap == NULL) {
+        return 1;
+    }
+    int n = LOAD_TEST_SLOTS / 10 * 9;
+    for (int i = 0; i < n; i++) {
+        robinPut(hashMap, i * 7919, &value);
+    }
+    double average;
+    size_t max;
+    robinProbeStats(hashMap, &average, &max);
+    printf("负载 %.3f: 平均探测距离 %.2f, 最大探测距离 %zu, 槽位数量 %zu\n",
+           (double)robinSize(hashMap) / (double)robinCapacity(hashMap), average, max, robinCapacity(hashMap));
+    bool ok = robinCapacity(hashMap) == LOAD_TEST_SLOTS && average < 6.0;
+
+    // 反复删除和插入不同的键，探测距离保持不变量
+    for (int round = 0; round < 4; round++) {
+        for (int i = 0; i < n; i += 2) {
+            robinRemoveItem(hashMap, i * 7919 + round);
+            robinPut(hashMap, i * 7919 + round + 1, &value);
+        }
+    }
+    double churned;
+    robinProbeStats(hashMap, &churned, &max);
+    printf("删除插入 4 轮后: 平均探测距离 %.2f, 最大探测距离 %zu, 数量 %zu\n", churned, max, robinSize(hashMap));
+    ok = ok && robinSize(hashMap) == (size_t)n && churned < 6.0;
+
+    delHashMapRobin(hashMap);
+    return ok ? 0 : 1;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    int failed = testBasic() || testHighLoad();
+    printf("%s\n", failed ? "测试失败" : "测试通过");
+
+    // 内存检测报告
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return failed;
+}
@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include "hash_set.h"
+#include "utility.h"
+
+// 按迭代统计集合中键的数量与键之和
+static bool summarize(HashSet *set, size_t *count, long long *keySum) {
+    *count = 0;
+    *keySum = 0;
+    for (HashSetIterator it = setInitIterator(set); setHasNext(&it); setNext(&it)) {
+        (*count)++;
+        *keySum += setGetKey(&it);
+    }
+    return *count == setSize(set);
+}
+
+// 添加、查找、删除与遍历中删除
+static bool testBasic(void) {
+    printf("\n=== 测试1: 基本操作 ===\n");
+    HashSet *set = newHashSet(8);
+    if (set == NULL) {
+        return false;
+    }
+
+    bool ok = true;
+    for (int key = -1000; key < 3000 && ok; key++) {
+        ok = setInsert(set, key);
+    }
+    ok = ok && !setInsert(set, 42) && setSize(set) == 4000;
+    printf("添加 4000 个键: 数量 %zu, 槽位数量 %zu, 重复添加%s\n",
+           setSize(set), setCapacity(set), setInsert(set, 42) ? "成功（错误）" : "被忽略");
+
+    for (int key = -1000; key < 3000; key += 2) {
+        ok = ok && setErase(set, key);
+    }
+    ok = ok && !setErase(set, -1000) && setSize(set) == 2000;
+    for (int key = -1000; key < 3000 && ok; key++) {
+        ok = setContains(set, key) == (key % 2 != 0);
+    }
+    printf("删除偶数键后数量: %zu, 查找结果%s\n", setSize(set), ok ? "正确" : "错误");
+
+    // 遍历中删除负数键
+    size_t visited = 0;
+    HashSetIterator it = setInitIterator(set);
+    while (setHasNext(&it)) {
+        visited++;
+        if (setGetKey(&it) < 0) {
+            setRemoveCurrent(&it);
+        } else {
+            setNext(&it);
+        }
+    }
+    size_t count;
+    long long keySum;
+    ok = ok && visited == 2000 && summarize(set, &count, &keySum) && count == 1500 && keySum == 2250000;
+    printf("遍历访问 %zu 个键, 删除负数键后数量: %zu, 键之和: %lld\n", visited, count, keySum);
+
+    delHashSet(set);
+    return ok;
+}
+
+static HashSet *rangeSet(int begin, int end, int step) {
+    HashSet *set = newHashSet(16);
+    for (int key = begin; set != NULL && key < end; key += step) {
+        setInsert(set, key);
+    }
+    return set;
+}
+
+// 并集、交集与差集
+static bool testSetAlgebra(void) {
+    printf("\n=== 测试2: 并集、交集与差集 ===\n");
+    HashSet *evens = rangeSet(0, 20000, 2);     // 0, 2, ..., 19998
+    HashSet *threes = rangeSet(0, 20000, 3);    // 0, 3, ..., 19998
+    HashSet *result = newHashSet(16);
+    if (evens == NULL || threes == NULL || result == NULL) {
+        delHashSet(evens);
+        delHashSet(threes);
+        delHashSet(result);
+        return false;
+    }
+
+    // |A ∪ B| = |A| + |B| - |A ∩ B| = 10000 + 6667 - 3334
+    bool ok = setUnion(result, evens) && setUnion(result, threes) && setUnion(result, result);
+    ok = ok && setSize(result) == 13333;
+    for (int key = 0; key < 20000 && ok; key++) {
+        ok = setContains(result, key) == (key % 2 == 0 || key % 3 == 0);
+    }
+    printf("并集数量: %zu (期望 13333)\n", setSize(result));
+
+    setIntersect(result, evens);
+    setIntersect(result, threes);
+    size_t count;
+    long long keySum;
+    ok = ok && summarize(result, &count, &keySum) && count == 3334;
+    for (int key = 0; key < 20000 && ok; key++) {
+        ok = setContains(result, key) == (key % 6 == 0);
+    }
+    printf("交集数量: %zu (期望 3334)\n", setSize(result));
+
+    // 两个方向的差集分别走遍历 set 与遍历 other 两条路径
+    setDifference(evens, result);
+    setDifference(result, threes);
+    ok = ok && setSize(evens) == 10000 - 3334 && setSize(result) == 0;
+    for (int key = 0; key < 20000 && ok; key++) {
+        ok = setContains(evens, key) == (key % 2 == 0 && key % 3 != 0);
+    }
+    setDifference(threes, threes);
+    ok = ok && setSize(threes) == 0 && !setContains(threes, 3) && setInsert(threes, 3);
+    printf("差集数量: %zu (期望 6666), 自身差集后数量: %zu\n", setSize(evens), setSize(threes) - 1);
+
+    delHashSet(evens);
+    delHashSet(threes);
+    delHashSet(result);
+    return ok;
+}
+
+// 大量删除插入后墓碑被回收，容量不会无限增长
+static bool testChurn(void) {
+    printf("\n=== 测试3: 反复删除插入 ===\n");
+    HashSet *set = newHashSet(1024);
+    if (set == NULL) {
+        return false;
+    }
+    for (int key = 0; key < 800; key++) {
+        setInsert(set, key);
+    }
+    for (int key = 800; key < 200000; key++) {
+        setErase(set, key - 800);
+        setInsert(set, key);
+    }
+    bool ok = setSize(set) == 800 && setCapacity(set) <= 2048 &&
+              setContains(set, 199999) && !setContains(set, 199199);
+    printf("数量: %zu, 槽位数量: %zu\n", setSize(set), setCapacity(set));
+    delHashSet(set);
+    return ok;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    bool ok = testBasic();
+    ok = testSetAlgebra() && ok;
+    ok = testChurn() && ok;
+    printf("\n%s\n", ok ? "所有测试通过" : "测试失败");
+
+    // 报告内存使用情况
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,95 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "hash_map_sharded.h"
+#include "utility.h"
+
+#define TEST_THREADS 8
+#define TEST_KEYS 8000
+
+static int values[TEST_KEYS];  // 值直接指向静态数组，不需要释放
+
+typedef struct {
+    HashMapSharded *hashMap;
+    int id;       // 线程编号
+    int errors;   // 读到错误值的次数
+} Worker;
+
+// 每个线程负责 key % TEST_THREADS == id 的键：删除其中的奇数键，并反复读取其他线程的键
+static void *runWorker(void *arg) {
+    Worker *worker = (Worker *)arg;
+    for (int round = 0; round < 4; round++) {
+        for (int key = worker->id; key < TEST_KEYS; key += TEST_THREADS) {
+            if (key % 2 == 1) {
+                shardedRemoveItem(worker->hashMap, key);
+            } else {
+                shardedPut(worker->hashMap, key, &values[key]);
+            }
+        }
+        for (int key = 0; key < TEST_KEYS; key += 2) {
+            int *value = (int *)shardedGet(worker->hashMap, key);
+            if (value == NULL || *value != key) {
+                worker->errors++;
+            }
+        }
+    }
+    return NULL;
+}
+
+// 遍历回调：统计键值对数量并检查值
+static void countPair(int key, void *val, void *ctx) {
+    size_t *count = (size_t *)ctx;
+    if (val == &values[key]) {
+        (*count)++;
+    }
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    HashMapChainingConfig config = defaultHashMapConfig(64, NULL);
+    HashMapSharded *hashMap = newHashMapSharded(16, &config);
+    if (hashMap == NULL) {
+        printf("创建哈希表失败\n");
+        return 1;
+    }
+
+    // 单线程预先插入所有键，分片在插入过程中各自扩容
+    for (int key = 0; key < TEST_KEYS; key++) {
+        values[key] = key;
+        shardedPut(hashMap, key, &values[key]);
+    }
+    printf("分片数量: %zu, 键值对数量: %zu\n", shardedShardCount(hashMap), shardedSize(hashMap));
+
+    // 多个线程同时读写
+    pthread_t tids[TEST_THREADS];
+    Worker workers[TEST_THREADS];
+    for (int i = 0; i < TEST_THREADS; i++) {
+        workers[i].hashMap = hashMap;
+        workers[i].id = i;
+        workers[i].errors = 0;
+        pthread_create(&tids[i], NULL, runWorker, &workers[i]);
+    }
+    int errors = 0;
+    for (int i = 0; i < TEST_THREADS; i++) {
+        pthread_join(tids[i], NULL);
+        errors += workers[i].errors;
+    }
+
+    size_t count = 0;
+    shardedForEach(hashMap, countPair, &count);
+    printf("并发读写后键值对数量: %zu, 遍历数量: %zu, 错误读取: %d\n", shardedSize(hashMap), count, errors);
+    if (errors != 0 || shardedSize(hashMap) != TEST_KEYS / 2 || count != TEST_KEYS / 2) {
+        printf("分片哈希表结果错误\n");
+        delHashMapSharded(hashMap);
+        return 1;
+    }
+
+    delHashMapSharded(hashMap);
+
+    // 报告内存使用情况
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return 0;
+}
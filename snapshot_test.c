@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "hash_table_snapshot.h"
+#include "utility.h"
+
+#define TEST_KEYS 50000
+#define SNAPSHOT_PATH "snapshot_test.bin"
+
+// 释放整数指针的回调函数
+void freeIntPtr(void *ptr) {
+    free(ptr);
+}
+
+// 创建整数指针
+int *createIntPtr(int value) {
+    int *ptr = (int *)malloc(sizeof(int));
+    if (ptr != NULL) {
+        *ptr = value;
+    }
+    return ptr;
+}
+
+// 整数值的序列化函数：值本身就是字节
+static const void *serializeInt(const void *val, size_t *length, void *ctx) {
+    (void)ctx;
+    *length = sizeof(int);
+    return val;
+}
+
+// 整数值的反序列化函数
+static void *deserializeInt(const void *bytes, size_t length, void *ctx) {
+    (void)ctx;
+    if (length != sizeof(int)) {
+        return NULL;
+    }
+    int value;
+    memcpy(&value, bytes, sizeof(int));
+    return createIntPtr(value);
+}
+
+// 读取快照中的整数值：值按 HASH_SNAPSHOT_VALUE_ALIGN 对齐，可以直接解引用，未对齐时返回 -1
+static int readInt(const void *bytes) {
+    if ((uintptr_t)bytes % HASH_SNAPSHOT_VALUE_ALIGN != 0) {
+        return -1;
+    }
+    return *(const int *)bytes;
+}
+
+// 保存到文件
+static bool saveTo(HashMapChaining *hashMap, const char *path) {
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = hashMapSave(hashMap, fd, serializeInt, NULL);
+    close(fd);
+    return ok;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    HashMapChaining *hashMap = newHashMapChaining(16, freeIntPtr);
+    if (hashMap == NULL) {
+        printf("创建哈希表失败\n");
+        return 1;
+    }
+    for (int i = 0; i < TEST_KEYS; i++) {
+        put(hashMap, i * 3 - TEST_KEYS, createIntPtr(i));
+    }
+    bool ok = saveTo(hashMap, SNAPSHOT_PATH);
+    printf("保存 %zu 个键值对: %s\n", size(hashMap), ok ? "成功" : "失败");
+    delHashMapChaining(hashMap);
+
+    // 反序列化加载：值归新哈希表所有
+    HashMapChaining *loaded = hashMapLoad(SNAPSHOT_PATH, deserializeInt, NULL, freeIntPtr);
+    size_t errors = 0;
+    for (int i = 0; loaded != NULL && i < TEST_KEYS; i++) {
+        int *value = (int *)get(loaded, i * 3 - TEST_KEYS);
+        errors += value == NULL || *value != i;
+        errors += get(loaded, i * 3 - TEST_KEYS + 1) != NULL;
+    }
+    printf("反序列化加载: %zu 个键值对, 错误 %zu 个\n", size(loaded), errors);
+    ok = ok && loaded != NULL && size(loaded) == TEST_KEYS && errors == 0;
+
+    // 加载后的哈希表可以继续修改
+    removeItem(loaded, -TEST_KEYS);
+    put(loaded, 2, createIntPtr(-1));
+    ok = ok && size(loaded) == TEST_KEYS && get(loaded, -TEST_KEYS) == NULL;
+    delHashMapChaining(loaded);
+
+    // 零拷贝加载：值直接指向哈希表持有的映像
+    loaded = hashMapLoad(SNAPSHOT_PATH, NULL, NULL, NULL);
+    errors = 0;
+    for (int i = 0; loaded != NULL && i < TEST_KEYS; i++) {
+        const void *bytes = get(loaded, i * 3 - TEST_KEYS);
+        errors += bytes == NULL || readInt(bytes) != i;
+    }
+    printf("零拷贝加载: %zu 个键值对, 错误 %zu 个\n", size(loaded), errors);
+    ok = ok && loaded != NULL && errors == 0;
+    // 零拷贝加载的值可以删除和覆盖，哈希表不会释放指向映像内部的指针
+    removeItem(loaded, -TEST_KEYS);
+    put(loaded, 3 - TEST_KEYS, &errors);
+    ok = ok && loaded != NULL && size(loaded) == TEST_KEYS - 1;
+    delHashMapChaining(loaded);
+
+    // 零拷贝加载时指定 freeVal 会释放映像内部的指针，被拒绝
+    loaded = hashMapLoad(SNAPSHOT_PATH, NULL, NULL, freeIntPtr);
+    printf("零拷贝加载并指定 freeVal: %s\n", loaded == NULL ? "被拒绝" : "成功");
+    ok = ok && loaded == NULL;
+    delHashMapChaining(loaded);
+
+    // 只读映射：不加载直接查询
+    HashSnapshot *snapshot = hashSnapshotOpen(SNAPSHOT_PATH, true);
+    errors = 0;
+    for (int i = 0; snapshot != NULL && i < TEST_KEYS; i++) {
+        size_t length = 0;
+        const void *bytes = hashSnapshotGet(snapshot, i * 3 - TEST_KEYS, &length);
+        errors += bytes == NULL || length != sizeof(int) || readInt(bytes) != i;
+        errors += hashSnapshotGet(snapshot, i * 3 - TEST_KEYS + 2, NULL) != NULL;
+    }
+    printf("只读映射: %zu 个键值对, 错误 %zu 个\n", hashSnapshotSize(snapshot), errors);
+    ok = ok && snapshot != NULL && errors == 0;
+    hashSnapshotClose(snapshot);
+
+    // 改动一个字节后校验失败
+    int fd = open(SNAPSHOT_PATH, O_RDWR);
+    unsigned char byte = 0;
+    bool corrupted = fd >= 0 && pread(fd, &byte, 1, (off_t)sizeof(HashSnapshotHeader) + 5) == 1;
+    byte ^= 0x40;
+    corrupted = corrupted && pwrite(fd, &byte, 1, (off_t)sizeof(HashSnapshotHeader) + 5) == 1;
+    if (fd >= 0) {
+        close(fd);
+    }
+    loaded = hashMapLoad(SNAPSHOT_PATH, deserializeInt, NULL, freeIntPtr);
+    snapshot = hashSnapshotOpen(SNAPSHOT_PATH, true);
+    printf("损坏的快照: 加载%s, 映射%s\n", loaded == NULL ? "被拒绝" : "成功", snapshot == NULL ? "被拒绝" : "成功");
+    ok = ok && corrupted && loaded == NULL && snapshot == NULL;
+    delHashMapChaining(loaded);
+    hashSnapshotClose(snapshot);
+
+    // 空哈希表也可以保存和加载
+    hashMap = newHashMapChaining(8, NULL);
+    ok = ok && saveTo(hashMap, SNAPSHOT_PATH);
+    delHashMapChaining(hashMap);
+    loaded = hashMapLoad(SNAPSHOT_PATH, NULL, NULL, NULL);
+    ok = ok && loaded != NULL && isEmpty(loaded);
+    delHashMapChaining(loaded);
+    remove(SNAPSHOT_PATH);
+
+    printf("%s\n", ok ? "所有测试通过" : "测试失败");
+
+    // 内存检测报告
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include "hash_table.h"
+#include "utility.h"
+
+#define TEST_KEYS 20000
+
+static int testValue = 1;  // 所有键共用的非NULL值
+
+/*
+ * 按指定参数插入键 0, stride, 2*stride, ...，查找全部键和同样数量的不存在的键，
+ * 删除一半键，打印统计信息并校验计数，成功时返回true
+ */
+static bool runCase(const char *title, HashMapChainingConfig *config, int stride) {
+    printf("\n=== %s ===\n", title);
+    HashMapChaining *hashMap = newHashMapChainingWithConfig(config);
+    if (hashMap == NULL) {
+        printf("创建哈希表失败\n");
+        return false;
+    }
+
+    for (int i = 0; i < TEST_KEYS; i++) {
+        put(hashMap, i * stride, &testValue);
+    }
+    for (int i = 0; i < TEST_KEYS; i++) {
+        get(hashMap, i * stride);
+        get(hashMap, -1 - i);
+    }
+    for (int i = 0; i < TEST_KEYS; i += 2) {
+        removeItem(hashMap, i * stride);
+    }
+    hashMapStatsPrint(hashMap);
+
+    HashMapStats stats;
+    hashMapStats(hashMap, &stats);
+    size_t buckets = 0, entries = 0;
+    for (size_t i = 0; i < HASH_TABLE_STATS_BINS; i++) {
+        buckets += stats.chainHistogram[i];
+        entries += i * stats.chainHistogram[i];
+    }
+    bool ok = stats.enabled && stats.get.hits == TEST_KEYS && stats.get.misses == TEST_KEYS &&
+              stats.put.misses == TEST_KEYS && stats.put.hits == 0 &&
+              stats.remove.hits == TEST_KEYS / 2 && stats.extendCount > 0 &&
+              stats.get.maxHitProbe >= 1 && buckets >= stats.capacity &&
+              (stats.maxChain + 1 < HASH_TABLE_STATS_BINS ? entries == stats.size : entries <= stats.size);
+
+    // 清零后计数重新开始，链长分布不受影响
+    hashMapStatsReset(hashMap);
+    get(hashMap, 0);
+    hashMapStats(hashMap, &stats);
+    ok = ok && stats.get.hits + stats.get.misses == 1 && stats.extendCount == 0;
+
+    delHashMapChaining(hashMap);
+    if (!ok) {
+        printf("统计结果错误\n");
+    }
+    return ok;
+}
+
+// 按迭代顺序比较两个哈希表的桶布局
+static bool sameOrder(HashMapChaining *a, HashMapChaining *b) {
+    HashMapIterator ia = initIterator(a);
+    HashMapIterator ib = initIterator(b);
+    for (; hasNext(&ia) && hasNext(&ib); next(&ia), next(&ib)) {
+        if (getKey(&ia) != getKey(&ib)) {
+            return false;
+        }
+    }
+    return !hasNext(&ia) && !hasNext(&ib);
+}
+
+// murmur 策略使用种子：种子相同时桶布局相同，种子不同时布局不同
+static bool testMurmurSeed(void) {
+    printf("\n=== Murmur 哈希的种子 ===\n");
+    HashMapChaining *maps[3];
+    const uint64_t seeds[3] = {1, 1, 2};
+    for (int i = 0; i < 3; i++) {
+        HashMapChainingConfig config = defaultHashMapConfig(1024, NULL);
+        config.pow2Capacity = true;
+        config.hashKind = HASH_KIND_MURMUR;
+        config.hashSeed = seeds[i];
+        maps[i] = newHashMapChainingWithConfig(&config);
+        for (int key = 0; maps[i] != NULL && key < 500; key++) {
+            put(maps[i], key, &testValue);
+        }
+    }
+    bool ok = maps[0] != NULL && maps[1] != NULL && maps[2] != NULL;
+    if (ok) {
+        bool same = sameOrder(maps[0], maps[1]);
+        bool differ = !sameOrder(maps[0], maps[2]);
+        printf("种子相同时布局%s，种子不同时布局%s\n", same ? "相同" : "不同", differ ? "不同" : "相同");
+        ok = same && differ;
+    }
+    for (int i = 0; i < 3; i++) {
+        delHashMapChaining(maps[i]);
+    }
+    return ok;
+}
+
+int main(void) {
+    // 初始化内存检测
+    MEM_INIT();
+
+    // 步长为 64 的键在恒等哈希下集中到少数桶，统计中可以直接看到链长和探测长度的差别
+    HashMapChainingConfig config = defaultHashMapConfig(16, NULL);
+    config.pow2Capacity = true;
+    config.hashKind = HASH_KIND_IDENTITY;
+    bool ok = runCase("恒等哈希，键的步长为 64", &config, 64);
+
+    config.hashKind = HASH_KIND_MURMUR;
+    ok = runCase("Murmur 哈希，键的步长为 64", &config, 64) && ok;
+
+    config.incrementalRehash = true;
+    ok = runCase("Murmur 哈希，渐进式扩容", &config, 64) && ok;
+    ok = testMurmurSeed() && ok;
+
+    // 报告内存使用情况
+    MEM_REPORT();
+    MEM_CLEANUP();
+    return ok ? 0 : 1;
+}
@@ -33,7 +33,7 @@ int main(void) {
     // printf("\n删除key1后:\n");
     // printf("查找key1: %s\n", (char *)get(hashMap, 1) ? (char *)get(hashMap, 1) : "未找到");
     
-    // // 释放哈希表
-    // delHashMapChaining(hashMap);
+    // 释放哈希表
+    delHashMapChaining(hashMap);
     return 0;
 }
@@ -0,0 +1,207 @@
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "thread_pool.h"
+#include "utility.h"
+
+/* 工作线程的任务区间，独占缓存行，领取和窃取都通过原子加法推进 next */
+typedef struct {
+    _Alignas(THREAD_POOL_CACHE_LINE) atomic_size_t next; // 下一个待领取的下标
+    size_t end;                                          // 区间终点（不含）
+} WorkRange;
+
+/* 辅助线程的启动参数 */
+typedef struct {
+    ThreadPool *pool;
+    size_t worker;
+} WorkerArg;
+
+/* 线程池 */
+struct ThreadPool {
+    size_t threadCount;     // 工作线程数量，含调用线程
+    pthread_t *threads;     // threadCount - 1 个辅助线程
+    WorkerArg *args;        // 辅助线程的启动参数
+    WorkRange *ranges;      // 每个工作线程的任务区间，按缓存行对齐
+    void *rawRanges;        // 任务区间数组的原始分配地址
+
+    pthread_mutex_t lock;
+    pthread_cond_t wake;    // 发布新任务或要求退出
+    pthread_cond_t idle;    // 辅助线程全部完成当前任务
+    uint64_t generation;    // 任务编号，每发布一个任务加一
+    size_t pending;         // 尚未完成当前任务的辅助线程数量
+    bool stop;              // 要求辅助线程退出
+
+    ThreadPoolTask task;    // 当前任务
+    void *ctx;
+    size_t grain;
+};
+
+/* 从区间中领取最多 grain 个下标，区间已耗尽时返回false */
+static bool claim(WorkRange *range, size_t grain, size_t *begin, size_t *end) {
+    size_t b = atomic_fetch_add_explicit(&range->next, grain, memory_order_relaxed);
+    if (b >= range->end) {
+        return false;
+    }
+    *begin = b;
+    *end = range->end - b < grain ? range->end : b + grain;
+    return true;
+}
+
+/* 先处理自己的区间，再依次窃取其它线程区间中剩余的块 */
+static void runWorker(ThreadPool *pool, size_t worker) {
+    size_t begin, end;
+    for (size_t v = 0; v < pool->threadCount; v++) {
+        WorkRange *range = &pool->ranges[(worker + v) % pool->threadCount];
+        while (claim(range, pool->grain, &begin, &end)) {
+            pool->task(begin, end, worker, pool->ctx);
+        }
+    }
+}
+
+/* 辅助线程主循环：等待新任务，完成后通知调用线程 */
+static void *workerMain(void *arg) {
+    WorkerArg *workerArg = (WorkerArg *)arg;
+    ThreadPool *pool = workerArg->pool;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (!pool->stop && pool->generation == seen) {
+            pthread_cond_wait(&pool->wake, &pool->lock);
+        }
+        if (pool->stop) {
+            break;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        runWorker(pool, workerArg->worker);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->idle);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/* 通知前 started 个辅助线程退出并等待它们结束 */
+static void stopWorkers(ThreadPool *pool, size_t started) {
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+}
+
+static void freePool(ThreadPool *pool) {
+    pthread_cond_destroy(&pool->idle);
+    pthread_cond_destroy(&pool->wake);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->rawRanges);
+    free(pool->args);
+    free(pool->threads);
+    free(pool);
+}
+
+/* 创建线程池 */
+ThreadPool *newThreadPool(size_t threads) {
+    if (threads == 0 || threads > THREAD_POOL_MAX_THREADS) {
+        return NULL;
+    }
+    ThreadPool *pool = (ThreadPool *)malloc(sizeof(ThreadPool));
+    if (pool == NULL) {
+        return NULL;
+    }
+    pool->threadCount = threads;
+    pool->generation = 0;
+    pool->pending = 0;
+    pool->stop = false;
+    pool->task = NULL;
+    pool->ctx = NULL;
+    pool->grain = 1;
+    pool->threads = (pthread_t *)malloc(threads * sizeof(pthread_t));
+    pool->args = (WorkerArg *)malloc(threads * sizeof(WorkerArg));
+    char *raw = (char *)malloc(threads * sizeof(WorkRange) + THREAD_POOL_CACHE_LINE - 1);
+    pool->rawRanges = raw;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->idle, NULL);
+    if (pool->threads == NULL || pool->args == NULL || raw == NULL) {
+        freePool(pool);
+        return NULL;
+    }
+    uintptr_t aligned = ((uintptr_t)raw + THREAD_POOL_CACHE_LINE - 1) & ~(uintptr_t)(THREAD_POOL_CACHE_LINE - 1);
+    pool->ranges = (WorkRange *)(void *)(raw + (aligned - (uintptr_t)raw));
+    for (size_t i = 0; i < threads; i++) {
+        atomic_init(&pool->ranges[i].next, 0);
+        pool->ranges[i].end = 0;
+    }
+
+    // 0 号工作线程是调用线程，只创建辅助线程
+    for (size_t i = 1; i < threads; i++) {
+        pool->args[i - 1].pool = pool;
+        pool->args[i - 1].worker = i;
+        if (pthread_create(&pool->threads[i - 1], NULL, workerMain, &pool->args[i - 1]) != 0) {
+            stopWorkers(pool, i - 1);
+            freePool(pool);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+/* 删除线程池 */
+void delThreadPool(ThreadPool *pool) {
+    if (pool == NULL) {
+        return;
+    }
+    stopWorkers(pool, pool->threadCount - 1);
+    freePool(pool);
+}
+
+/* 获取工作线程数量 */
+size_t threadPoolSize(ThreadPool *pool) {
+    return pool == NULL ? 1 : pool->threadCount;
+}
+
+/* 并行处理 [0, count) */
+void threadPoolParallelFor(ThreadPool *pool, size_t count, size_t grain, ThreadPoolTask task, void *ctx) {
+    if (task == NULL || count == 0) {
+        return;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+    if (pool == NULL || pool->threadCount == 1 || count <= grain) {
+        task(0, count, 0, ctx);
+        return;
+    }
+
+    // 平均划分区间，互斥锁保证辅助线程被唤醒后看到完整的任务
+    size_t n = pool->threadCount;
+    for (size_t i = 0; i < n; i++) {
+        atomic_store_explicit(&pool->ranges[i].next, count / n * i + (i < count % n ? i : count % n),
+                              memory_order_relaxed);
+        pool->ranges[i].end = count / n * (i + 1) + (i + 1 < count % n ? i + 1 : count % n);
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->task = task;
+    pool->ctx = ctx;
+    pool->grain = grain;
+    pool->pending = n - 1;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    runWorker(pool, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) {
+        pthread_cond_wait(&pool->idle, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
@@ -0,0 +1,71 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define THREAD_POOL_CACHE_LINE 64     // 每个工作线程的任务区间独占的缓存行大小
+#define THREAD_POOL_MAX_THREADS 256   // 工作线程数量上限
+
+/*
+ * 固定大小的线程池
+ *
+ * 只提供一种并行原语：threadPoolParallelFor 把 [0, count) 平均分成与工作线程数相同的连续区间，
+ * 每个线程按 grain 大小的块依次领取自己区间内的下标；自己的区间做完后从其它线程区间的当前位置
+ * 窃取剩余的块，负载不均时（例如链长差异很大）也能同时完成。
+ * 调用线程作为 0 号工作线程参与计算，因此 threads 个工作线程只需要 threads - 1 个辅助线程。
+ * 同一线程池同一时间只能执行一个任务。
+ */
+typedef struct ThreadPool ThreadPool;
+
+/**
+ * @brief 任务函数
+ *
+ * 处理下标区间 [begin, end)，同一工作线程可能被多次调用。
+ *
+ * @param begin 区间起点
+ * @param end 区间终点（不含）
+ * @param worker 工作线程编号，范围为 [0, threadPoolSize)，可用于访问线程私有的累加器
+ * @param ctx 调用者传入的参数
+ */
+typedef void (*ThreadPoolTask)(size_t begin, size_t end, size_t worker, void *ctx);
+
+/**
+ * @brief 创建线程池
+ *
+ * @param threads 工作线程数量（含调用线程），为0或超过 THREAD_POOL_MAX_THREADS 时失败
+ * @return 成功时返回线程池，线程创建失败或内存不足时返回NULL
+ */
+ThreadPool *newThreadPool(size_t threads);
+
+/**
+ * @brief 删除线程池
+ *
+ * 等待辅助线程退出并释放内存，不能在任务执行过程中调用。
+ *
+ * @param pool 线程池的指针
+ */
+void delThreadPool(ThreadPool *pool);
+
+/**
+ * @brief 获取工作线程数量（含调用线程）
+ *
+ * @param pool 线程池的指针
+ * @return 返回工作线程数量
+ */
+size_t threadPoolSize(ThreadPool *pool);
+
+/**
+ * @brief 并行处理 [0, count) 中的全部下标
+ *
+ * 所有下标处理完后返回。
+ *
+ * @param pool 线程池的指针，为NULL时在调用线程中顺序执行
+ * @param count 下标数量
+ * @param grain 每次领取的下标数量，为0时取1
+ * @param task 任务函数
+ * @param ctx 传给任务函数的参数
+ */
+void threadPoolParallelFor(ThreadPool *pool, size_t count, size_t grain, ThreadPoolTask task, void *ctx);
+
+#endif // THREAD_POOL_H
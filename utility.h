@@ -6,7 +6,9 @@
 #include <math.h>
 
 // 内存检测相关宏定义
+#ifndef MEMCHECK_ENABLE
 #define MEMCHECK_ENABLE 1  // 设置为0可禁用内存检测
+#endif
 
 #if MEMCHECK_ENABLE
 #include "memcheck.h"